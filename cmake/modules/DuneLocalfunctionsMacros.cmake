@@ -0,0 +1,53 @@
+# SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#[=======================================================================[.rst:
+DuneLocalfunctionsMacros
+------------------------
+
+.. cmake:command:: dune_localfunctions_generate_basis
+
+  Generate a header with specialized code for polynomial bases at build time.
+
+  .. code-block:: cmake
+
+    dune_localfunctions_generate_basis(
+      TARGET <target>
+      GENERATOR <source>
+      OUTPUT <header>
+    )
+
+  ``GENERATOR`` is the source of a program that writes the header given as
+  its only argument, usually by calling ``Dune::generateBasisCode()`` from
+  ``dune/localfunctions/utility/basiscodegenerator.hh`` for the bases it
+  needs. The program is built and run whenever it changes and the header is
+  written to ``OUTPUT``, relative to the current binary directory. Targets
+  including the header have to depend on the custom target ``TARGET``, e.g.
+
+  .. code-block:: cmake
+
+    dune_localfunctions_generate_basis(TARGET mybases GENERATOR generatemybases.cc OUTPUT mybases.hh)
+    add_dependencies(mytarget mybases)
+    target_include_directories(mytarget PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+
+#]=======================================================================]
+include_guard(GLOBAL)
+
+function(dune_localfunctions_generate_basis)
+  cmake_parse_arguments(ARG "" "TARGET;GENERATOR;OUTPUT" "" ${ARGN})
+  if(NOT ARG_TARGET OR NOT ARG_GENERATOR OR NOT ARG_OUTPUT)
+    message(FATAL_ERROR "dune_localfunctions_generate_basis requires the arguments TARGET, GENERATOR and OUTPUT")
+  endif()
+  if(NOT IS_ABSOLUTE "${ARG_OUTPUT}")
+    set(ARG_OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/${ARG_OUTPUT}")
+  endif()
+
+  add_executable(${ARG_TARGET}-generator EXCLUDE_FROM_ALL ${ARG_GENERATOR})
+  target_link_libraries(${ARG_TARGET}-generator PRIVATE Dune::LocalFunctions)
+  add_custom_command(OUTPUT ${ARG_OUTPUT}
+    COMMAND ${ARG_TARGET}-generator ${ARG_OUTPUT}
+    DEPENDS ${ARG_TARGET}-generator
+    COMMENT "Generating basis code ${ARG_OUTPUT}"
+    VERBATIM)
+  add_custom_target(${ARG_TARGET} DEPENDS ${ARG_OUTPUT})
+endfunction()
@@ -0,0 +1,16 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_BERNSTEIN_HH
+#define DUNE_LOCALFUNCTIONS_BERNSTEIN_HH
+
+/** \file
+    \brief Convenience header that includes all available Bernstein-Bezier LocalFiniteElements
+ */
+
+#include <dune/localfunctions/bernstein/bernsteinalgorithms.hh>
+#include <dune/localfunctions/bernstein/bernsteinlfecache.hh>
+#include <dune/localfunctions/bernstein/bernsteinsimplex.hh>
+
+#endif // DUNE_LOCALFUNCTIONS_BERNSTEIN_HH
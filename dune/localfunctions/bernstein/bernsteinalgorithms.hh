@@ -0,0 +1,578 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINALGORITHMS_HH
+#define DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINALGORITHMS_HH
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+namespace Dune
+{
+
+  /** \brief Fast algorithms for polynomials in Bernstein-Bezier form on the reference simplex
+   *
+   * This class implements the sum-factorized algorithms for Bernstein polynomials
+   * on simplices described by Ainsworth, Andriamaro and Davydov. Polynomials of
+   * order \f$n\f$ are represented by their Bernstein coefficients, enumerated in the
+   * same order as the shape functions of BernsteinSimplexLocalFiniteElement.
+   *
+   * The algorithms rely on the collapsed coordinates
+   * \f$\xi\in[0,1]^d\f$ given by
+   * \f[
+   *   x_{d-1} = \xi_1,\quad x_{d-s} = \xi_s\prod_{j<s}(1-\xi_j),\quad
+   *   \lambda_d = \prod_{j=1}^{d}(1-\xi_j),
+   * \f]
+   * in which the Bernstein polynomials factorize into
+   * \f$B^n_\alpha(x) = B^{n}_{\alpha_{d-1}}(\xi_1) B^{n-\alpha_{d-1}}_{\alpha_{d-2}}(\xi_2)\cdots
+   * B^{n-\alpha_{d-1}-\dots-\alpha_1}_{\alpha_0}(\xi_d)\f$. Using a tensor product
+   * quadrature in collapsed coordinates with \f$q\f$ points per direction, evaluation
+   * at all quadrature points and computation of all moments requires
+   * \f$O(n^{d+1})\f$ operations for \f$q\sim n\f$, compared to \f$O(n^{2d})\f$
+   * for the naive approach.
+   *
+   * Values at quadrature points are stored in a flat array where the point index of the
+   * last collapsed direction \f$\xi_d\f$ runs fastest. The corresponding points and weights
+   * are provided by quadraturePoints() and quadratureWeights().
+   *
+   * \tparam D Type used for domain coordinates
+   * \tparam R Type used for coefficients and function values
+   * \tparam dim Dimension of the reference simplex
+   */
+  template<class D, class R, int dim>
+  class BernsteinSimplexAlgorithms
+  {
+    using MultiIndex = std::array<unsigned int,dim+1>;
+
+  public:
+
+    /** \brief Set up the algorithms for a given polynomial order
+     *
+     * \param order Polynomial order n of the Bernstein polynomials
+     * \param quadratureOrder Order of polynomials in x that are integrated exactly
+     *   by the collapsed quadrature. The default is exact for the mass matrix.
+     */
+    explicit BernsteinSimplexAlgorithms(unsigned int order, int quadratureOrder = -1)
+      : order_(order)
+    {
+      if (quadratureOrder < 0)
+        quadratureOrder = 2*order;
+
+      // In direction s the collapsed quadrature has to integrate polynomials
+      // of order quadratureOrder + dim-1-s because of the Jacobian factor (1-xi_s)^(dim-1-s).
+      for(auto s : Dune::range(dim))
+      {
+        const auto& rule = QuadratureRules<D,1>::rule(GeometryTypes::line, quadratureOrder + dim - 1 - s);
+        auto& points = points_[s];
+        auto& weights = weights_[s];
+        points.resize(rule.size());
+        weights.resize(rule.size());
+        for(auto q : Dune::range(rule.size()))
+        {
+          points[q] = rule[q].position()[0];
+          weights[q] = rule[q].weight();
+          for(int j=0; j<dim-1-s; ++j)
+            weights[q] *= (1-points[q]);
+        }
+
+        // Tabulate the univariate Bernstein polynomials B^m_a for all m<=order
+        // using the recursion B^m_a = (1-t) B^(m-1)_a + t B^(m-1)_(a-1).
+        auto& table = bernstein_[s];
+        table.assign((order+1)*(order+2)/2*points.size(), 0);
+        for(auto q : Dune::range(points.size()))
+        {
+          const R t = points[q];
+          table[q] = 1;
+          for(unsigned int m=1; m<=order; ++m)
+          {
+            for(unsigned int a=0; a<=m; ++a)
+            {
+              R value = 0;
+              if (a < m)
+                value += (1-t)*univariate(s, m-1, a, q);
+              if (a > 0)
+                value += t*univariate(s, m-1, a-1, q);
+              table[(m*(m+1)/2 + a)*points.size() + q] = value;
+            }
+          }
+        }
+      }
+    }
+
+    //! \brief Polynomial order of the represented polynomials
+    unsigned int order () const
+    {
+      return order_;
+    }
+
+    //! \brief Number of Bernstein coefficients for polynomials of order n
+    static constexpr std::size_t size (unsigned int n)
+    {
+      return binomial(std::size_t(n+dim), std::size_t(dim));
+    }
+
+    //! \brief Number of Bernstein coefficients for polynomials of the given order
+    std::size_t size () const
+    {
+      return size(order_);
+    }
+
+    /** \brief Flat index of the barycentric multi-index alpha among all multi-indices of order |alpha|
+     *
+     * The last entry of alpha belongs to the barycentric coordinate \f$1-\sum_j x_j\f$
+     * and is not needed to determine the index.
+     */
+    static std::size_t index (const MultiIndex& alpha)
+    {
+      unsigned int n = 0;
+      for(auto a : alpha)
+        n += a;
+
+      // The multi-indices are enumerated with alpha_{dim-1} running slowest.
+      // The number of multi-indices preceding alpha_{dim-1-l} in the block of
+      // a fixed prefix follows from the hockey-stick identity.
+      std::size_t result = 0;
+      unsigned int m = n;
+      for(unsigned int l=0; l<dim; ++l)
+      {
+        const unsigned int r = dim-l;
+        const unsigned int a = alpha[dim-1-l];
+        result += binomial(m+r, r) - binomial(m-a+r, r);
+        m -= a;
+      }
+      return result;
+    }
+
+    //! \brief Number of points of the collapsed quadrature
+    std::size_t quadratureSize () const
+    {
+      std::size_t result = 1;
+      for(const auto& p : points_)
+        result *= p.size();
+      return result;
+    }
+
+    //! \brief Positions of the collapsed quadrature points on the reference simplex
+    std::vector<FieldVector<D,dim>> quadraturePoints () const
+    {
+      auto result = std::vector<FieldVector<D,dim>>(quadratureSize());
+      forEachQuadraturePoint([&](std::size_t q, const auto& xi) {
+        D scale = 1;
+        for(auto s : Dune::range(dim))
+        {
+          result[q][dim-1-s] = scale*xi[s];
+          scale *= 1-xi[s];
+        }
+      });
+      return result;
+    }
+
+    //! \brief Weights of the collapsed quadrature on the reference simplex
+    std::vector<R> quadratureWeights () const
+    {
+      auto result = std::vector<R>(quadratureSize());
+      forEachQuadraturePoint([&](std::size_t q, const auto&, const auto& qi) {
+        R w = 1;
+        for(auto s : Dune::range(dim))
+          w *= weights_[s][qi[s]];
+        result[q] = w;
+      });
+      return result;
+    }
+
+    /** \brief Evaluate a polynomial at a single point using the de Casteljau algorithm
+     *
+     * \param coefficients Bernstein coefficients of a polynomial of order n
+     * \param x Position in the reference simplex
+     */
+    template<class C>
+    static C evaluate (const std::vector<C>& coefficients, const FieldVector<D,dim>& x)
+    {
+      unsigned int n = 0;
+      while (size(n) < coefficients.size())
+        ++n;
+      if (size(n) != coefficients.size())
+        DUNE_THROW(RangeError, "Number of Bernstein coefficients does not match any polynomial order");
+
+      std::array<D,dim+1> lambda;
+      lambda[dim] = 1;
+      for(auto j : Dune::range(dim))
+      {
+        lambda[j] = x[j];
+        lambda[dim] -= x[j];
+      }
+
+      // Repeatedly replace the coefficients c_beta of order m by
+      // sum_j lambda_j c_(beta+e_j) of order m-1.
+      auto current = coefficients;
+      auto next = std::vector<C>();
+      for(unsigned int m=n; m>0; --m)
+      {
+        next.resize(size(m-1));
+        forEachMultiIndex(m-1, [&](std::size_t i, MultiIndex beta) {
+          for(auto j : Dune::range(dim+1))
+          {
+            ++beta[j];
+            if (j == 0)
+              next[i] = current[index(beta)] * lambda[j];
+            else
+              next[i] += current[index(beta)] * lambda[j];
+            --beta[j];
+          }
+        });
+        std::swap(current, next);
+      }
+      return current[0];
+    }
+
+    /** \brief Evaluate a polynomial at all collapsed quadrature points
+     *
+     * \param coefficients Bernstein coefficients of a polynomial of the given order
+     * \param[out] values Values at the quadrature points
+     */
+    void evaluate (const std::vector<R>& coefficients, std::vector<R>& values) const
+    {
+      evaluate(order_, coefficients, values);
+    }
+
+    /** \brief Compute all Bernstein moments \f$\int_T f B_\alpha\,dx\f$ from values at the quadrature points
+     *
+     * \param values Values of f at the collapsed quadrature points
+     * \param[out] moments The moments for all multi-indices of the given order
+     */
+    void moments (const std::vector<R>& values, std::vector<R>& moments) const
+    {
+      this->moments(order_, values, moments);
+    }
+
+    /** \brief Compute all Bernstein moments \f$\int_T f B_\alpha\,dx\f$ of a function
+     *
+     * \param f Function to be integrated, evaluated at the quadrature points
+     * \param[out] moments The moments for all multi-indices of the given order
+     */
+    template<class F>
+    void functionMoments (const F& f, std::vector<R>& moments) const
+    {
+      auto points = quadraturePoints();
+      auto values = std::vector<R>(points.size());
+      for(auto q : Dune::range(points.size()))
+        values[q] = f(points[q]);
+      this->moments(order_, values, moments);
+    }
+
+    /** \brief Apply the element mass matrix on the reference simplex
+     *
+     * Computes \f$y_\alpha = \sum_\beta \int_T B_\alpha B_\beta\,dx\, c_\beta\f$
+     * in \f$O(n^{d+1})\f$ operations without assembling the matrix.
+     */
+    void applyMass (const std::vector<R>& coefficients, std::vector<R>& out) const
+    {
+      auto values = std::vector<R>();
+      evaluate(order_, coefficients, values);
+      moments(order_, values, out);
+    }
+
+    /** \brief Apply the stiffness matrix \f$\int_T \nabla B_\alpha \cdot G\nabla B_\beta\,dx\f$
+     *
+     * The gradient is computed in Bernstein form of order n-1 using
+     * \f$\partial_{x_i} u = n\sum_{|\beta|=n-1}(c_{\beta+e_i}-c_{\beta+e_d})B^{n-1}_\beta\f$
+     * and the result is obtained from moments of order n-1. For an affine element
+     * with Jacobian \f$J\f$ the matrix G is \f$|\det J| J^{-1}J^{-T}\f$.
+     *
+     * \param G Constant symmetric coefficient matrix
+     * \param coefficients Bernstein coefficients of order n
+     * \param[out] out Result of the matrix-vector product
+     */
+    void applyStiffness (const FieldMatrix<R,dim,dim>& G, const std::vector<R>& coefficients, std::vector<R>& out) const
+    {
+      out.assign(size(), 0);
+      if (order_ == 0)
+        return;
+
+      const unsigned int n = order_;
+      std::array<std::vector<R>,dim> gradientValues;
+      std::vector<R> derivativeCoefficients(size(n-1));
+      for(auto i : Dune::range(dim))
+      {
+        forEachMultiIndex(n-1, [&](std::size_t b, MultiIndex beta) {
+          ++beta[i];
+          derivativeCoefficients[b] = coefficients[index(beta)];
+          --beta[i];
+          ++beta[dim];
+          derivativeCoefficients[b] -= coefficients[index(beta)];
+          derivativeCoefficients[b] *= n;
+        });
+        evaluate(n-1, derivativeCoefficients, gradientValues[i]);
+      }
+
+      std::vector<R> flux(quadratureSize());
+      std::vector<R> fluxMoments;
+      for(auto i : Dune::range(dim))
+      {
+        for(auto q : Dune::range(flux.size()))
+        {
+          flux[q] = 0;
+          for(auto j : Dune::range(dim))
+            flux[q] += G[i][j]*gradientValues[j][q];
+        }
+        moments(n-1, flux, fluxMoments);
+        forEachMultiIndex(n-1, [&](std::size_t b, MultiIndex beta) {
+          ++beta[i];
+          out[index(beta)] += n*fluxMoments[b];
+          --beta[i];
+          ++beta[dim];
+          out[index(beta)] -= n*fluxMoments[b];
+        });
+      }
+    }
+
+    /** \brief Represent a polynomial of order n as polynomial of order n+1
+     *
+     * Uses \f$c^{n+1}_\alpha = \sum_j \frac{\alpha_j}{n+1} c^n_{\alpha-e_j}\f$.
+     */
+    template<class C>
+    static void raiseDegree (const std::vector<C>& coefficients, std::vector<C>& out)
+    {
+      unsigned int n = 0;
+      while (size(n) < coefficients.size())
+        ++n;
+      if (size(n) != coefficients.size())
+        DUNE_THROW(RangeError, "Number of Bernstein coefficients does not match any polynomial order");
+
+      out.resize(size(n+1));
+      forEachMultiIndex(n+1, [&](std::size_t i, MultiIndex alpha) {
+        bool initialized = false;
+        for(auto j : Dune::range(dim+1))
+        {
+          if (alpha[j] == 0)
+            continue;
+          const auto weight = D(alpha[j])/(n+1);
+          --alpha[j];
+          if (initialized)
+            out[i] += coefficients[index(alpha)] * weight;
+          else
+            out[i] = coefficients[index(alpha)] * weight;
+          initialized = true;
+          ++alpha[j];
+        }
+      });
+    }
+
+    /** \brief Represent a polynomial of order n+1 as polynomial of order n
+     *
+     * This is the exact inverse of raiseDegree() on polynomials of order n.
+     * The coefficients are recovered from the relation
+     * \f$(\beta_d+1)c^n_\beta = (n+1)c^{n+1}_{\beta+e_d} - \sum_{j<d}\beta_j c^n_{\beta+e_d-e_j}\f$
+     * by processing the multi-indices with decreasing \f$\beta_d\f$. If the input
+     * is not of reduced order, the result is not a best approximation.
+     */
+    template<class C>
+    static void lowerDegree (const std::vector<C>& coefficients, std::vector<C>& out)
+    {
+      unsigned int n = 0;
+      while (size(n) < coefficients.size())
+        ++n;
+      if ((size(n) != coefficients.size()) or (n == 0))
+        DUNE_THROW(RangeError, "Number of Bernstein coefficients does not match any polynomial order >= 1");
+      --n;
+
+      out.resize(size(n));
+      for(int last=n; last>=0; --last)
+      {
+        forEachMultiIndex(n, [&](std::size_t i, MultiIndex beta) {
+          if (beta[dim] != (unsigned int)last)
+            return;
+          ++beta[dim];
+          out[i] = coefficients[index(beta)] * D(n+1);
+          for(auto j : Dune::range(dim))
+          {
+            if (beta[j] == 0)
+              continue;
+            const auto weight = D(beta[j]);
+            --beta[j];
+            out[i] -= out[index(beta)] * weight;
+            ++beta[j];
+          }
+          out[i] = out[i] * (D(1)/(last+1));
+        });
+      }
+    }
+
+    /** \brief Call f(i, alpha) for all barycentric multi-indices alpha of order n
+     *
+     * The multi-indices are visited in the order of the Bernstein coefficients.
+     */
+    template<class F>
+    static void forEachMultiIndex (unsigned int n, F&& f)
+    {
+      auto alpha = MultiIndex{};
+      forEachMultiIndexImpl<dim-1>(n, alpha, 0, f);
+    }
+
+  private:
+
+    template<int l, class F>
+    static std::size_t forEachMultiIndexImpl (unsigned int m, MultiIndex& alpha, std::size_t i, F& f)
+    {
+      for(unsigned int a=0; a<=m; ++a)
+      {
+        alpha[l] = a;
+        if constexpr (l == 0)
+        {
+          alpha[dim] = m-a;
+          f(i++, alpha);
+        }
+        else
+          i = forEachMultiIndexImpl<l-1>(m-a, alpha, i, f);
+      }
+      return i;
+    }
+
+    template<class F>
+    void forEachQuadraturePoint (F&& f) const
+    {
+      std::array<std::size_t,dim> qi{};
+      std::array<D,dim> xi;
+      for(auto q : Dune::range(quadratureSize()))
+      {
+        // q_d runs fastest
+        std::size_t rest = q;
+        for(int s=dim-1; s>=0; --s)
+        {
+          qi[s] = rest % points_[s].size();
+          rest /= points_[s].size();
+          xi[s] = points_[s][qi[s]];
+        }
+        if constexpr (std::is_invocable_v<F, std::size_t, decltype(xi), decltype(qi)>)
+          f(q, xi, qi);
+        else
+          f(q, xi);
+      }
+    }
+
+    // The univariate Bernstein polynomial B^m_a at the q-th point in direction s
+    const R& univariate (int s, unsigned int m, unsigned int a, std::size_t q) const
+    {
+      return bernstein_[s][(m*(m+1)/2 + a)*points_[s].size() + q];
+    }
+
+    // Size of the tensor of values in the collapsed directions s,...,dim-1
+    std::size_t tensorSize (int s) const
+    {
+      std::size_t result = 1;
+      for(int j=s; j<dim; ++j)
+        result *= points_[j].size();
+      return result;
+    }
+
+    void evaluate (unsigned int n, const std::vector<R>& coefficients, std::vector<R>& values) const
+    {
+      if (coefficients.size() != size(n))
+        DUNE_THROW(RangeError, "Number of Bernstein coefficients does not match the polynomial order");
+      std::array<std::vector<R>,dim+1> buffers;
+      for(auto s : Dune::range(dim+1))
+        buffers[s].resize(tensorSize(s));
+      std::size_t offset = 0;
+      evaluateImpl<0>(n, coefficients, offset, buffers);
+      values = std::move(buffers[0]);
+    }
+
+    // Compute the values of the partial sum over all multi-indices with fixed
+    // prefix (alpha_{dim-1},...,alpha_{dim-s}) at all points in the collapsed
+    // directions s,...,dim-1 and store them in buffers[s].
+    template<int s>
+    void evaluateImpl (unsigned int m, const std::vector<R>& coefficients, std::size_t& offset,
+                       std::array<std::vector<R>,dim+1>& buffers) const
+    {
+      if constexpr (s == dim)
+        buffers[dim][0] = coefficients[offset++];
+      else
+      {
+        auto& result = buffers[s];
+        const auto& child = buffers[s+1];
+        const std::size_t nq = points_[s].size();
+        const std::size_t restSize = child.size();
+        std::fill(result.begin(), result.end(), 0);
+        for(unsigned int a=0; a<=m; ++a)
+        {
+          evaluateImpl<s+1>(m-a, coefficients, offset, buffers);
+          for(std::size_t q=0; q<nq; ++q)
+          {
+            const R b = univariate(s, m, a, q);
+            for(std::size_t r=0; r<restSize; ++r)
+              result[q*restSize + r] += b * child[r];
+          }
+        }
+      }
+    }
+
+    void moments (unsigned int n, const std::vector<R>& values, std::vector<R>& moments) const
+    {
+      if (values.size() != quadratureSize())
+        DUNE_THROW(RangeError, "Number of values does not match the number of quadrature points");
+      std::array<std::vector<R>,dim+1> buffers;
+      for(auto s : Dune::range(dim+1))
+        buffers[s].resize(tensorSize(s));
+
+      // Scale the values by the quadrature weights
+      forEachQuadraturePoint([&](std::size_t q, const auto&, const auto& qi) {
+        R w = values[q];
+        for(auto s : Dune::range(dim))
+          w *= weights_[s][qi[s]];
+        buffers[0][q] = w;
+      });
+
+      moments.resize(size(n));
+      std::size_t offset = 0;
+      momentsImpl<0>(n, moments, offset, buffers);
+    }
+
+    // Contract the weighted values stored in buffers[s] against the univariate
+    // Bernstein polynomials in direction s. This is the transpose of evaluateImpl().
+    template<int s>
+    void momentsImpl (unsigned int m, std::vector<R>& moments, std::size_t& offset,
+                      std::array<std::vector<R>,dim+1>& buffers) const
+    {
+      if constexpr (s == dim)
+        moments[offset++] = buffers[dim][0];
+      else
+      {
+        const auto& parent = buffers[s];
+        auto& child = buffers[s+1];
+        const std::size_t nq = points_[s].size();
+        const std::size_t restSize = child.size();
+        for(unsigned int a=0; a<=m; ++a)
+        {
+          std::fill(child.begin(), child.end(), 0);
+          for(std::size_t q=0; q<nq; ++q)
+          {
+            const R b = univariate(s, m, a, q);
+            for(std::size_t r=0; r<restSize; ++r)
+              child[r] += b * parent[q*restSize + r];
+          }
+          momentsImpl<s+1>(m-a, moments, offset, buffers);
+        }
+      }
+    }
+
+    unsigned int order_;
+    std::array<std::vector<D>,dim> points_;
+    std::array<std::vector<R>,dim> weights_;
+    std::array<std::vector<R>,dim> bernstein_;
+  };
+
+}        // namespace Dune
+
+#endif   // DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINALGORITHMS_HH
@@ -0,0 +1,63 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINLFECACHE_HH
+#define DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINLFECACHE_HH
+
+#include <tuple>
+#include <utility>
+
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
+
+#include <dune/localfunctions/bernstein/bernsteinsimplex.hh>
+#include <dune/localfunctions/common/localfiniteelementvariantcache.hh>
+
+
+namespace Dune {
+
+
+
+namespace Impl {
+
+  // Provide implemented Bernstein local finite elements
+
+  template<class D, class R, std::size_t dim, std::size_t order>
+  struct ImplementedBernsteinFiniteElements : public FixedDimLocalGeometryTypeIndex<dim>
+  {
+    using FixedDimLocalGeometryTypeIndex<dim>::index;
+    static auto getImplementations()
+    {
+      return std::make_tuple(
+        std::make_pair(index(GeometryTypes::simplex(dim)), []() { return BernsteinSimplexLocalFiniteElement<D,R,dim,order>(); })
+      );
+    }
+  };
+
+} // namespace Impl
+
+
+
+/** \brief A cache that stores all available Bernstein-Bezier local finite elements for the given dimension and order
+ *
+ * Currently only simplices are supported.
+ *
+ * \tparam D Type used for domain coordinates
+ * \tparam R Type used for shape function values
+ * \tparam dim Element dimension
+ * \tparam order Element order
+ *
+ * The cached finite element implementations can be obtained using get(GeometryType).
+ */
+template<class D, class R, std::size_t dim, std::size_t order>
+using BernsteinLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedBernsteinFiniteElements<D,R,dim,order>>;
+
+
+
+} // namespace Dune
+
+
+
+
+#endif // DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINLFECACHE_HH
@@ -0,0 +1,441 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINSIMPLEX_HH
+#define DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINSIMPLEX_HH
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+
+namespace Dune { namespace Impl
+{
+  /** \brief Bernstein polynomials of arbitrary order on the reference simplex
+
+     The Bernstein polynomials of order \f$k\f$ are
+     \f$B_\alpha = \frac{k!}{\alpha!}\lambda^\alpha\f$ where \f$\lambda\f$
+     denotes the barycentric coordinates and \f$\alpha\f$ runs over all
+     multi-indices with \f$|\alpha| = k\f$. The enumeration of the basis
+     functions coincides with the enumeration of the Lagrange nodes in
+     LagrangeSimplexLocalBasis, i.e., \f$B_\alpha\f$ has the index of the
+     Lagrange node \f$\alpha/k\f$.
+
+     \tparam D Type to represent the field in the domain
+     \tparam R Type to represent the field in the range
+     \tparam dim Dimension of the domain simplex
+     \tparam k Polynomial order
+   */
+  template<class D, class R, unsigned int dim, unsigned int k>
+  class BernsteinSimplexLocalBasis
+  {
+    using BarycentricMultiIndex = std::array<unsigned int,dim+1>;
+
+    // Barycentric coordinates of x with respect to the vertices
+    // p_i = e_i (for i=0,...,dim-1) and p_dim=0.
+    static constexpr auto barycentric(const auto& x)
+    {
+      auto b = std::array<R,dim+1>{};
+      b[dim] = 1;
+      for(auto i : Dune::range(dim))
+      {
+        b[i] = x[i];
+        b[dim] -= b[i];
+      }
+      return b;
+    }
+
+    // Compute the scaled powers P[j][m] = lambda_j^m / m! for m=0,...,k.
+    // Then B_alpha = k! * prod_j P[j][alpha_j] and all derivatives
+    // with respect to the barycentric coordinates are obtained by
+    // shifting the indices.
+    static constexpr auto scaledPowers(const auto& x)
+    {
+      auto lambda = barycentric(x);
+      auto P = std::array<std::array<R,k+1>,dim+1>{};
+      for(auto j : Dune::range(dim+1))
+      {
+        P[j][0] = 1;
+        for(auto m : Dune::range(k))
+          P[j][m+1] = P[j][m] * lambda[j] / (m+1);
+      }
+      return P;
+    }
+
+    static constexpr R kFactorial()
+    {
+      R result = 1;
+      for(auto m : Dune::range(k))
+        result *= (m+1);
+      return result;
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    /** \brief Enumerate the barycentric multi-indices of all shape functions
+     *
+     * The i-th entry contains the multi-index \f$\alpha\f$ of the
+     * i-th shape function, where the last entry belongs to the
+     * barycentric coordinate \f$1-\sum_j x_j\f$.
+     */
+    static constexpr auto multiIndices()
+    {
+      auto result = std::array<BarycentricMultiIndex,size()>{};
+      auto alpha = BarycentricMultiIndex{};
+      for(auto n : Dune::range(size()))
+      {
+        unsigned int sum = 0;
+        for(auto j : Dune::range(dim))
+          sum += alpha[j];
+        alpha[dim] = k - sum;
+        result[n] = alpha;
+
+        // Increment the multi-index with alpha_0 running fastest
+        ++alpha[0];
+        ++sum;
+        for(unsigned int j=0; (j+1<dim) and (sum > k); ++j)
+        {
+          sum -= alpha[j];
+          alpha[j] = 0;
+          ++alpha[j+1];
+          ++sum;
+        }
+      }
+      return result;
+    }
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return binomial(k+dim,dim);
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+
+      if (k==0)
+      {
+        out[0] = 1;
+        return;
+      }
+
+      const auto P = scaledPowers(x);
+      constexpr auto alphas = multiIndices();
+      for(auto n : Dune::range(size()))
+      {
+        R y = kFactorial();
+        for(auto j : Dune::range(dim+1))
+          y *= P[j][alphas[n][j]];
+        out[n] = y;
+      }
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions
+     *
+     * This uses \f$\partial_{x_i} B^k_\alpha = k(B^{k-1}_{\alpha-e_i} - B^{k-1}_{\alpha-e_{d}})\f$.
+     *
+     * \param x Point in the reference simplex where to evaluation the Jacobians
+     * \param[out] out The Jacobians of all shape functions at the point x
+     */
+    void evaluateJacobian(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+
+      if (k==0)
+      {
+        std::fill(out[0][0].begin(), out[0][0].end(), 0);
+        return;
+      }
+
+      const auto P = scaledPowers(x);
+      constexpr auto alphas = multiIndices();
+      for(auto n : Dune::range(size()))
+      {
+        const auto& alpha = alphas[n];
+
+        // Product of all factors except the one for the j-th coordinate
+        // where the exponent is reduced by one.
+        auto reducedProduct = [&](unsigned int j) {
+          if (alpha[j] == 0)
+            return R(0);
+          R y = kFactorial();
+          for(auto l : Dune::range(dim+1))
+            y *= P[l][alpha[l] - (l==j)];
+          return y;
+        };
+
+        const R last = reducedProduct(dim);
+        for(auto i : Dune::range(dim))
+          out[n][0][i] = reducedProduct(i) - last;
+      }
+    }
+
+    /** \brief Evaluate partial derivatives of any order of all shape functions
+     *
+     * Since \f$\partial_{x_i} = \partial_{\lambda_i} - \partial_{\lambda_d}\f$ the
+     * partial derivative \f$\partial^\beta\f$ is expanded into a sum of derivatives
+     * with respect to the barycentric coordinates which are available in closed form.
+     *
+     * \param order Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    void partial(const std::array<unsigned int,dim>& order,
+                 const typename Traits::DomainType& in,
+                 std::vector<typename Traits::RangeType>& out) const
+    {
+      auto totalOrder = std::accumulate(order.begin(), order.end(), 0u);
+
+      out.resize(size());
+
+      if (totalOrder == 0)
+      {
+        evaluateFunction(in, out);
+        return;
+      }
+
+      if (totalOrder > k)
+      {
+        for(auto& out_i : out)
+          out_i = 0;
+        return;
+      }
+
+      const auto P = scaledPowers(in);
+      constexpr auto alphas = multiIndices();
+
+      // Enumerate all gamma <= order and precompute the signed
+      // binomial weight of the term d_lambda^gamma d_lambda_d^(|order|-|gamma|).
+      std::vector<std::pair<BarycentricMultiIndex,R>> terms;
+      auto gamma = std::array<unsigned int,dim>{};
+      while (true)
+      {
+        auto mu = BarycentricMultiIndex{};
+        R weight = 1;
+        unsigned int gammaOrder = 0;
+        for(auto i : Dune::range(dim))
+        {
+          mu[i] = gamma[i];
+          gammaOrder += gamma[i];
+          weight *= binomial(order[i], gamma[i]);
+        }
+        mu[dim] = totalOrder - gammaOrder;
+        if (mu[dim] % 2)
+          weight = -weight;
+        terms.emplace_back(mu, weight);
+
+        unsigned int i = 0;
+        while ((i < dim) and (gamma[i] == order[i]))
+          gamma[i++] = 0;
+        if (i == dim)
+          break;
+        ++gamma[i];
+      }
+
+      for(auto n : Dune::range(size()))
+      {
+        const auto& alpha = alphas[n];
+        R y = 0;
+        for(const auto& [mu, weight] : terms)
+        {
+          R term = weight;
+          for(auto j : Dune::range(dim+1))
+          {
+            if (mu[j] > alpha[j])
+            {
+              term = 0;
+              break;
+            }
+            term *= P[j][alpha[j] - mu[j]];
+          }
+          y += term;
+        }
+        out[n] = y * kFactorial();
+      }
+    }
+
+    //! \brief Polynomial order of the shape functions
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+  };
+
+  /** \brief Interpolation into the Bernstein basis on the reference simplex
+   *
+   * The function is evaluated at the Lagrange nodes of order k and the
+   * resulting values are transformed into Bernstein coefficients by the
+   * inverse of the Bernstein-Vandermonde matrix. Since the Bernstein
+   * polynomials restricted to a subentity only depend on the Lagrange nodes
+   * on this subentity, the resulting interpolation is conforming.
+   *
+   * \tparam LocalBasis The corresponding set of shape functions
+   */
+  template<class LocalBasis>
+  class BernsteinSimplexLocalInterpolation
+  {
+    using RF = typename LocalBasis::Traits::RangeFieldType;
+
+    // The inverse Bernstein-Vandermonde matrix only depends on the
+    // basis type and is thus shared by all instances.
+    static const DynamicMatrix<RF>& inverseVandermonde()
+    {
+      static const DynamicMatrix<RF> matrix = [] {
+        constexpr auto n = LocalBasis::size();
+        auto V = DynamicMatrix<RF>(n, n, 0);
+        auto nodes = std::vector<typename LocalBasis::Traits::DomainType>();
+        auto dummy = std::vector<RF>();
+        nodes.reserve(n);
+        LagrangeSimplexLocalInterpolation<LocalBasis>().interpolate([&](const auto& x) {
+          nodes.push_back(x);
+          return RF(0);
+        }, dummy);
+        auto values = std::vector<typename LocalBasis::Traits::RangeType>();
+        for(auto i : Dune::range(n))
+        {
+          LocalBasis().evaluateFunction(nodes[i], values);
+          for(auto j : Dune::range(n))
+            V[i][j] = values[j];
+        }
+        V.invert();
+        return V;
+      }();
+      return matrix;
+    }
+
+  public:
+
+    /** \brief Compute the Bernstein coefficients of the interpolant of a given function
+     *
+     * \tparam F Type of function to evaluate
+     * \tparam C Type used for the values of the function
+     * \param[in] f Function to evaluate
+     * \param[out] out Array of Bernstein coefficients
+     */
+    template<typename F, typename C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      constexpr auto n = LocalBasis::size();
+      auto values = std::vector<C>();
+      LagrangeSimplexLocalInterpolation<LocalBasis>().interpolate(f, values);
+
+      if (LocalBasis::order() == 0)
+      {
+        out = values;
+        return;
+      }
+
+      const auto& Vinv = inverseVandermonde();
+      out.resize(n);
+      for(auto i : Dune::range(n))
+      {
+        out[i] = values[0] * Vinv[i][0];
+        for(auto j : Dune::range(1u, n))
+          out[i] += values[j] * Vinv[i][j];
+      }
+    }
+  };
+
+} }    // namespace Dune::Impl
+
+namespace Dune
+{
+  /** \brief Bernstein-Bezier finite element for simplices with arbitrary compile-time dimension and polynomial order
+   *
+   * The shape functions are the Bernstein polynomials
+   * \f[
+   *   B_\alpha(x) = \frac{k!}{\alpha_0!\cdots\alpha_d!}\lambda_0^{\alpha_0}\cdots\lambda_d^{\alpha_d},
+   *   \qquad |\alpha| = k,
+   * \f]
+   * where \f$\lambda_j = x_j\f$ for \f$j<d\f$ and \f$\lambda_d = 1-\sum_{j<d} x_j\f$.
+   * They span the same space as the Lagrange simplex element of order \f$k\f$ and
+   * share its association of degrees of freedom to subentities, but they are
+   * non-negative, form a partition of unity and are well suited for the
+   * sum-factorized algorithms provided by BernsteinSimplexAlgorithms.
+   *
+   * \tparam D type used for domain coordinates
+   * \tparam R type used for function values
+   * \tparam d dimension of the reference element
+   * \tparam k polynomial order
+   */
+  template<class D, class R, int d, int k>
+  class BernsteinSimplexLocalFiniteElement
+  {
+  public:
+    /** \brief Export number types, dimensions, etc.
+     */
+    using Traits = LocalFiniteElementTraits<Impl::BernsteinSimplexLocalBasis<D,R,d,k>,
+                                            Impl::LagrangeSimplexLocalCoefficients<d,k>,
+                                            Impl::BernsteinSimplexLocalInterpolation<Impl::BernsteinSimplexLocalBasis<D,R,d,k> > >;
+
+    /** Default-construct the finite element */
+    BernsteinSimplexLocalFiniteElement() {}
+
+    /** \brief Constructs a finite element given a vertex reordering
+     * */
+    template<typename VertexMap>
+    BernsteinSimplexLocalFiniteElement(const VertexMap& vertexmap)
+      : coefficients_(vertexmap)
+    {}
+
+    /** \brief Returns the local basis, i.e., the set of shape functions
+     */
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    /** \brief Returns the assignment of the degrees of freedom to the element subentities
+     */
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    /** \brief Returns object that evaluates degrees of freedom
+     */
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    /** \brief The number of shape functions */
+    static constexpr std::size_t size ()
+    {
+      return Impl::BernsteinSimplexLocalBasis<D,R,d,k>::size();
+    }
+
+    /** \brief The reference element that the local finite element is defined on
+     */
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::simplex(d);
+    }
+
+  private:
+    Impl::BernsteinSimplexLocalBasis<D,R,d,k> basis_;
+    Impl::LagrangeSimplexLocalCoefficients<d,k> coefficients_;
+    Impl::BernsteinSimplexLocalInterpolation<Impl::BernsteinSimplexLocalBasis<D,R,d,k> > interpolation_;
+  };
+
+}        // namespace Dune
+
+#endif   // DUNE_LOCALFUNCTIONS_BERNSTEIN_BERNSTEINSIMPLEX_HH
@@ -5,6 +5,9 @@
 #ifndef DUNE_LOCALFUNCTIONS_COMMON_LOCALFINITEELEMENTVARIANTCACHE_HH
 #define DUNE_LOCALFUNCTIONS_COMMON_LOCALFINITEELEMENTVARIANTCACHE_HH
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <tuple>
 #include <utility>
@@ -61,9 +64,17 @@ namespace Impl {
  * indices. Hence densely packed indices should be preferred to avoid wasting space
  * for empty LocalFiniteElementVariant's string no implementation.
  *
+ * If lazy is true, the implementations are instead created on the first request by
+ * get() or prefetch(). The creation of each implementation happens exactly once, also
+ * if it is requested concurrently by several threads, and requests of implementations
+ * that have already been created only require an atomic load. This avoids the cost of
+ * creating expensive implementations that are never used. Copying a lazy cache is not
+ * thread safe.
+ *
  * \tparam Base Type of the base class providing getImplementations() and index().
+ * \tparam lazy Create the implementations on first request instead of during construction.
  */
-template<class Base>
+template<class Base, bool lazy = false>
 class LocalFiniteElementVariantCache : Base
 {
 
@@ -80,6 +91,13 @@ class LocalFiniteElementVariantCache : Base
   using Base::index;
   using Implementations = decltype(std::declval<Base>().getImplementations());
 
+  // Synchronization of the lazy creation of one implementation
+  struct Slot
+  {
+    std::atomic<bool> created = false;
+    std::once_flag flag;
+  };
+
 public:
 
   /**
@@ -93,7 +111,7 @@ public:
 
   /** \brief Default constructor
    *
-   * Prefills the cache with all implementations.
+   * Prefills the cache with all implementations, unless the cache is lazy.
    */
   template<class... Args>
   LocalFiniteElementVariantCache(Args&&... args) :
@@ -103,18 +121,39 @@ public:
       auto implIndex = feImpl.first;
       if (cache_.size() < implIndex+1)
         cache_.resize(implIndex+1);
-      cache_[implIndex] = feImpl.second();
+      if constexpr (not lazy)
+        cache_[implIndex] = feImpl.second();
     });
+    if constexpr (lazy)
+      slots_ = std::make_unique<Slot[]>(cache_.size());
   }
 
   /** \brief Copy constructor */
-  LocalFiniteElementVariantCache(const LocalFiniteElementVariantCache& other) = default;
+  LocalFiniteElementVariantCache(const LocalFiniteElementVariantCache& other) :
+    Base(other),
+    cache_(other.cache_)
+  {
+    if constexpr (lazy)
+    {
+      // The implementations already created by other are not created again
+      slots_ = std::make_unique<Slot[]>(cache_.size());
+      for (std::size_t i = 0; i < cache_.size(); ++i)
+        if (other.slots_[i].created.load(std::memory_order_acquire))
+        {
+          std::call_once(slots_[i].flag, []() {});
+          slots_[i].created.store(true, std::memory_order_release);
+        }
+    }
+  }
 
   /** \brief Move constructor */
   LocalFiniteElementVariantCache(LocalFiniteElementVariantCache&& other) = default;
 
   /** \brief Copy assignment */
-  LocalFiniteElementVariantCache& operator= (const LocalFiniteElementVariantCache& other) = default;
+  LocalFiniteElementVariantCache& operator= (const LocalFiniteElementVariantCache& other)
+  {
+    return *this = LocalFiniteElementVariantCache(other);
+  }
 
   /** \brief Move assignment */
   LocalFiniteElementVariantCache& operator= (LocalFiniteElementVariantCache&& other) = default;
@@ -129,13 +168,44 @@ public:
     auto implIndex = index(key...);
     if (implIndex >= cache_.size())
       DUNE_THROW(Dune::RangeError,"There is no LocalFiniteElement of the requested type.");
+    if constexpr (lazy)
+      create(implIndex);
     if (not(cache_[implIndex]))
       DUNE_THROW(Dune::RangeError,"There is no LocalFiniteElement of the requested type.");
     return cache_[implIndex];
   }
 
+  /** \brief Create the LocalFiniteElement for the given key data, if the cache is lazy
+   *
+   * This allows to create the implementations which are known to be used in advance,
+   * e.g. before the cache is accessed concurrently.
+   *
+   * \throws Dune::RangeError If the cache doesn't hold a value matching the requested type.
+   */
+  template<class... Key>
+  void prefetch(const Key&... key) const
+  {
+    get(key...);
+  }
+
 private:
-  std::vector<FiniteElementType> cache_;
+  // Create the implementation of the given index exactly once
+  void create(std::size_t implIndex) const
+  {
+    Slot& slot = slots_[implIndex];
+    if (slot.created.load(std::memory_order_acquire))
+      return;
+    std::call_once(slot.flag, [&,this]() {
+      Dune::Hybrid::forEach(getImplementations(), [&,this](auto feImpl) {
+        if (feImpl.first == implIndex)
+          cache_[implIndex] = feImpl.second();
+      });
+      slot.created.store(true, std::memory_order_release);
+    });
+  }
+
+  mutable std::vector<FiniteElementType> cache_;
+  std::unique_ptr<Slot[]> slots_;
 };
 
 
@@ -7,6 +7,7 @@
 #define DUNE_LOCALFUNCTIONS_COMMON_LOCALTOGLOBALADAPTORS_HH
 
 #include <cstddef>
+#include <type_traits>
 #include <vector>
 
 #include <dune/common/fmatrix.hh>
@@ -56,6 +57,11 @@ namespace Dune {
    * Here the hat \f$\hat{\phantom x}\f$ denotes local quantities and
    * \f$\mu\f$ denotes the local-to-global map of the geometry.
    *
+   * The gradients of all shape functions at a point are transformed at once.
+   * An object of this class holds no mutable state and may be used
+   * concurrently from several threads, see
+   * CachedScalarLocalToGlobalBasisAdaptor for a variant reusing its storage.
+   *
    * \tparam LocalBasis Type of the local basis to adapt.
    * \tparam Geometry   Type of the local-to-global transformation.
    *
@@ -76,6 +82,10 @@ namespace Dune {
       "ScalarLocalToGlobalBasisAdaptor: LocalBasis domain dimension must "
       "match local dimension of Geometry");
 
+  protected:
+    static const std::size_t mydim = Geometry::mydimension;
+    static const std::size_t coorddim = Geometry::coorddimension;
+
     const LocalBasis& localBasis;
     Geometry geometry;
 
@@ -132,9 +142,83 @@ namespace Dune {
       const typename Geometry::JacobianInverseTransposed &geoJacobian =
         geometry.jacobianInverseTransposed(in);
 
+      transformJacobians(geoJacobian, localJacobian, out);
+    }
+
+  protected:
+    //! transform the local Jacobians of all shape functions at once
+    template<class JacobianInverseTransposed>
+    void transformJacobians(const JacobianInverseTransposed& geoJacobian,
+                            const std::vector<typename LocalBasis::Traits::JacobianType>& localJacobian,
+                            std::vector<typename Traits::Jacobian>& out) const
+    {
       out.resize(size());
       for(std::size_t i = 0; i < size(); ++i)
-        geoJacobian.mv(localJacobian[i][0], out[i][0]);
+        for(std::size_t k = 0; k < coorddim; ++k) {
+          typename Traits::RangeField y = 0;
+          for(std::size_t l = 0; l < mydim; ++l)
+            y += geoJacobian[k][l] * localJacobian[i][0][l];
+          out[i][0][k] = y;
+        }
+    }
+  };
+
+  //! Convert a simple scalar local basis into a global basis, reusing storage
+  /**
+   * Behaves like ScalarLocalToGlobalBasisAdaptor, but computes
+   * \f$\hat J_\mu^{-T}\f$ of affine geometries only once in the constructor
+   * and evaluates the local Jacobians into storage kept by the adaptor.  This
+   * avoids an allocation per call of evaluateJacobian().
+   *
+   * \note The storage is reused between calls, hence an object of this class
+   *       must not be used concurrently from several threads.
+   *
+   * \tparam LocalBasis Type of the local basis to adapt.
+   * \tparam Geometry   Type of the local-to-global transformation.
+   *
+   * \implements BasisInterface
+   */
+  template<class LocalBasis, class Geometry>
+  class CachedScalarLocalToGlobalBasisAdaptor
+    : public ScalarLocalToGlobalBasisAdaptor<LocalBasis, Geometry>
+  {
+    typedef ScalarLocalToGlobalBasisAdaptor<LocalBasis, Geometry> Base;
+
+    // computed once for affine geometries, scratch storage otherwise
+    mutable FieldMatrix<typename Geometry::ctype, Base::coorddim, Base::mydim> jacobianInverseTransposed;
+    mutable std::vector<typename LocalBasis::Traits::JacobianType> localJacobians;
+
+  public:
+    typedef typename Base::Traits Traits;
+
+    //! construct a CachedScalarLocalToGlobalBasisAdaptor
+    /**
+     * \param localBasis_ The local basis object to adapt.
+     * \param geometry_   The geometry object to use for adaption.
+     *
+     * \note This class stores the references passed here.  Any use of this
+     *       class after these references have become invalid results in
+     *       undefined behaviour.  The exception is that the destructor of
+     *       this class may still be called.
+     */
+    CachedScalarLocalToGlobalBasisAdaptor(const LocalBasis& localBasis_,
+                                          const Geometry& geometry_) :
+      Base(localBasis_, geometry_)
+    {
+      // the Jacobian of an affine geometry may be evaluated anywhere, the
+      // origin is a corner of all reference elements
+      if(this->geometry.affine())
+        jacobianInverseTransposed = this->geometry.jacobianInverseTransposed(typename Traits::DomainLocal(0));
+    }
+
+    void evaluateJacobian(const typename Traits::DomainLocal& in,
+                          std::vector<typename Traits::Jacobian>& out) const
+    {
+      this->localBasis.evaluateJacobian(in, localJacobians);
+      if(!this->geometry.affine())
+        jacobianInverseTransposed = this->geometry.jacobianInverseTransposed(in);
+
+      this->transformJacobians(jacobianInverseTransposed, localJacobians, out);
     }
   };
 
@@ -180,16 +264,20 @@ namespace Dune {
    *
    * \tparam LocalFiniteElement Type of the local finite element to adapt.
    * \tparam Geometry           Type of the local-to-global transformation.
+   * \tparam BasisAdaptor       Template of the basis adaptor, e.g.
+   *                            CachedScalarLocalToGlobalBasisAdaptor for
+   *                            an adaptor reusing its storage.
    *
    * \implements FiniteElementInterface
    */
-  template<class LocalFiniteElement, class Geometry>
+  template<class LocalFiniteElement, class Geometry,
+           template<class, class> class BasisAdaptor = ScalarLocalToGlobalBasisAdaptor>
   struct ScalarLocalToGlobalFiniteElementAdaptor {
     /**
      * \implements FiniteElementInterface::Traits
      */
     struct Traits {
-      typedef ScalarLocalToGlobalBasisAdaptor<typename LocalFiniteElement::
+      typedef BasisAdaptor<typename LocalFiniteElement::
           Traits::LocalBasisType, Geometry> Basis;
       typedef LocalToGlobalInterpolationAdaptor<typename LocalFiniteElement::
           Traits::LocalInterpolationType, typename Basis::Traits>
@@ -237,16 +325,19 @@ namespace Dune {
    *
    * \tparam LocalFiniteElement Type of the local finite element to adapt.
    * \tparam Geometry           Type of the local-to-global transformation.
+   * \tparam BasisAdaptor       Template of the basis adaptor, see
+   *                            ScalarLocalToGlobalFiniteElementAdaptor.
    *
    * \implements FiniteElementFactoryInterface
    */
-  template<class LocalFiniteElement, class Geometry>
+  template<class LocalFiniteElement, class Geometry,
+           template<class, class> class BasisAdaptor = ScalarLocalToGlobalBasisAdaptor>
   class ScalarLocalToGlobalFiniteElementAdaptorFactory {
     const LocalFiniteElement& localFE;
 
   public:
     typedef ScalarLocalToGlobalFiniteElementAdaptor<LocalFiniteElement,
-        Geometry> FiniteElement;
+        Geometry, BasisAdaptor> FiniteElement;
 
     //! construct a ScalarLocalToGlobalFiniteElementAdaptorFactory
     /**
@@ -276,6 +367,362 @@ namespace Dune {
     }
   };
 
+  namespace Impl {
+
+    //! Matrices of the Piola transformation of a geometry at a local point
+    /**
+     * For the contravariant transformation the values are pushed forward by
+     * \f$J/\det J\f$ and pulled back by \f$\det J\,J^{+}\f$, for the covariant
+     * transformation by \f$J^{+T}\f$ and \f$J^T\f$, respectively.  Here
+     * \f$J\f$ is the Jacobian of the geometry, \f$J^{+}\f$ its (pseudo)
+     * inverse and \f$\det J\f$ the integration element.
+     */
+    template<class Geometry, bool contravariant>
+    struct PiolaTransformation
+    {
+      typedef typename Geometry::ctype ctype;
+      static const int mydim = Geometry::mydimension;
+      static const int coorddim = Geometry::coorddimension;
+
+      PiolaTransformation() = default;
+
+      PiolaTransformation(const Geometry& geometry,
+                          const FieldVector<ctype, mydim>& x)
+      {
+        const FieldMatrix<ctype, mydim, coorddim> jacobianTransposed
+          = geometry.jacobianTransposed(x);
+        jacobianInverseTransposed = geometry.jacobianInverseTransposed(x);
+        if constexpr (contravariant) {
+          const ctype integrationElement = geometry.integrationElement(x);
+          for(int i = 0; i < coorddim; ++i)
+            for(int j = 0; j < mydim; ++j) {
+              pushForward[i][j] = jacobianTransposed[j][i] / integrationElement;
+              pullBack[j][i] = jacobianInverseTransposed[i][j] * integrationElement;
+            }
+        }
+        else {
+          pushForward = jacobianInverseTransposed;
+          pullBack = jacobianTransposed;
+        }
+      }
+
+      //! maps local values to global values
+      FieldMatrix<ctype, coorddim, mydim> pushForward;
+      //! maps global values to local values
+      FieldMatrix<ctype, mydim, coorddim> pullBack;
+      //! maps local gradients to global gradients
+      FieldMatrix<ctype, coorddim, mydim> jacobianInverseTransposed;
+    };
+
+    //! Traits class for Piola-transformed local-to-global basis adaptors
+    /**
+     * In contrast to LocalToGlobalBasisAdaptorTraits the range has the
+     * dimension of the global coordinates.
+     *
+     * \implements BasisInterface::Traits
+     */
+    template<class LocalBasisTraits, std::size_t dimDomainGlobal_>
+    struct PiolaLocalToGlobalBasisAdaptorTraits {
+      typedef typename LocalBasisTraits::DomainFieldType DomainField;
+      static const std::size_t dimDomainLocal = LocalBasisTraits::dimDomain;
+      static const std::size_t dimDomainGlobal = dimDomainGlobal_;
+      typedef typename LocalBasisTraits::DomainType DomainLocal;
+      typedef FieldVector<DomainField, dimDomainGlobal> DomainGlobal;
+
+      typedef typename LocalBasisTraits::RangeFieldType RangeField;
+      static const std::size_t dimRange = dimDomainGlobal;
+      typedef FieldVector<RangeField, dimRange> Range;
+
+      typedef FieldMatrix<RangeField, dimRange, dimDomainGlobal> Jacobian;
+    };
+
+    //! Convert a vector-valued local basis into a global basis by a Piola transformation
+    /**
+     * The values of all shape functions at a point are transformed at once
+     * by the matrices of PiolaTransformation, i.e. \f$\phi_i = P\hat\phi_i\f$
+     * and \f$\nabla\phi_i = P\hat\nabla\hat\phi_i\hat J_\mu^{+}\f$, where P
+     * is the push forward.  For affine geometries the transformation is
+     * computed once in the constructor.  For non-affine geometries the
+     * derivatives of the geometry Jacobian are neglected in the Jacobians of
+     * the shape functions.
+     *
+     * \note The scratch storage for the local values is reused between calls,
+     *       hence an object of this class must not be used concurrently from
+     *       several threads.
+     *
+     * \tparam LocalBasis    Type of the local basis to adapt.
+     * \tparam Geometry      Type of the local-to-global transformation.
+     * \tparam contravariant Whether to use the contravariant (H(div)) or the
+     *                       covariant (H(curl)) Piola transformation.
+     *
+     * \implements BasisInterface
+     */
+    template<class LocalBasis, class Geometry, bool contravariant>
+    class PiolaLocalToGlobalBasisAdaptor {
+      static_assert((std::is_same<typename LocalBasis::Traits::DomainFieldType,
+                             typename Geometry::ctype>::value),
+                     "PiolaLocalToGlobalBasisAdaptor: LocalBasis must use "
+                     "the same ctype as Geometry");
+      static_assert
+        ( static_cast<std::size_t>(LocalBasis::Traits::dimDomain) ==
+        static_cast<std::size_t>(Geometry::mydimension),
+        "PiolaLocalToGlobalBasisAdaptor: LocalBasis domain dimension must "
+        "match local dimension of Geometry");
+      static_assert
+        ( static_cast<std::size_t>(LocalBasis::Traits::dimRange) ==
+        static_cast<std::size_t>(Geometry::mydimension),
+        "PiolaLocalToGlobalBasisAdaptor: LocalBasis range dimension must "
+        "match local dimension of Geometry");
+
+      typedef PiolaTransformation<Geometry, contravariant> Transformation;
+
+      static const std::size_t mydim = Geometry::mydimension;
+      static const std::size_t coorddim = Geometry::coorddimension;
+
+      const LocalBasis& localBasis;
+      Geometry geometry;
+      // computed once for affine geometries, scratch storage otherwise
+      mutable Transformation transformation_;
+      mutable std::vector<typename LocalBasis::Traits::RangeType> localValues;
+      mutable std::vector<typename LocalBasis::Traits::JacobianType> localJacobians;
+
+    public:
+      typedef PiolaLocalToGlobalBasisAdaptorTraits<typename LocalBasis::Traits,
+          Geometry::coorddimension> Traits;
+
+      //! construct a PiolaLocalToGlobalBasisAdaptor
+      /**
+       * \param localBasis_ The local basis object to adapt.
+       * \param geometry_   The geometry object to use for adaption.
+       *
+       * \note This class stores the reference to the local basis passed
+       *       here.  Any use of this class after this reference has become
+       *       invalid results in undefined behaviour.  The exception is that
+       *       the destructor of this class may still be called.
+       */
+      PiolaLocalToGlobalBasisAdaptor(const LocalBasis& localBasis_,
+                                     const Geometry& geometry_) :
+        localBasis(localBasis_), geometry(geometry_)
+      {
+        // the Jacobian of an affine geometry may be evaluated anywhere, the
+        // origin is a corner of all reference elements
+        if(geometry.affine())
+          transformation_ = Transformation(geometry, typename Traits::DomainLocal(0));
+      }
+
+      std::size_t size() const { return localBasis.size(); }
+
+      //! return maximum polynomial order of the base function
+      /**
+       * See ScalarLocalToGlobalBasisAdaptor::order().
+       */
+      std::size_t order() const {
+        if(geometry.affine())
+          return localBasis.order();
+        else
+          return localBasis.order() + Traits::dimDomainGlobal - 1;
+      }
+
+      void evaluateFunction(const typename Traits::DomainLocal& in,
+                            std::vector<typename Traits::Range>& out) const
+      {
+        localBasis.evaluateFunction(in, localValues);
+        const Transformation& t = transformation(in);
+
+        out.resize(size());
+        for(std::size_t i = 0; i < size(); ++i)
+          for(std::size_t r = 0; r < coorddim; ++r) {
+            typename Traits::RangeField y = 0;
+            for(std::size_t j = 0; j < mydim; ++j)
+              y += t.pushForward[r][j] * localValues[i][j];
+            out[i][r] = y;
+          }
+      }
+
+      void evaluateJacobian(const typename Traits::DomainLocal& in,
+                            std::vector<typename Traits::Jacobian>& out) const
+      {
+        localBasis.evaluateJacobian(in, localJacobians);
+        const Transformation& t = transformation(in);
+
+        out.resize(size());
+        FieldMatrix<typename Traits::RangeField, mydim, coorddim> tmp;
+        for(std::size_t i = 0; i < size(); ++i) {
+          // transform the derivatives, then the values
+          for(std::size_t j = 0; j < mydim; ++j)
+            for(std::size_t k = 0; k < coorddim; ++k) {
+              typename Traits::RangeField y = 0;
+              for(std::size_t l = 0; l < mydim; ++l)
+                y += localJacobians[i][j][l] * t.jacobianInverseTransposed[k][l];
+              tmp[j][k] = y;
+            }
+          for(std::size_t r = 0; r < coorddim; ++r)
+            for(std::size_t k = 0; k < coorddim; ++k) {
+              typename Traits::RangeField y = 0;
+              for(std::size_t j = 0; j < mydim; ++j)
+                y += t.pushForward[r][j] * tmp[j][k];
+              out[i][r][k] = y;
+            }
+        }
+      }
+
+    private:
+      const Transformation& transformation(const typename Traits::DomainLocal& in) const
+      {
+        if(!geometry.affine())
+          transformation_ = Transformation(geometry, in);
+        return transformation_;
+      }
+    };
+
+    //! Convert a local interpolation of a Piola-transformed element into a global interpolation
+    /**
+     * The global function is pulled back to the reference element before it
+     * is passed to the local interpolation.  For affine geometries the
+     * transformation is computed once in the constructor.
+     *
+     * \tparam LocalInterpolation Type of the local interpolation to adapt.
+     * \tparam Geometry           Type of the local-to-global transformation.
+     * \tparam contravariant      Whether to use the contravariant or the
+     *                            covariant Piola transformation.
+     * \tparam Traits_            Traits of the corresponding basis class.
+     *
+     * \implements InterpolationInterface
+     */
+    template<class LocalInterpolation, class Geometry, bool contravariant, class Traits_>
+    class PiolaLocalToGlobalInterpolationAdaptor {
+      typedef PiolaTransformation<Geometry, contravariant> Transformation;
+
+      const LocalInterpolation& localInterpolation;
+      Geometry geometry;
+      // only computed for affine geometries
+      Transformation affineTransformation;
+
+    public:
+      typedef Traits_ Traits;
+
+      //! construct a PiolaLocalToGlobalInterpolationAdaptor
+      /**
+       * \note This class stores the reference to the local interpolation
+       *       object passed here.  Any use of this class after the reference
+       *       has become invalid results in undefined behaviour.
+       */
+      PiolaLocalToGlobalInterpolationAdaptor
+        ( const LocalInterpolation& localInterpolation_, const Geometry& geometry_) :
+        localInterpolation(localInterpolation_), geometry(geometry_)
+      {
+        if(geometry.affine())
+          affineTransformation = Transformation(geometry, typename Traits::DomainLocal(0));
+      }
+
+      template<class Function, class Coeff>
+      void interpolate(const Function& function, std::vector<Coeff>& out) const
+      {
+        typedef FieldVector<typename Traits::RangeField, Traits::dimDomainLocal> LocalRange;
+        const bool affine = geometry.affine();
+        auto localFunction = [&](const typename Traits::DomainLocal& x) {
+          const typename Traits::Range y = function(x);
+          LocalRange localY;
+          if(affine)
+            affineTransformation.pullBack.mv(y, localY);
+          else
+            Transformation(geometry, x).pullBack.mv(y, localY);
+          return localY;
+        };
+        localInterpolation.interpolate(localFunction, out);
+      }
+    };
+
+    //! Convert a vector-valued local finite element into a global finite element by a Piola transformation
+    /**
+     * \tparam LocalFiniteElement Type of the local finite element to adapt.
+     * \tparam Geometry           Type of the local-to-global transformation.
+     * \tparam contravariant      Whether to use the contravariant or the
+     *                            covariant Piola transformation.
+     *
+     * \implements FiniteElementInterface
+     */
+    template<class LocalFiniteElement, class Geometry, bool contravariant>
+    struct PiolaLocalToGlobalFiniteElementAdaptor {
+      /**
+       * \implements FiniteElementInterface::Traits
+       */
+      struct Traits {
+        typedef PiolaLocalToGlobalBasisAdaptor<typename LocalFiniteElement::
+            Traits::LocalBasisType, Geometry, contravariant> Basis;
+        typedef PiolaLocalToGlobalInterpolationAdaptor<typename LocalFiniteElement::
+            Traits::LocalInterpolationType, Geometry, contravariant,
+            typename Basis::Traits> Interpolation;
+        typedef typename LocalFiniteElement::Traits::LocalCoefficientsType
+        Coefficients;
+      };
+
+    private:
+      const LocalFiniteElement &localFE;
+      typename Traits::Basis basis_;
+      typename Traits::Interpolation interpolation_;
+
+    public:
+      //! construct a PiolaLocalToGlobalFiniteElementAdaptor
+      /**
+       * \param localFE_  The local finite element object to adapt.
+       * \param geometry  The geometry object to use for adaption.
+       *
+       * \note This class stores the reference to the local finite element
+       *       passed here.  Any use of this class after this reference has
+       *       become invalid results in undefined behaviour.
+       */
+      PiolaLocalToGlobalFiniteElementAdaptor
+        ( const LocalFiniteElement& localFE_, const Geometry &geometry) :
+        localFE(localFE_),
+        basis_(localFE.localBasis(), geometry),
+        interpolation_(localFE.localInterpolation(), geometry)
+      { }
+
+      const typename Traits::Basis& basis() const { return basis_; }
+      const typename Traits::Interpolation& interpolation() const
+      { return interpolation_; }
+      const typename Traits::Coefficients& coefficients() const
+      { return localFE.localCoefficients(); }
+      GeometryType type() const { return localFE.type(); }
+    };
+
+  } // namespace Impl
+
+  //! Convert an H(div) local basis into a global basis by the contravariant Piola transformation
+  /**
+   * The values are transformed by \f$\phi = \hat J_\mu\hat\phi/\det\hat J_\mu\f$,
+   * see Impl::PiolaLocalToGlobalBasisAdaptor.
+   *
+   * \tparam LocalBasis Type of the local basis to adapt.
+   * \tparam Geometry   Type of the local-to-global transformation.
+   */
+  template<class LocalBasis, class Geometry>
+  using ContravariantPiolaLocalToGlobalBasisAdaptor
+    = Impl::PiolaLocalToGlobalBasisAdaptor<LocalBasis, Geometry, true>;
+
+  //! Convert an H(curl) local basis into a global basis by the covariant Piola transformation
+  /**
+   * The values are transformed by \f$\phi = \hat J_\mu^{-T}\hat\phi\f$,
+   * see Impl::PiolaLocalToGlobalBasisAdaptor.
+   *
+   * \tparam LocalBasis Type of the local basis to adapt.
+   * \tparam Geometry   Type of the local-to-global transformation.
+   */
+  template<class LocalBasis, class Geometry>
+  using CovariantPiolaLocalToGlobalBasisAdaptor
+    = Impl::PiolaLocalToGlobalBasisAdaptor<LocalBasis, Geometry, false>;
+
+  //! Convert an H(div) local finite element into a global finite element
+  template<class LocalFiniteElement, class Geometry>
+  using ContravariantPiolaLocalToGlobalFiniteElementAdaptor
+    = Impl::PiolaLocalToGlobalFiniteElementAdaptor<LocalFiniteElement, Geometry, true>;
+
+  //! Convert an H(curl) local finite element into a global finite element
+  template<class LocalFiniteElement, class Geometry>
+  using CovariantPiolaLocalToGlobalFiniteElementAdaptor
+    = Impl::PiolaLocalToGlobalFiniteElementAdaptor<LocalFiniteElement, Geometry, false>;
+
 } // namespace Dune
 
 #endif // DUNE_LOCALFUNCTIONS_COMMON_LOCALTOGLOBALADAPTORS_HH
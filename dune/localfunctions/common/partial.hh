@@ -0,0 +1,60 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_COMMON_PARTIAL_HH
+#define DUNE_LOCALFUNCTIONS_COMMON_PARTIAL_HH
+
+#include <array>
+#include <vector>
+
+#include <dune/common/typeutilities.hh>
+
+namespace Dune
+{
+
+  namespace Impl
+  {
+
+    // Use the method of the local basis with a static multi-index if it provides one
+    template<unsigned int... orders, class LocalBasis, class Out>
+    auto partial (const LocalBasis& localBasis, const typename LocalBasis::Traits::DomainType& x, Out& out, PriorityTag<1>)
+      -> decltype(localBasis.template partial<orders...>(x, out))
+    {
+      return localBasis.template partial<orders...>(x, out);
+    }
+
+    template<unsigned int... orders, class LocalBasis, class Out>
+    void partial (const LocalBasis& localBasis, const typename LocalBasis::Traits::DomainType& x, Out& out, PriorityTag<0>)
+    {
+      localBasis.partial(std::array<unsigned int,sizeof...(orders)>{orders...}, x, out);
+    }
+
+  } // namespace Impl
+
+
+  /** \brief Evaluate the partial derivatives of all shape functions given by a static multi-index
+   *
+   * Calls the method localBasis.partial<orders...>(x, out) if the local basis
+   * provides one, e.g. LagrangeSimplexLocalBasis and LagrangeCubeLocalBasis,
+   * which resolve the derivative at compile time. For all other local bases
+   * the method partial(order, x, out) with the dynamic multi-index is called.
+   *
+   * \tparam orders Order of the partial derivatives, in the classic multi-index notation
+   * \param localBasis The local basis
+   * \param x Position where to evaluate the derivatives
+   * \param[out] out The desired partial derivatives of all shape functions
+   */
+  template<unsigned int... orders, class LocalBasis>
+  void partial (const LocalBasis& localBasis,
+                const typename LocalBasis::Traits::DomainType& x,
+                std::vector<typename LocalBasis::Traits::RangeType>& out)
+  {
+    static_assert(sizeof...(orders) == LocalBasis::Traits::dimDomain,
+                  "The multi-index of the partial derivative needs one entry per direction");
+    Impl::partial<orders...>(localBasis, x, out, PriorityTag<1>());
+  }
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_COMMON_PARTIAL_HH
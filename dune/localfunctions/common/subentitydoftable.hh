@@ -0,0 +1,190 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_COMMON_SUBENTITYDOFTABLE_HH
+#define DUNE_LOCALFUNCTIONS_COMMON_SUBENTITYDOFTABLE_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/typeutilities.hh>
+
+namespace Dune
+{
+
+  /** \brief The local indices of the degrees of freedom associated to each subentity
+   *
+   * The table inverts the map i -> localKey(i) of some local coefficients:
+   * For each pair (subEntity, codim) it stores the local indices of the
+   * degrees of freedom associated to this subentity, ordered by
+   * LocalKey::index(). All queries take constant time, hence global
+   * mappers can look up the degrees of freedom of a subentity without
+   * iterating over all local keys of the element.
+   *
+   * The table only depends on the local coefficients. Coefficients of
+   * fixed elements like LagrangeCubeLocalCoefficients or the Raviart-Thomas
+   * and Nedelec coefficients of fixed order provide a shared table by a
+   * method subEntityDofTable(), for all others it can be obtained by
+   * subEntityDofTable(const LocalCoefficients&).
+   */
+  class SubEntityDofTable
+  {
+  public:
+    SubEntityDofTable () = default;
+
+    //! Create the table for the given local coefficients
+    template<class LocalCoefficients>
+    explicit SubEntityDofTable (const LocalCoefficients& localCoefficients)
+    {
+      const std::size_t n = localCoefficients.size();
+
+      // The number of subentities of each codimension that carry degrees of freedom
+      std::vector<std::size_t> subEntities;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        const auto& key = localCoefficients.localKey(i);
+        if (key.codim() >= subEntities.size())
+          subEntities.resize(key.codim()+1, 0);
+        subEntities[key.codim()] = std::max<std::size_t>(subEntities[key.codim()], key.subEntity()+1);
+      }
+
+      codimOffsets_.assign(subEntities.size()+1, 0);
+      for (std::size_t c = 0; c < subEntities.size(); ++c)
+        codimOffsets_[c+1] = codimOffsets_[c] + subEntities[c];
+
+      // Count the degrees of freedom per subentity and sort them by (codim, subEntity)
+      offsets_.assign(codimOffsets_.back()+1, 0);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        const auto& key = localCoefficients.localKey(i);
+        ++offsets_[codimOffsets_[key.codim()] + key.subEntity() + 1];
+      }
+      for (std::size_t e = 0; e+1 < offsets_.size(); ++e)
+        offsets_[e+1] += offsets_[e];
+
+      indices_.resize(n);
+      std::vector<std::size_t> position(offsets_.begin(), offsets_.end()-1);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        const auto& key = localCoefficients.localKey(i);
+        indices_[position[codimOffsets_[key.codim()] + key.subEntity()]++] = i;
+      }
+
+      // Order the degrees of freedom of each subentity by LocalKey::index()
+      contiguous_.assign(offsets_.size()-1, true);
+      for (std::size_t e = 0; e+1 < offsets_.size(); ++e)
+      {
+        std::stable_sort(indices_.begin() + offsets_[e], indices_.begin() + offsets_[e+1],
+                         [&](std::size_t i, std::size_t j) {
+                           return localCoefficients.localKey(i).index() < localCoefficients.localKey(j).index();
+                         });
+        for (std::size_t l = offsets_[e]; l < offsets_[e+1]; ++l)
+          contiguous_[e] = contiguous_[e] and (indices_[l] == indices_[offsets_[e]] + (l - offsets_[e]));
+      }
+    }
+
+    //! Total number of degrees of freedom
+    std::size_t size () const
+    {
+      return indices_.size();
+    }
+
+    //! Number of degrees of freedom associated to subentities of the given codimension
+    std::size_t size (unsigned int codim) const
+    {
+      if (codim+1 >= codimOffsets_.size())
+        return 0;
+      return offsets_[codimOffsets_[codim+1]] - offsets_[codimOffsets_[codim]];
+    }
+
+    //! Number of degrees of freedom associated to the given subentity
+    std::size_t size (unsigned int subEntity, unsigned int codim) const
+    {
+      if (not contains(subEntity, codim))
+        return 0;
+      const std::size_t e = codimOffsets_[codim] + subEntity;
+      return offsets_[e+1] - offsets_[e];
+    }
+
+    //! The local index of the degree of freedom with the LocalKey (subEntity, codim, i)
+    std::size_t index (unsigned int subEntity, unsigned int codim, unsigned int i) const
+    {
+      assert(i < size(subEntity, codim));
+      return indices_[offsets_[codimOffsets_[codim] + subEntity] + i];
+    }
+
+    /** \brief Whether the local indices of the degrees of freedom of the subentity are consecutive
+     *
+     * Then index(subEntity, codim, i) is index(subEntity, codim, 0) + i.
+     */
+    bool isContiguous (unsigned int subEntity, unsigned int codim) const
+    {
+      return not contains(subEntity, codim) or contiguous_[codimOffsets_[codim] + subEntity];
+    }
+
+  private:
+    bool contains (unsigned int subEntity, unsigned int codim) const
+    {
+      return (codim+1 < codimOffsets_.size()) and (codimOffsets_[codim] + subEntity < codimOffsets_[codim+1]);
+    }
+
+    // Position of the first subentity of each codimension in offsets_
+    std::vector<std::size_t> codimOffsets_;
+    // Position of the first degree of freedom of each subentity in indices_
+    std::vector<std::size_t> offsets_;
+    std::vector<std::size_t> indices_;
+    std::vector<bool> contiguous_;
+  };
+
+
+  namespace Impl
+  {
+
+    // Use the shared table of the local coefficients if they provide one
+    template<class LocalCoefficients>
+    auto subEntityDofTable (const LocalCoefficients& localCoefficients, PriorityTag<2>)
+      -> decltype(localCoefficients.subEntityDofTable())
+    {
+      return localCoefficients.subEntityDofTable();
+    }
+
+    // Coefficients without any state all have the same local keys, share one table per type
+    template<class LocalCoefficients,
+             std::enable_if_t<std::is_empty_v<LocalCoefficients> and std::is_default_constructible_v<LocalCoefficients>, int> = 0>
+    const SubEntityDofTable& subEntityDofTable (const LocalCoefficients& localCoefficients, PriorityTag<1>)
+    {
+      static const SubEntityDofTable table(localCoefficients);
+      return table;
+    }
+
+    template<class LocalCoefficients>
+    SubEntityDofTable subEntityDofTable (const LocalCoefficients& localCoefficients, PriorityTag<0>)
+    {
+      return SubEntityDofTable(localCoefficients);
+    }
+
+  } // namespace Impl
+
+
+  /** \brief The table of the degrees of freedom associated to each subentity
+   *
+   * Returns a reference to a shared table if the local coefficients provide
+   * a method subEntityDofTable() or if their type is empty, i.e. all
+   * instances have the same local keys. Otherwise a new SubEntityDofTable
+   * is created, which costs O(size()) operations and allocations per call,
+   * hence the result should be stored where it is used repeatedly. Bind the
+   * result to a const reference to cover all cases.
+   */
+  template<class LocalCoefficients>
+  decltype(auto) subEntityDofTable (const LocalCoefficients& localCoefficients)
+  {
+    return Impl::subEntityDofTable(localCoefficients, PriorityTag<2>());
+  }
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_COMMON_SUBENTITYDOFTABLE_HH
@@ -6,6 +6,8 @@
     \brief Convenience header that includes all available hierarchical LocalFiniteElements
  */
 
+#include <dune/localfunctions/hierarchical/hierarchicalcube.hh>
 #include <dune/localfunctions/hierarchical/hierarchicalp2.hh>
 #include <dune/localfunctions/hierarchical/hierarchicalp2withelementbubble.hh>
 #include <dune/localfunctions/hierarchical/hierarchicalprismp2.hh>
+#include <dune/localfunctions/hierarchical/hierarchicalsimplex.hh>
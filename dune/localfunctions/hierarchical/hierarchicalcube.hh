@@ -0,0 +1,560 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_HIERARCHICAL_HIERARCHICALCUBE_HH
+#define DUNE_LOCALFUNCTIONS_HIERARCHICAL_HIERARCHICALCUBE_HH
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/hierarchical/integratedlegendre.hh>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief Orientation of the hierarchical cube shape functions with respect to a vertex numbering
+   *
+   * Each shape function is the tensor product of univariate factors \f$\phi_{i_j}(x_j)\f$.
+   * Directions with \f$i_j\geq 2\f$ are free directions of the associated subentity.
+   * To obtain globally consistent shape functions on a shared subentity, its canonical
+   * frame is determined from the vertex numbering: the origin is the vertex with the smallest
+   * number and the free directions are ordered by the number of the neighbor of the origin.
+   * Reflecting a direction changes the sign of odd univariate factors.
+   */
+  template<unsigned int dim, unsigned int k>
+  struct HierarchicalCubeOrientation
+  {
+    using MultiIndex = std::array<unsigned int,dim>;
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return power(k+1, dim);
+    }
+
+    //! \brief Polynomial degree of the univariate factor with index i
+    static constexpr unsigned int degree (const MultiIndex& i)
+    {
+      unsigned int result = 1;
+      for (auto i_j : i)
+        result = std::max(result, i_j);
+      return result;
+    }
+
+    /** \brief Enumerate the multi-indices of all shape functions in hierarchical order
+     *
+     * The multi-indices are sorted by their degree and lexicographically
+     * with the first direction running fastest otherwise. Hence the first
+     * \f$(p+1)^{dim}\f$ entries span the space \f$Q_p\f$.
+     */
+    static constexpr auto multiIndices ()
+    {
+      auto result = std::array<MultiIndex,size()>{};
+      std::size_t n = 0;
+      for (unsigned int p=1; p<=k; ++p)
+      {
+        auto i = MultiIndex{};
+        for (auto l : Dune::range(power(p+1, dim)))
+        {
+          auto rest = l;
+          for (auto j : Dune::range(dim))
+          {
+            i[j] = rest % (p+1);
+            rest /= (p+1);
+          }
+          if (degree(i) == p)
+            result[n++] = i;
+        }
+      }
+      return result;
+    }
+
+    //! \brief Sign and LocalKey of the shape function with the given multi-index
+    template<class VertexMap>
+    static auto frame (const MultiIndex& i, const VertexMap& vertexMap)
+    {
+      // Fixed directions determine the vertices of the subentity
+      unsigned int fixedMask = 0;
+      unsigned int fixedBits = 0;
+      std::vector<unsigned int> freeDirections;
+      for (auto j : Dune::range(dim))
+      {
+        if (i[j] >= 2)
+          freeDirections.push_back(j);
+        else
+        {
+          fixedMask |= (1u << j);
+          fixedBits |= (i[j] << j);
+        }
+      }
+      const unsigned int codim = dim - freeDirections.size();
+
+      std::vector<unsigned int> vertices;
+      for (auto v : Dune::range(1u << dim))
+        if ((v & fixedMask) == fixedBits)
+          vertices.push_back(v);
+
+      if (codim == dim)
+        return std::pair(1, LocalKey(vertices[0], dim, 0));
+
+      const auto origin = *std::min_element(vertices.begin(), vertices.end(), [&](auto a, auto b) {
+        return vertexMap[a] < vertexMap[b];
+      });
+
+      int sign = 1;
+      for (auto j : freeDirections)
+        if (((origin >> j) & 1) and (i[j] % 2))
+          sign = -sign;
+
+      // Canonical multi-index in the frame of the subentity
+      std::sort(freeDirections.begin(), freeDirections.end(), [&](auto a, auto b) {
+        return vertexMap[origin ^ (1u << a)] < vertexMap[origin ^ (1u << b)];
+      });
+      std::vector<unsigned int> a;
+      for (auto j : freeDirections)
+        a.push_back(i[j]);
+
+      // Hierarchical index: all canonical multi-indices of lower degree come first,
+      // the ones of the same degree are ordered lexicographically.
+      const unsigned int m = a.size();
+      const unsigned int p = *std::max_element(a.begin(), a.end());
+      unsigned int index = power(p-2, m);
+      auto b = std::vector<unsigned int>(m, 2);
+      while (b != a)
+      {
+        if (*std::max_element(b.begin(), b.end()) == p)
+          ++index;
+        unsigned int r = 0;
+        while (b[r] == p)
+          b[r++] = 2;
+        ++b[r];
+      }
+
+      // Find the subentity with the given vertices
+      const auto& refElement = ReferenceElements<double,dim>::cube();
+      for (auto e : Dune::range(refElement.size(codim)))
+      {
+        auto subVertices = std::vector<unsigned int>();
+        for (auto l : Dune::range(refElement.size(e, codim, dim)))
+          subVertices.push_back(refElement.subEntity(e, codim, l, dim));
+        std::sort(subVertices.begin(), subVertices.end());
+        if (subVertices == vertices)
+          return std::pair(sign, LocalKey(e, codim, index));
+      }
+      DUNE_THROW(Exception, "Subentity of hierarchical cube shape function not found");
+    }
+
+    //! \brief The identity vertex map
+    static auto identity ()
+    {
+      std::array<unsigned int,(1u << dim)> vertexMap;
+      std::iota(vertexMap.begin(), vertexMap.end(), 0);
+      return vertexMap;
+    }
+  };
+
+  /** \brief Hierarchical shape functions of arbitrary order on the reference cube
+
+     The shape functions are tensor products \f$\prod_j \phi_{i_j}(x_j)\f$ of the
+     univariate functions \f$\phi_0(x)=1-x\f$, \f$\phi_1(x)=x\f$ and the integrated
+     Legendre polynomials \f$\phi_i(x)=\int_{-1}^{2x-1}P_{i-1}(s)\,ds\f$ for \f$i\geq 2\f$.
+     The shape functions are enumerated by increasing degree such that the basis
+     of order p is a prefix of the basis of order k>p.
+
+     \tparam D Type to represent the field in the domain
+     \tparam R Type to represent the field in the range
+     \tparam dim Dimension of the domain cube
+     \tparam k Polynomial order
+   */
+  template<class D, class R, unsigned int dim, unsigned int k>
+  class HierarchicalCubeLocalBasis
+  {
+    using Orientation = HierarchicalCubeOrientation<dim,k>;
+
+    static constexpr auto multiIndices_ = Orientation::multiIndices();
+
+    // Evaluate all univariate functions and their derivatives up to the given order
+    template<unsigned int maxDerivative>
+    static auto evaluate1d (const typename LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >::DomainType& x)
+    {
+      auto tables = std::array<std::array<std::array<R,k+1>,maxDerivative+1>,dim>{};
+      for (auto j : Dune::range(dim))
+        evaluateIntegratedLegendre1d(k, R(x[j]), maxDerivative, tables[j]);
+      return tables;
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    //! \brief Default constructor using the identity vertex numbering
+    HierarchicalCubeLocalBasis ()
+      : HierarchicalCubeLocalBasis(Orientation::identity())
+    {}
+
+    /** \brief Construct the basis for a given vertex numbering
+     *
+     * The signs of odd univariate factors are chosen such that the shape
+     * functions on shared subentities coincide for all elements using the
+     * same global vertex numbering.
+     */
+    template<class VertexMap>
+    explicit HierarchicalCubeLocalBasis (const VertexMap& vertexMap)
+    {
+      for (auto n : Dune::range(size()))
+        sign_[n] = Orientation::frame(multiIndices_[n], vertexMap).first;
+    }
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return Orientation::size();
+    }
+
+    //! \brief Number of shape functions of order at most p
+    static constexpr unsigned int size (unsigned int p)
+    {
+      return power(p+1, dim);
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+      const auto tables = evaluate1d<0>(x);
+      for (auto n : Dune::range(size()))
+      {
+        R y = sign_[n];
+        for (auto j : Dune::range(dim))
+          y *= tables[j][0][multiIndices_[n][j]];
+        out[n] = y;
+      }
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions
+     *
+     * \param x Point in the reference cube where to evaluation the Jacobians
+     * \param[out] out The Jacobians of all shape functions at the point x
+     */
+    void evaluateJacobian(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+      const auto tables = evaluate1d<1>(x);
+      for (auto n : Dune::range(size()))
+      {
+        const auto& i = multiIndices_[n];
+        for (auto l : Dune::range(dim))
+        {
+          R y = sign_[n];
+          for (auto j : Dune::range(dim))
+            y *= tables[j][j==l][i[j]];
+          out[n][0][l] = y;
+        }
+      }
+    }
+
+    /** \brief Evaluate partial derivatives of any order of all shape functions
+     *
+     * \param order Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    void partial(const std::array<unsigned int,dim>& order,
+                 const typename Traits::DomainType& in,
+                 std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+
+      // Derivatives of order >k in any direction vanish
+      if (std::any_of(order.begin(), order.end(), [](auto o) { return o > k; }))
+      {
+        std::fill(out.begin(), out.end(), 0);
+        return;
+      }
+
+      auto tables = std::array<std::array<std::array<R,k+1>,k+1>,dim>{};
+      for (auto j : Dune::range(dim))
+        evaluateIntegratedLegendre1d(k, R(in[j]), order[j], tables[j]);
+
+      for (auto n : Dune::range(size()))
+      {
+        R y = sign_[n];
+        for (auto j : Dune::range(dim))
+          y *= tables[j][order[j]][multiIndices_[n][j]];
+        out[n] = y;
+      }
+    }
+
+    //! \brief Polynomial order of the shape functions
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+
+    //! \brief Sign of the i-th shape function relative to the reference orientation
+    R sign (std::size_t i) const
+    {
+      return sign_[i];
+    }
+
+  private:
+    std::array<R,size()> sign_;
+  };
+
+  /** \brief Associations of the hierarchical degrees of freedom to subentities of the reference cube
+   *
+   * The degrees of freedom of a subentity are enumerated by increasing degree
+   * such that the local keys of the basis of order p are preserved by the basis of order k>p.
+   *
+   * \tparam dim Dimension of the reference cube
+   * \tparam k Polynomial order
+   */
+  template<unsigned int dim, unsigned int k>
+  class HierarchicalCubeLocalCoefficients
+  {
+    using Orientation = HierarchicalCubeOrientation<dim,k>;
+
+  public:
+    //! \brief Default constructor using the identity vertex numbering
+    HierarchicalCubeLocalCoefficients ()
+      : HierarchicalCubeLocalCoefficients(Orientation::identity())
+    {}
+
+    //! \brief Construct the local keys for a given vertex numbering
+    template<class VertexMap>
+    explicit HierarchicalCubeLocalCoefficients (const VertexMap& vertexMap)
+      : localKeys_(size())
+    {
+      constexpr auto multiIndices = Orientation::multiIndices();
+      for (auto n : Dune::range(size()))
+        localKeys_[n] = Orientation::frame(multiIndices[n], vertexMap).second;
+    }
+
+    //! number of coefficients
+    static constexpr std::size_t size ()
+    {
+      return Orientation::size();
+    }
+
+    //! get i'th index
+    const LocalKey& localKey (std::size_t i) const
+    {
+      return localKeys_[i];
+    }
+
+  private:
+    std::vector<LocalKey> localKeys_;
+  };
+
+  /** \brief Interpolation into the hierarchical basis on the reference cube
+   *
+   * The function is evaluated at the equidistant Lagrange nodes of order k and
+   * the coefficients are obtained by applying the inverse of the univariate
+   * Vandermonde matrix in each direction. Since the restriction of the basis to
+   * a subentity only depends on the nodes on the closure of this subentity,
+   * the interpolation is conforming.
+   *
+   * \tparam LocalBasis The corresponding set of shape functions
+   */
+  template<class LocalBasis>
+  class HierarchicalCubeLocalInterpolation
+  {
+    static constexpr auto dim = LocalBasis::Traits::dimDomain;
+    static constexpr auto k = LocalBasis::order();
+    using D = typename LocalBasis::Traits::DomainFieldType;
+    using R = typename LocalBasis::Traits::RangeFieldType;
+    using Orientation = HierarchicalCubeOrientation<dim,k>;
+
+    static const DynamicMatrix<R>& inverseVandermonde1d ()
+    {
+      static const DynamicMatrix<R> matrix = [] {
+        auto V = DynamicMatrix<R>(k+1, k+1, 0);
+        for (auto m : Dune::range(k+1))
+        {
+          auto table = std::array<std::array<R,k+1>,1>{};
+          evaluateIntegratedLegendre1d(k, R(m)/k, 0, table);
+          for (auto i : Dune::range(k+1))
+            V[m][i] = table[0][i];
+        }
+        V.invert();
+        return V;
+      }();
+      return matrix;
+    }
+
+  public:
+
+    //! \brief Construct the interpolation for the given basis
+    explicit HierarchicalCubeLocalInterpolation (const LocalBasis& basis = LocalBasis())
+    {
+      for (auto n : Dune::range(LocalBasis::size()))
+        sign_[n] = basis.sign(n);
+    }
+
+    /** \brief Compute the coefficients of the interpolant of a given function
+     *
+     * \tparam F Type of function to evaluate
+     * \tparam C Type used for the values of the function
+     * \param[in] f Function to evaluate
+     * \param[out] out Array of coefficients
+     */
+    template<typename F, typename C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      constexpr auto n = LocalBasis::size();
+      constexpr auto multiIndices = Orientation::multiIndices();
+
+      // Evaluate f at the tensor product nodes with the first direction running fastest
+      auto values = std::vector<C>(n);
+      typename LocalBasis::Traits::DomainType x;
+      for (auto l : Dune::range(n))
+      {
+        auto rest = l;
+        for (auto j : Dune::range(dim))
+        {
+          x[j] = D(rest % (k+1))/k;
+          rest /= (k+1);
+        }
+        values[l] = f(x);
+      }
+
+      // Apply the inverse univariate Vandermonde matrix in each direction
+      const auto& Vinv = inverseVandermonde1d();
+      auto coefficients = values;
+      std::size_t stride = 1;
+      for ([[maybe_unused]] auto j : Dune::range(dim))
+      {
+        for (auto l : Dune::range(n))
+        {
+          const auto m = (l / stride) % (k+1);
+          const auto base = l - m*stride;
+          coefficients[l] = values[base] * Vinv[m][0];
+          for (auto i : Dune::range(1u, k+1))
+            coefficients[l] += values[base + i*stride] * Vinv[m][i];
+        }
+        std::swap(values, coefficients);
+        stride *= (k+1);
+      }
+
+      out.resize(n);
+      for (auto l : Dune::range(n))
+      {
+        std::size_t tensorIndex = 0;
+        for (int j=dim-1; j>=0; --j)
+          tensorIndex = tensorIndex*(k+1) + multiIndices[l][j];
+        out[l] = values[tensorIndex] * sign_[l];
+      }
+    }
+
+  private:
+    std::array<R,LocalBasis::size()> sign_;
+  };
+
+} }    // namespace Dune::Impl
+
+namespace Dune
+{
+  /** \brief Hierarchical finite element of arbitrary order on cubes
+   *
+   * The shape functions are tensor products of the univariate functions
+   * \f$1-x\f$, \f$x\f$ and the integrated Legendre polynomials
+   * \f$\phi_i(x)=\int_{-1}^{2x-1}P_{i-1}(s)\,ds\f$, \f$i=2,\dots,k\f$,
+   * which are evaluated by three-term recurrences. The shape functions span
+   * \f$Q_k\f$ and are sorted by increasing degree such that the first
+   * \f$(p+1)^d\f$ shape functions, their local keys, and hence also element
+   * matrices and tabulations, coincide with those of the element of order \f$p\leq k\f$.
+   *
+   * For globally conforming spaces the shape functions on shared subentities
+   * have to be oriented consistently. This is achieved by constructing the
+   * element with the global vertex numbers of the element vertices.
+   *
+   * \tparam D type used for domain coordinates
+   * \tparam R type used for function values
+   * \tparam dim dimension of the reference element
+   * \tparam k polynomial order
+   */
+  template<class D, class R, int dim, int k>
+  class HierarchicalCubeLocalFiniteElement
+  {
+    static_assert(k >= 1, "HierarchicalCubeLocalFiniteElement requires k>=1");
+
+  public:
+    /** \brief Export number types, dimensions, etc.
+     */
+    using Traits = LocalFiniteElementTraits<Impl::HierarchicalCubeLocalBasis<D,R,dim,k>,
+                                            Impl::HierarchicalCubeLocalCoefficients<dim,k>,
+                                            Impl::HierarchicalCubeLocalInterpolation<Impl::HierarchicalCubeLocalBasis<D,R,dim,k> > >;
+
+    /** Default-construct the finite element */
+    HierarchicalCubeLocalFiniteElement() {}
+
+    /** \brief Constructs a finite element given a vertex numbering
+     *
+     * \param vertexmap Random access container with the global numbers of the element vertices
+     */
+    template<typename VertexMap>
+    explicit HierarchicalCubeLocalFiniteElement(const VertexMap& vertexmap)
+      : basis_(vertexmap)
+      , coefficients_(vertexmap)
+      , interpolation_(basis_)
+    {}
+
+    /** \brief Returns the local basis, i.e., the set of shape functions
+     */
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    /** \brief Returns the assignment of the degrees of freedom to the element subentities
+     */
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    /** \brief Returns object that evaluates degrees of freedom
+     */
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    /** \brief The number of shape functions */
+    static constexpr std::size_t size ()
+    {
+      return Impl::HierarchicalCubeLocalBasis<D,R,dim,k>::size();
+    }
+
+    /** \brief The reference element that the local finite element is defined on
+     */
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::cube(dim);
+    }
+
+  private:
+    Impl::HierarchicalCubeLocalBasis<D,R,dim,k> basis_;
+    Impl::HierarchicalCubeLocalCoefficients<dim,k> coefficients_;
+    Impl::HierarchicalCubeLocalInterpolation<Impl::HierarchicalCubeLocalBasis<D,R,dim,k> > interpolation_;
+  };
+
+}        // namespace Dune
+
+#endif   // DUNE_LOCALFUNCTIONS_HIERARCHICAL_HIERARCHICALCUBE_HH
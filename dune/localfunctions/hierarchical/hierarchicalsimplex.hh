@@ -0,0 +1,707 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_HIERARCHICAL_HIERARCHICALSIMPLEX_HH
+#define DUNE_LOCALFUNCTIONS_HIERARCHICAL_HIERARCHICALSIMPLEX_HH
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/hierarchical/integratedlegendre.hh>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief Structure of the hierarchical simplex shape functions
+   *
+   * Shape functions of order p>=2 are associated to subentities of dimension
+   * \f$1\leq m\leq d\f$ with vertices \f$v_0,\dots,v_m\f$, sorted by their global
+   * number. For degrees \f$i\geq 2\f$ and \f$j_2,\dots,j_m\geq 1\f$ with
+   * \f$i+j_2+\dots+j_m=p\f$ the shape function is
+   * \f[
+   *   L_i(\lambda_{v_1}-\lambda_{v_0}, \lambda_{v_0}+\lambda_{v_1})
+   *   \prod_{r=2}^m \lambda_{v_r} P^{(2s_r-1,0)}_{j_r-1}(2\lambda_{v_r}-t_r, t_r),
+   *   \qquad t_r = \sum_{l\leq r}\lambda_{v_l},\quad s_r = i+j_2+\dots+j_{r-1},
+   * \f]
+   * where \f$L_i\f$ and \f$P^{(\alpha,0)}_n\f$ denote the scaled integrated Legendre
+   * and Jacobi polynomials, respectively.
+   *
+   * The structure only depends on the relative order of the global vertex numbers.
+   * The structures for the \f$(d+1)!\f$ orderings are shared, see get().
+   */
+  template<unsigned int dim, unsigned int k>
+  struct HierarchicalSimplexStructure
+  {
+    // Degrees (i, j_2, ..., j_m) of a shape function on a subentity of dimension m
+    using Degrees = std::array<unsigned int,dim>;
+
+    struct SubEntity
+    {
+      unsigned int dimension;
+      unsigned int index;
+      std::array<unsigned int,dim+1> vertices;
+      // Position of the first Jacobi table of the subentity, see jacobiIndex()
+      std::size_t jacobiOffset;
+    };
+
+    struct ShapeFunction
+    {
+      std::size_t subEntity;
+      Degrees degrees;
+    };
+
+    //! \brief Number of shape functions of order at most p
+    static constexpr std::size_t size (unsigned int p)
+    {
+      return binomial(std::size_t(p+dim), std::size_t(dim));
+    }
+
+    //! \brief Number of subentities of dimension at least one
+    static constexpr std::size_t numSubEntities = (std::size_t(1) << (dim+1)) - dim - 2;
+
+    //! \brief Number of orderings of the vertices
+    static constexpr std::size_t numOrderings = factorial(std::size_t(dim+1));
+
+    /** \brief Number of Jacobi parameters q used by each factor r of the shape functions on a subentity of dimension m
+     *
+     * The factor r uses \f$q=s_r\f$ with \f$r\leq q\leq k-m+r-1\f$, since all
+     * degrees but the first one are at least one and the first one is at least two.
+     */
+    static constexpr std::size_t numJacobiParameters (unsigned int m)
+    {
+      return (m < k) ? k-m : 0;
+    }
+
+    //! \brief Number of Jacobi tables needed to evaluate all shape functions
+    static constexpr std::size_t numJacobiTables = [] {
+      std::size_t n = 0;
+      for (unsigned int m=2; m<=dim; ++m)
+        n += binomial(std::size_t(dim+1), std::size_t(m+1)) * (m-1) * numJacobiParameters(m);
+      return n;
+    }();
+
+    //! \brief Position of the Jacobi table of the factor r with parameter q on the given subentity
+    static constexpr std::size_t jacobiIndex (const SubEntity& subEntity, unsigned int r, unsigned int q)
+    {
+      return subEntity.jacobiOffset + (r-2)*numJacobiParameters(subEntity.dimension) + (q-r);
+    }
+
+    /** \brief Index of the ordering of the vertices by their global numbers
+     *
+     * The orderings are numbered by the Lehmer code of the vertex ranks, the
+     * identity has index zero.
+     */
+    template<class VertexMap>
+    static std::size_t orderingIndex (const VertexMap& vertexMap)
+    {
+      std::size_t index = 0;
+      for (auto i : Dune::range(dim+1))
+      {
+        std::size_t smaller = 0;
+        for (auto j : Dune::range(i+1, dim+1))
+          smaller += (vertexMap[j] < vertexMap[i]);
+        index = index*(dim+1-i) + smaller;
+      }
+      return index;
+    }
+
+    /** \brief Get the shared structure for the ordering of the given vertex numbering
+     *
+     * The structure of each ordering is created on its first request. This is
+     * thread-safe, each ordering is guarded by a std::once_flag.
+     */
+    template<class VertexMap>
+    static std::shared_ptr<const HierarchicalSimplexStructure> get (const VertexMap& vertexMap)
+    {
+      struct Slot
+      {
+        std::once_flag flag;
+        std::shared_ptr<const HierarchicalSimplexStructure> structure;
+      };
+      static std::array<Slot,numOrderings> slots;
+
+      auto& slot = slots[orderingIndex(vertexMap)];
+      std::call_once(slot.flag, [&] {
+        slot.structure = std::make_shared<const HierarchicalSimplexStructure>(vertexMap);
+      });
+      return slot.structure;
+    }
+
+    /** \brief Enumerate the degrees of all shape functions on a subentity of dimension m
+     *
+     * The degrees are sorted by their total order and lexicographically
+     * with the last entry running fastest otherwise. The position in this list
+     * is the index of the corresponding LocalKey.
+     */
+    static std::vector<Degrees> subEntityDegrees (unsigned int m)
+    {
+      auto result = std::vector<Degrees>();
+      for (unsigned int p=m+1; p<=k; ++p)
+      {
+        auto degrees = Degrees{};
+        auto recurse = [&](auto&& self, unsigned int r, unsigned int remaining) -> void {
+          if (r+1 == m)
+          {
+            degrees[r] = remaining;
+            result.push_back(degrees);
+            return;
+          }
+          const unsigned int minimalDegree = (r == 0) ? 2 : 1;
+          for (unsigned int d=minimalDegree; d+(m-1-r)<=remaining; ++d)
+          {
+            degrees[r] = d;
+            self(self, r+1, remaining-d);
+          }
+        };
+        if (m == 1)
+        {
+          degrees[0] = p;
+          result.push_back(degrees);
+        }
+        else
+          recurse(recurse, 0, p);
+      }
+      return result;
+    }
+
+    //! \brief Total order of the given degrees on a subentity of dimension m
+    static unsigned int totalOrder (const Degrees& degrees, unsigned int m)
+    {
+      return std::accumulate(degrees.begin(), degrees.begin()+m, 0u);
+    }
+
+    //! \brief Setup subentities, shape functions in hierarchical order and local keys
+    template<class VertexMap>
+    HierarchicalSimplexStructure (const VertexMap& vertexMap)
+      : ordering(orderingIndex(vertexMap))
+    {
+      const auto& refElement = ReferenceElements<double,dim>::simplex();
+
+      std::size_t jacobiOffset = 0;
+      for (unsigned int m=1; m<=dim; ++m)
+      {
+        const unsigned int codim = dim-m;
+        for (auto e : Dune::range(refElement.size(codim)))
+        {
+          auto subEntity = SubEntity{m, (unsigned int)e, {}, jacobiOffset};
+          for (auto l : Dune::range(m+1))
+            subEntity.vertices[l] = refElement.subEntity(e, codim, l, dim);
+          std::sort(subEntity.vertices.begin(), subEntity.vertices.begin()+m+1, [&](auto a, auto b) {
+            return vertexMap[a] < vertexMap[b];
+          });
+          subEntities.push_back(subEntity);
+          if (m >= 2)
+            jacobiOffset += (m-1)*numJacobiParameters(m);
+        }
+      }
+
+      std::array<std::vector<Degrees>,dim+1> degrees;
+      for (unsigned int m=1; m<=dim; ++m)
+        degrees[m] = subEntityDegrees(m);
+
+      for (auto v : Dune::range(dim+1))
+        localKeys.push_back(LocalKey(v, dim, 0));
+
+      for (unsigned int p=2; p<=k; ++p)
+        for (auto s : Dune::range(subEntities.size()))
+        {
+          const auto& subEntity = subEntities[s];
+          const auto m = subEntity.dimension;
+          for (auto index : Dune::range(degrees[m].size()))
+          {
+            if (totalOrder(degrees[m][index], m) != p)
+              continue;
+            shapeFunctions.push_back(ShapeFunction{s, degrees[m][index]});
+            localKeys.push_back(LocalKey(subEntity.index, dim-m, index));
+          }
+        }
+    }
+
+    std::size_t ordering;
+    std::vector<SubEntity> subEntities;
+    std::vector<ShapeFunction> shapeFunctions;
+    std::vector<LocalKey> localKeys;
+
+    //! \brief The identity vertex map
+    static auto identity ()
+    {
+      std::array<unsigned int,dim+1> vertexMap;
+      std::iota(vertexMap.begin(), vertexMap.end(), 0);
+      return vertexMap;
+    }
+  };
+
+  /** \brief Hierarchical shape functions of arbitrary order on the reference simplex
+
+     The first d+1 shape functions are the barycentric coordinates of the vertices.
+     The remaining shape functions are associated to the subentities as described
+     in HierarchicalSimplexStructure and sorted by increasing order, such that the
+     basis of order p is a prefix of the basis of order k>p.
+
+     \tparam D Type to represent the field in the domain
+     \tparam R Type to represent the field in the range
+     \tparam dim Dimension of the domain simplex
+     \tparam k Polynomial order
+   */
+  template<class D, class R, unsigned int dim, unsigned int k>
+  class HierarchicalSimplexLocalBasis
+  {
+    using Table = std::array<R,k+1>;
+    using LambdaGradient = std::array<R,dim+1>;
+
+    // Barycentric coordinates with respect to the vertices of the reference simplex
+    static auto barycentric (const typename LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >::DomainType& x)
+    {
+      auto lambda = std::array<R,dim+1>{};
+      lambda[0] = 1;
+      for (auto i : Dune::range(dim))
+      {
+        lambda[i+1] = x[i];
+        lambda[0] -= x[i];
+      }
+      return lambda;
+    }
+
+    // Evaluate all shape functions associated to subentities and, if requested,
+    // their gradients with respect to the barycentric coordinates.
+    template<bool withGradient, class F>
+    void evaluate (const std::array<R,dim+1>& lambda, F&& f) const
+    {
+      std::size_t n = dim+1;
+      // Tables of the polynomial factors for each subentity
+      std::array<std::array<Table,3>,Structure::numSubEntities> L;
+      // Tables of the Jacobi factors with parameter 2q-1 for the q used by the shape functions
+      std::array<std::array<Table,3>,Structure::numJacobiTables> J;
+      for (auto s : Dune::range(structure_->subEntities.size()))
+      {
+        const auto& subEntity = structure_->subEntities[s];
+        const auto& v = subEntity.vertices;
+        const auto m = subEntity.dimension;
+        evaluateScaledIntegratedLegendre(k, lambda[v[1]]-lambda[v[0]], lambda[v[0]]+lambda[v[1]], L[s][0], L[s][1], L[s][2]);
+        R t = lambda[v[0]] + lambda[v[1]];
+        for (unsigned int r=2; r<=m; ++r)
+        {
+          t += lambda[v[r]];
+          // The degrees of the factors r+1,...,m are at least one
+          for (unsigned int q=r; q+m<k+r; ++q)
+          {
+            auto& Jrq = J[Structure::jacobiIndex(subEntity, r, q)];
+            evaluateScaledJacobi(2*q-1, k-q-(m-r)-1, 2*lambda[v[r]]-t, t, Jrq[0], Jrq[1], Jrq[2]);
+          }
+        }
+      }
+
+      for (const auto& shapeFunction : structure_->shapeFunctions)
+      {
+        const auto& subEntity = structure_->subEntities[shapeFunction.subEntity];
+        const auto& v = subEntity.vertices;
+        const auto& degrees = shapeFunction.degrees;
+        const auto& Ls = L[shapeFunction.subEntity];
+
+        R value = Ls[0][degrees[0]];
+        auto gradient = LambdaGradient{};
+        if constexpr (withGradient)
+        {
+          gradient[v[0]] = -Ls[1][degrees[0]] + Ls[2][degrees[0]];
+          gradient[v[1]] = Ls[1][degrees[0]] + Ls[2][degrees[0]];
+        }
+
+        unsigned int q = degrees[0];
+        for (unsigned int r=2; r<=subEntity.dimension; ++r)
+        {
+          const auto& Jr = J[Structure::jacobiIndex(subEntity, r, q)];
+          const auto j = degrees[r-1]-1;
+          const R factor = lambda[v[r]]*Jr[0][j];
+          if constexpr (withGradient)
+          {
+            auto factorGradient = LambdaGradient{};
+            for (unsigned int l=0; l<r; ++l)
+              factorGradient[v[l]] = lambda[v[r]]*(Jr[2][j] - Jr[1][j]);
+            factorGradient[v[r]] = Jr[0][j] + lambda[v[r]]*(Jr[1][j] + Jr[2][j]);
+            for (auto l : Dune::range(dim+1))
+              gradient[l] = gradient[l]*factor + value*factorGradient[l];
+          }
+          value *= factor;
+          q += degrees[r-1];
+        }
+        f(n++, value, gradient);
+      }
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    //! \brief Structure of the shape functions
+    using Structure = HierarchicalSimplexStructure<dim,k>;
+
+    //! \brief Default constructor using the identity vertex numbering
+    HierarchicalSimplexLocalBasis ()
+      : structure_(Structure::get(Structure::identity()))
+    {}
+
+    /** \brief Construct the basis for a given vertex numbering
+     *
+     * The shape functions on each subentity are defined with respect to its vertices
+     * sorted by their global number. Hence they coincide on shared subentities
+     * for all elements using the same global vertex numbering.
+     */
+    template<class VertexMap>
+    explicit HierarchicalSimplexLocalBasis (const VertexMap& vertexMap)
+      : structure_(Structure::get(vertexMap))
+    {}
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return Structure::size(k);
+    }
+
+    //! \brief Number of shape functions of order at most p
+    static constexpr unsigned int size (unsigned int p)
+    {
+      return Structure::size(p);
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+      const auto lambda = barycentric(x);
+      for (auto v : Dune::range(dim+1))
+        out[v] = lambda[v];
+      evaluate<false>(lambda, [&](std::size_t n, const R& value, const auto&) {
+        out[n] = value;
+      });
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions
+     *
+     * \param x Point in the reference simplex where to evaluation the Jacobians
+     * \param[out] out The Jacobians of all shape functions at the point x
+     */
+    void evaluateJacobian(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+      const auto lambda = barycentric(x);
+      for (auto v : Dune::range(dim+1))
+        for (auto i : Dune::range(dim))
+          out[v][0][i] = (v == i+1) - (v == 0);
+      evaluate<true>(lambda, [&](std::size_t n, const R&, const auto& gradient) {
+        for (auto i : Dune::range(dim))
+          out[n][0][i] = gradient[i+1] - gradient[0];
+      });
+    }
+
+    /** \brief Evaluate partial derivatives of all shape functions
+     *
+     * Only derivatives up to first order are implemented.
+     *
+     * \param order Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    void partial(const std::array<unsigned int,dim>& order,
+                 const typename Traits::DomainType& in,
+                 std::vector<typename Traits::RangeType>& out) const
+    {
+      auto totalOrder = std::accumulate(order.begin(), order.end(), 0u);
+      if (totalOrder == 0)
+        evaluateFunction(in, out);
+      else if (totalOrder == 1)
+      {
+        auto direction = std::distance(order.begin(), std::find(order.begin(), order.end(), 1));
+        std::vector<typename Traits::JacobianType> jacobians;
+        evaluateJacobian(in, jacobians);
+        out.resize(size());
+        for (auto n : Dune::range(size()))
+          out[n] = jacobians[n][0][direction];
+      }
+      else
+        DUNE_THROW(NotImplemented, "HierarchicalSimplexLocalBasis::partial only implemented for derivative orders <= 1");
+    }
+
+    //! \brief Polynomial order of the shape functions
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+
+    //! \brief Access the structure of the shape functions
+    const Structure& structure () const
+    {
+      return *structure_;
+    }
+
+  private:
+    std::shared_ptr<const Structure> structure_;
+  };
+
+  /** \brief Associations of the hierarchical degrees of freedom to subentities of the reference simplex
+   *
+   * The degrees of freedom of a subentity are enumerated by increasing order
+   * such that the local keys of the basis of order p are preserved by the basis of order k>p.
+   *
+   * \tparam dim Dimension of the reference simplex
+   * \tparam k Polynomial order
+   */
+  template<unsigned int dim, unsigned int k>
+  class HierarchicalSimplexLocalCoefficients
+  {
+    using Structure = HierarchicalSimplexStructure<dim,k>;
+
+  public:
+    //! \brief Default constructor using the identity vertex numbering
+    HierarchicalSimplexLocalCoefficients ()
+      : structure_(Structure::get(Structure::identity()))
+    {}
+
+    //! \brief Construct the local keys for a given vertex numbering
+    template<class VertexMap>
+    explicit HierarchicalSimplexLocalCoefficients (const VertexMap& vertexMap)
+      : structure_(Structure::get(vertexMap))
+    {}
+
+    //! number of coefficients
+    static constexpr std::size_t size ()
+    {
+      return Structure::size(k);
+    }
+
+    //! get i'th index
+    const LocalKey& localKey (std::size_t i) const
+    {
+      return structure_->localKeys[i];
+    }
+
+  private:
+    std::shared_ptr<const Structure> structure_;
+  };
+
+  /** \brief Interpolation into the hierarchical basis on the reference simplex
+   *
+   * The function is evaluated at the equidistant Lagrange nodes of order k and
+   * the coefficients are obtained by applying the inverse Vandermonde matrix.
+   * Since the restriction of the basis to a subentity only depends on the nodes
+   * on the closure of this subentity, the interpolation is conforming.
+   * The inverse Vandermonde matrix only depends on the ordering of the vertices
+   * and is shared by all interpolations with the same ordering.
+   *
+   * \tparam LocalBasis The corresponding set of shape functions
+   */
+  template<class LocalBasis>
+  class HierarchicalSimplexLocalInterpolation
+  {
+    static constexpr auto dim = LocalBasis::Traits::dimDomain;
+    static constexpr auto k = LocalBasis::order();
+    using D = typename LocalBasis::Traits::DomainFieldType;
+    using R = typename LocalBasis::Traits::RangeFieldType;
+    using Domain = typename LocalBasis::Traits::DomainType;
+
+    // The equidistant Lagrange nodes of order k
+    static const std::vector<Domain>& nodes ()
+    {
+      static const std::vector<Domain> points = [] {
+        auto result = std::vector<Domain>();
+        auto i = std::array<unsigned int,dim>{};
+        for (auto l : Dune::range(power(k+1, dim)))
+        {
+          auto rest = l;
+          unsigned int sum = 0;
+          for (auto j : Dune::range(dim))
+          {
+            i[j] = rest % (k+1);
+            rest /= (k+1);
+            sum += i[j];
+          }
+          if (sum > k)
+            continue;
+          auto x = Domain{};
+          for (auto j : Dune::range(dim))
+            x[j] = D(i[j])/k;
+          result.push_back(x);
+        }
+        return result;
+      }();
+      return points;
+    }
+
+    // Get the inverse Vandermonde matrix of the vertex ordering of the basis,
+    // it is computed on the first request for this ordering
+    static std::shared_ptr<const DynamicMatrix<R>> inverseVandermonde (const LocalBasis& basis)
+    {
+      struct Slot
+      {
+        std::once_flag flag;
+        std::shared_ptr<const DynamicMatrix<R>> inverse;
+      };
+      static std::array<Slot,LocalBasis::Structure::numOrderings> slots;
+
+      auto& slot = slots[basis.structure().ordering];
+      std::call_once(slot.flag, [&] {
+        constexpr auto n = LocalBasis::size();
+        auto V = std::make_shared<DynamicMatrix<R>>(n, n, 0);
+        auto values = std::vector<typename LocalBasis::Traits::RangeType>();
+        for (auto i : Dune::range(n))
+        {
+          basis.evaluateFunction(nodes()[i], values);
+          for (auto j : Dune::range(n))
+            (*V)[i][j] = values[j];
+        }
+        V->invert();
+        slot.inverse = std::move(V);
+      });
+      return slot.inverse;
+    }
+
+  public:
+
+    //! \brief Default constructor for the basis using the identity vertex numbering
+    HierarchicalSimplexLocalInterpolation ()
+      : inverseVandermonde_(inverseVandermonde(LocalBasis()))
+    {}
+
+    //! \brief Construct the interpolation for the given basis
+    explicit HierarchicalSimplexLocalInterpolation (const LocalBasis& basis)
+      : inverseVandermonde_(inverseVandermonde(basis))
+    {}
+
+    /** \brief Compute the coefficients of the interpolant of a given function
+     *
+     * \tparam F Type of function to evaluate
+     * \tparam C Type used for the values of the function
+     * \param[in] f Function to evaluate
+     * \param[out] out Array of coefficients
+     */
+    template<typename F, typename C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      constexpr auto n = LocalBasis::size();
+      auto values = std::vector<C>(n);
+      for (auto i : Dune::range(n))
+        values[i] = f(nodes()[i]);
+
+      const auto& Vinv = *inverseVandermonde_;
+      out.resize(n);
+      for (auto i : Dune::range(n))
+      {
+        out[i] = values[0] * Vinv[i][0];
+        for (auto j : Dune::range(1u, n))
+          out[i] += values[j] * Vinv[i][j];
+      }
+    }
+
+  private:
+    std::shared_ptr<const DynamicMatrix<R>> inverseVandermonde_;
+  };
+
+} }    // namespace Dune::Impl
+
+namespace Dune
+{
+  /** \brief Hierarchical finite element of arbitrary order on simplices
+   *
+   * The shape functions span \f$P_k\f$ and consist of the barycentric coordinates
+   * and integrated Legendre type functions associated to edges, faces and the element
+   * interior, which are evaluated using three-term recurrences of scaled
+   * Legendre and Jacobi polynomials. The shape functions are sorted by increasing order
+   * such that the first shape functions, their local keys, and hence also element
+   * matrices and tabulations, coincide with those of the element of order \f$p\leq k\f$.
+   *
+   * For globally conforming spaces the shape functions on shared subentities
+   * have to be oriented consistently. This is achieved by constructing the
+   * element with the global vertex numbers of the element vertices.
+   *
+   * \tparam D type used for domain coordinates
+   * \tparam R type used for function values
+   * \tparam dim dimension of the reference element
+   * \tparam k polynomial order
+   */
+  template<class D, class R, int dim, int k>
+  class HierarchicalSimplexLocalFiniteElement
+  {
+    static_assert(k >= 1, "HierarchicalSimplexLocalFiniteElement requires k>=1");
+
+  public:
+    /** \brief Export number types, dimensions, etc.
+     */
+    using Traits = LocalFiniteElementTraits<Impl::HierarchicalSimplexLocalBasis<D,R,dim,k>,
+                                            Impl::HierarchicalSimplexLocalCoefficients<dim,k>,
+                                            Impl::HierarchicalSimplexLocalInterpolation<Impl::HierarchicalSimplexLocalBasis<D,R,dim,k> > >;
+
+    /** Default-construct the finite element */
+    HierarchicalSimplexLocalFiniteElement() {}
+
+    /** \brief Constructs a finite element given a vertex numbering
+     *
+     * \param vertexmap Random access container with the global numbers of the element vertices
+     */
+    template<typename VertexMap>
+    explicit HierarchicalSimplexLocalFiniteElement(const VertexMap& vertexmap)
+      : basis_(vertexmap)
+      , coefficients_(vertexmap)
+      , interpolation_(basis_)
+    {}
+
+    /** \brief Returns the local basis, i.e., the set of shape functions
+     */
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    /** \brief Returns the assignment of the degrees of freedom to the element subentities
+     */
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    /** \brief Returns object that evaluates degrees of freedom
+     */
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    /** \brief The number of shape functions */
+    static constexpr std::size_t size ()
+    {
+      return Impl::HierarchicalSimplexLocalBasis<D,R,dim,k>::size();
+    }
+
+    /** \brief The reference element that the local finite element is defined on
+     */
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::simplex(dim);
+    }
+
+  private:
+    Impl::HierarchicalSimplexLocalBasis<D,R,dim,k> basis_;
+    Impl::HierarchicalSimplexLocalCoefficients<dim,k> coefficients_;
+    Impl::HierarchicalSimplexLocalInterpolation<Impl::HierarchicalSimplexLocalBasis<D,R,dim,k> > interpolation_;
+  };
+
+}        // namespace Dune
+
+#endif   // DUNE_LOCALFUNCTIONS_HIERARCHICAL_HIERARCHICALSIMPLEX_HH
@@ -0,0 +1,201 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_HIERARCHICAL_INTEGRATEDLEGENDRE_HH
+#define DUNE_LOCALFUNCTIONS_HIERARCHICAL_INTEGRATEDLEGENDRE_HH
+
+/** \file
+    \brief Recurrences for (integrated) Legendre and Jacobi polynomials used by the hierarchical and tensor-product bases
+ */
+
+#include <cstddef>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief Evaluate scaled Jacobi polynomials and their first derivatives
+   *
+   * Computes \f$P_n(x,t) = t^n P^{(\alpha,0)}_n(x/t)\f$ and the partial
+   * derivatives with respect to x and t for n=0,...,N using the three-term recurrence
+   * \f$P_n = (a_n x + b_n t)P_{n-1} - c_n t^2 P_{n-2}\f$.
+   * For \f$\alpha=0\f$ these are the scaled Legendre polynomials.
+   *
+   * \param alpha Jacobi parameter
+   * \param N Maximal degree
+   * \param x,t Arguments of the scaled polynomials
+   * \param[out] P,Px,Pt Fixed-size arrays of size at least N+1
+   */
+  template<class R, class Table>
+  constexpr void evaluateScaledJacobi(unsigned int alpha, unsigned int N, const R& x, const R& t,
+                                      Table& P, Table& Px, Table& Pt)
+  {
+    P[0] = 1;
+    Px[0] = 0;
+    Pt[0] = 0;
+    if (N == 0)
+      return;
+    P[1] = ((alpha+2)*x + alpha*t)/2;
+    Px[1] = R(alpha+2)/2;
+    Pt[1] = R(alpha)/2;
+    for (unsigned int n=2; n<=N; ++n)
+    {
+      const R d = 2*n*(n+alpha)*(2*n+alpha-2);
+      const R a = (2*n+alpha-1)*(2*n+alpha)*(2*n+alpha-2) / d;
+      const R b = (2*n+alpha-1)*R(alpha*alpha) / d;
+      const R c = 2*(n+alpha-1)*(n-1)*(2*n+alpha) / d;
+      const R s = a*x + b*t;
+      P[n] = s*P[n-1] - c*t*t*P[n-2];
+      Px[n] = a*P[n-1] + s*Px[n-1] - c*t*t*Px[n-2];
+      Pt[n] = b*P[n-1] + s*Pt[n-1] - c*(2*t*P[n-2] + t*t*Pt[n-2]);
+    }
+  }
+
+  /** \brief Evaluate scaled integrated Legendre polynomials and their first derivatives
+   *
+   * Computes \f$L_n(x,t) = (P_n(x,t) - t^2 P_{n-2}(x,t))/(2n-1)\f$ for n=2,...,N
+   * where \f$P_n\f$ are the scaled Legendre polynomials. These satisfy
+   * \f$L_n(x,t) = t^n\int_{-1}^{x/t} P_{n-1}(s)\,ds\f$ and vanish for \f$x=\pm t\f$.
+   * The entries for n<2 are set to zero.
+   *
+   * \param N Maximal degree
+   * \param x,t Arguments of the scaled polynomials
+   * \param[out] L,Lx,Lt Fixed-size arrays of size at least N+1
+   */
+  template<class R, class Table>
+  constexpr void evaluateScaledIntegratedLegendre(unsigned int N, const R& x, const R& t,
+                                                  Table& L, Table& Lx, Table& Lt)
+  {
+    auto P = Table{};
+    auto Px = Table{};
+    auto Pt = Table{};
+    evaluateScaledJacobi(0, N, x, t, P, Px, Pt);
+    for (unsigned int n=0; n<=N and n<2; ++n)
+      L[n] = Lx[n] = Lt[n] = 0;
+    for (unsigned int n=2; n<=N; ++n)
+    {
+      L[n] = (P[n] - t*t*P[n-2]) / (2*n-1);
+      Lx[n] = (Px[n] - t*t*Px[n-2]) / (2*n-1);
+      Lt[n] = (Pt[n] - 2*t*P[n-2] - t*t*Pt[n-2]) / (2*n-1);
+    }
+  }
+
+  /** \brief Evaluate the shifted Legendre polynomials on [0,1] and their derivatives
+   *
+   * Computes the derivatives of \f$L_n(x) = P_n(2x-1)\f$ for n=0,...,k using the
+   * differentiated three-term recurrence
+   * \f$nL_n^{(r)} = (2n-1)((2x-1)L_{n-1}^{(r)} + 2rL_{n-1}^{(r-1)}) - (n-1)L_{n-2}^{(r)}\f$.
+   * The shifted Legendre polynomials satisfy \f$L_n(0)=(-1)^n\f$, \f$L_n(1)=1\f$
+   * and \f$\int_0^1 L_nL_m\,dx = \delta_{nm}/(2n+1)\f$.
+   *
+   * \param k Maximal degree
+   * \param x Evaluation point in [0,1]
+   * \param maxDerivative Maximal derivative order
+   * \param[out] table Fixed-size two-dimensional array, table[r][n] contains the r-th derivative of \f$L_n\f$ for r<=maxDerivative
+   */
+  template<class R, class Table>
+  constexpr void evaluateLegendre1d(unsigned int k, const R& x, unsigned int maxDerivative, Table& table)
+  {
+    const R s = 2*x-1;
+    for (unsigned int r=0; r<=maxDerivative; ++r)
+    {
+      for (unsigned int n=0; n<=k; ++n)
+      {
+        if (n == 0)
+          table[r][n] = (r == 0);
+        else if (n == 1)
+          table[r][n] = (r == 0) ? s : R(2*(r == 1));
+        else
+          table[r][n] = ((2*n-1)*(s*table[r][n-1] + ((r > 0) ? 2*r*table[r-1][n-1] : R(0))) - (n-1)*table[r][n-2]) / n;
+      }
+    }
+  }
+
+  /** \brief Evaluate the univariate hierarchical shape functions on [0,1] and their derivatives
+   *
+   * The shape functions are \f$\phi_0(x) = 1-x\f$, \f$\phi_1(x) = x\f$ and
+   * \f$\phi_i(x) = \int_{-1}^{2x-1}P_{i-1}(s)\,ds\f$ for i=2,...,k. Derivatives of
+   * order r>0 are computed from the derivatives of the shifted Legendre polynomials.
+   *
+   * \param k Maximal degree
+   * \param x Evaluation point in [0,1]
+   * \param maxDerivative Maximal derivative order
+   * \param[out] table Fixed-size two-dimensional array, table[r][i] contains the r-th derivative of \f$\phi_i\f$ for r<=maxDerivative
+   */
+  template<class R, class Table>
+  constexpr void evaluateIntegratedLegendre1d(unsigned int k, const R& x, unsigned int maxDerivative, Table& table)
+  {
+    // L[r][n] is the r-th derivative of the shifted Legendre polynomial L_n at x
+    auto L = Table{};
+    evaluateLegendre1d(k, x, maxDerivative, L);
+
+    // Values of the shape functions
+    table[0][0] = 1-x;
+    if (k >= 1)
+      table[0][1] = x;
+    for (unsigned int i=2; i<=k; ++i)
+      table[0][i] = (L[0][i] - L[0][i-2]) / (2*i-1);
+
+    // Derivatives: d^r/dx^r phi_i(x) = 2 L_{i-1}^{(r-1)}(x)
+    for (unsigned int r=1; r<=maxDerivative; ++r)
+    {
+      table[r][0] = (r == 1) ? -1 : 0;
+      if (k >= 1)
+        table[r][1] = (r == 1) ? 1 : 0;
+      for (unsigned int i=2; i<=k; ++i)
+        table[r][i] = 2*L[r-1][i-1];
+    }
+  }
+
+  /** \brief Evaluate the univariate polynomials dual to the Legendre moments and their derivatives
+   *
+   * The functions \f$\mu_a = (2a+1)L_a\f$, a=0,...,m, satisfy
+   * \f$\int_0^1 \mu_a L_b\,dx = \delta_{ab}\f$.
+   *
+   * \param m Maximal degree
+   * \param x Evaluation point in [0,1]
+   * \param maxDerivative Maximal derivative order
+   * \param[out] table Fixed-size two-dimensional array, table[r][a] contains the r-th derivative of \f$\mu_a\f$ for r<=maxDerivative
+   */
+  template<class R, class Table>
+  constexpr void evaluateLegendreMomentDual1d(unsigned int m, const R& x, unsigned int maxDerivative, Table& table)
+  {
+    evaluateLegendre1d(m, x, maxDerivative, table);
+    for (unsigned int r=0; r<=maxDerivative; ++r)
+      for (unsigned int a=0; a<=m; ++a)
+        table[r][a] *= 2*a+1;
+  }
+
+  /** \brief Evaluate the univariate polynomials dual to end point values and Legendre moments
+   *
+   * Computes the basis \f$\beta_0,\dots,\beta_m\f$ of the polynomials of degree m>0
+   * that is dual to the functionals \f$p\mapsto p(0)\f$, \f$p\mapsto p(1)\f$ and
+   * \f$p\mapsto\int_0^1 pL_c\,dx\f$ for c=0,...,m-2. The functions are combinations
+   * of shifted Legendre polynomials,
+   * \f$\beta_0 = (-1)^{m-1}(L_{m-1}-L_m)/2\f$, \f$\beta_1 = (L_{m-1}+L_m)/2\f$ and
+   * \f$\beta_{c+2} = (2c+1)(L_c-L_{m-1})\f$ or \f$\beta_{c+2} = (2c+1)(L_c-L_m)\f$,
+   * whichever vanishes at both end points.
+   *
+   * \param m Degree of the polynomials, must be positive
+   * \param x Evaluation point in [0,1]
+   * \param maxDerivative Maximal derivative order
+   * \param[out] table Fixed-size two-dimensional array, table[r][i] contains the r-th derivative of \f$\beta_i\f$ for r<=maxDerivative
+   */
+  template<class R, class Table>
+  constexpr void evaluateLegendreBoundaryDual1d(unsigned int m, const R& x, unsigned int maxDerivative, Table& table)
+  {
+    auto L = Table{};
+    evaluateLegendre1d(m, x, maxDerivative, L);
+    const R sign = (m%2 == 1) ? 1 : -1;
+    for (unsigned int r=0; r<=maxDerivative; ++r)
+    {
+      table[r][0] = sign*(L[r][m-1] - L[r][m])/2;
+      table[r][1] = (L[r][m-1] + L[r][m])/2;
+      for (unsigned int c=0; c+2<=m; ++c)
+        table[r][c+2] = (2*c+1)*(L[r][c] - L[r][((c+m)%2 == 1) ? m-1 : m]);
+    }
+  }
+
+} }    // namespace Dune::Impl
+
+#endif   // DUNE_LOCALFUNCTIONS_HIERARCHICAL_INTEGRATEDLEGENDRE_HH
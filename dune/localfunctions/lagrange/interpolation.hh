@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/typeutilities.hh>
 
 #include <dune/localfunctions/lagrange/lagrangecoefficients.hh>
@@ -76,6 +77,25 @@ namespace Dune
         basis.template evaluate< 0 >( lp.point(), coefficients[index++] );
     }
 
+    /** \brief Interpolate several functions at once, given by a function returning a vector of their values
+     *
+     *  The column j of the coefficient matrix contains the coefficients of the function j.
+     */
+    template< class Fn, class Field >
+    void interpolateFields ( const Fn &fn, DynamicMatrix< Field > &coefficients ) const
+    {
+      unsigned int index = 0;
+      for( const auto &lp : lagrangePoints_ )
+      {
+        const auto &values = fn( lp.point() );
+        if( index == 0 )
+          coefficients.resize( lagrangePoints_.size(), values.size() );
+        for( std::size_t j = 0; j < values.size(); ++j )
+          field_cast( values[ j ], coefficients[ index ][ j ] );
+        ++index;
+      }
+    }
+
     const LagrangePointSet &lagrangePoints () const { return lagrangePoints_; }
   };
 
@@ -7,7 +7,9 @@
 
 #include <array>
 #include <numeric>
+#include <vector>
 
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/math.hh>
@@ -17,13 +19,17 @@
 #include <dune/localfunctions/common/localbasis.hh>
 #include <dune/localfunctions/common/localfiniteelementtraits.hh>
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
 
 namespace Dune { namespace Impl
 {
-  // Forward declaration
+  // Forward declarations
   template<class LocalBasis>
   class LagrangeCubeLocalInterpolation;
 
+  template<class LocalBasis>
+  struct StaticLocalBasis;
+
    /** \brief Lagrange shape functions of arbitrary order on the reference cube [0,1]^d
 
      Lagrange shape functions of arbitrary order have the property that
@@ -38,9 +44,10 @@ namespace Dune { namespace Impl
   class LagrangeCubeLocalBasis
   {
     friend class LagrangeCubeLocalInterpolation<LagrangeCubeLocalBasis<D,R,dim,k> >;
+    friend struct StaticLocalBasis<LagrangeCubeLocalBasis<D,R,dim,k> >;
 
     // i-th Lagrange polynomial of degree k in one dimension
-    static R p(unsigned int i, D x)
+    static constexpr R p(unsigned int i, D x)
     {
       R result(1.0);
       for (unsigned int j=0; j<=k; j++)
@@ -49,7 +56,7 @@ namespace Dune { namespace Impl
     }
 
     // derivative of ith Lagrange polynomial of degree k in one dimension
-    static R dp(unsigned int i, D x)
+    static constexpr R dp(unsigned int i, D x)
     {
       R result(0.0);
 
@@ -98,6 +105,28 @@ namespace Dune { namespace Impl
       return result;
     }
 
+    // m-th derivative of the i-th Lagrange polynomial of degree k in one dimension
+    static R dnp(unsigned int i, D x, unsigned int m)
+    {
+      if (m > k)
+        return 0;
+
+      // d[l] is the l-th derivative of the product of the linear factors multiplied so far
+      std::array<R,k+1> d{};
+      d[0] = 1;
+      for (unsigned int j=0; j<=k; j++)
+      {
+        if (j==i)
+          continue;
+        const R a = (k*1.0)/((int)i-(int)j);
+        const R factor = (k*x-j)/((int)i-(int)j);
+        for (unsigned int l=m; l>0; l--)
+          d[l] = d[l]*factor + l*a*d[l-1];
+        d[0] *= factor;
+      }
+      return d[m];
+    }
+
     // Return i as a d-digit number in the (k+1)-nary system
     static std::array<unsigned int,dim> multiindex (unsigned int i)
     {
@@ -110,6 +139,99 @@ namespace Dune { namespace Impl
       return alpha;
     }
 
+    // Contract the coefficients with the tensor product of the one-dimensional factors[l] in the directions l,
+    // one direction after the other
+    template<class Coefficients>
+    static R sumFactorize(const Coefficients& coefficients, const std::array<const std::array<R,k+1>*,dim>& factors)
+    {
+      std::array<R,size()> t;
+      for (unsigned int i=0; i<size(); i++)
+        t[i] = coefficients[i];
+
+      // Direction l is the fastest running index of the remaining tensor t
+      unsigned int n = size();
+      for (unsigned int l=0; l<dim; l++)
+      {
+        n /= k+1;
+        for (unsigned int m=0; m<n; m++)
+        {
+          R value = 0;
+          for (unsigned int a=0; a<=k; a++)
+            value += (*factors[l])[a] * t[a + (k+1)*m];
+          t[m] = value;
+        }
+      }
+      return t[0];
+    }
+
+    // Call g(i,j,value) with the derivative of the shape function i in direction j
+    template<class G>
+    static void forEachJacobianEntry(const FieldVector<D,dim>& x, G&& g)
+    {
+      // Specialization for k==0
+      if (k==0)
+      {
+        for (unsigned int j=0; j<dim; j++)
+          g(0u, j, R(0));
+        return;
+      }
+
+      // Specialization for k==1
+      if (k==1)
+      {
+        // Loop over all shape functions
+        for (unsigned int i=0; i<size(); i++)
+        {
+          // Loop over all coordinate directions
+          for (unsigned int j=0; j<dim; j++)
+          {
+            // Initialize: the overall expression is a product
+            // if j-th bit of i is set to 1, else -1
+            R value = (i & (1<<j)) ? 1 : -1;
+
+            for (unsigned int l=0; l<dim; l++)
+            {
+              if (j!=l)
+                // if l-th bit of i is set multiply with x[l], else with 1-x[l]
+                value *= (i & (1<<l)) ? x[l] :  1-x[l];
+            }
+            g(i, j, value);
+          }
+        }
+        return;
+      }
+
+      // The general case
+
+      // The one-dimensional Lagrange polynomials and their derivatives in all directions
+      std::array<std::array<R,k+1>,dim> px, dpx;
+      for (unsigned int l=0; l<dim; l++)
+        for (unsigned int a=0; a<=k; a++)
+        {
+          px[l][a] = p(a,x[l]);
+          dpx[l][a] = dp(a,x[l]);
+        }
+
+      // Loop over all shape functions
+      for (unsigned int i=0; i<size(); i++)
+      {
+        // convert index i to multiindex
+        std::array<unsigned int,dim> alpha(multiindex(i));
+
+        // Loop over all coordinate directions
+        for (unsigned int j=0; j<dim; j++)
+        {
+          R value = dpx[j][alpha[j]];
+
+          // rest of the product
+          for (unsigned int l=0; l<dim; l++)
+            if (l!=j)
+              value *= px[l][alpha[l]];
+          g(i, j, value);
+        }
+      }
+    }
+
   public:
     using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
 
@@ -170,58 +292,202 @@ namespace Dune { namespace Impl
                           std::vector<typename Traits::JacobianType>& out) const
     {
       out.resize(size());
+      forEachJacobianEntry(x, [&](auto i, auto j, const R& value) {
+        out[i][0][j] = value;
+      });
+    }
 
-      // Specialization for k==0
-      if (k==0)
+    /** \brief Evaluate Jacobian of all shape functions into one array per direction
+     *
+     * \param x Point in the reference cube where to evaluation the Jacobians
+     * \param[out] out The derivative of shape function i in direction j is stored in out[j][i*stride]
+     * \param stride Distance of the derivatives of consecutive shape functions in the arrays
+     */
+    void evaluateJacobianSoA(const typename Traits::DomainType& x,
+                             const std::array<R*,dim>& out, std::size_t stride = 1) const
+    {
+      forEachJacobianEntry(x, [&](auto i, auto j, const R& value) {
+        out[j][i*stride] = value;
+      });
+    }
+
+    /** \brief Evaluate a linear combination of the shape functions
+     *
+     * The coefficients are contracted with the one-dimensional Lagrange polynomials
+     * one direction after the other (sum factorization), without evaluating the shape functions.
+     *
+     * \param x Point in the reference cube where to evaluate the linear combination
+     * \param coefficients The coefficients of all shape functions
+     * \param[out] y The value of the linear combination at the point x
+     */
+    template<class Coefficients>
+    void contractFunction(const typename Traits::DomainType& x, const Coefficients& coefficients,
+                          typename Traits::RangeType& y) const
+    {
+      std::array<std::array<R,k+1>,dim> px;
+      std::array<const std::array<R,k+1>*,dim> factors;
+      for (unsigned int l=0; l<dim; l++)
       {
-        std::fill(out[0][0].begin(), out[0][0].end(), 0);
-        return;
+        for (unsigned int a=0; a<=k; a++)
+          px[l][a] = p(a,x[l]);
+        factors[l] = &px[l];
       }
+      y = sumFactorize(coefficients, factors);
+    }
 
-      // Specialization for k==1
-      if (k==1)
+    /** \brief Evaluate the Jacobian of a linear combination of the shape functions by sum factorization
+     *
+     * \param x Point in the reference cube where to evaluate the Jacobian
+     * \param coefficients The coefficients of all shape functions
+     * \param[out] y The Jacobian of the linear combination at the point x
+     */
+    template<class Coefficients>
+    void contractJacobian(const typename Traits::DomainType& x, const Coefficients& coefficients,
+                          typename Traits::JacobianType& y) const
+    {
+      std::array<std::array<R,k+1>,dim> px, dpx;
+      for (unsigned int l=0; l<dim; l++)
+        for (unsigned int a=0; a<=k; a++)
+        {
+          px[l][a] = p(a,x[l]);
+          dpx[l][a] = dp(a,x[l]);
+        }
+
+      for (unsigned int j=0; j<dim; j++)
       {
-        // Loop over all shape functions
-        for (size_t i=0; i<size(); i++)
+        std::array<const std::array<R,k+1>*,dim> factors;
+        for (unsigned int l=0; l<dim; l++)
+          factors[l] = (l==j) ? &dpx[l] : &px[l];
+        y[0][j] = sumFactorize(coefficients, factors);
+      }
+    }
+
+    /** \brief Add the shape functions tested against a value and a flux at a point
+     *
+     * This is a fused kernel for a single point: the values of all shape functions and their
+     * gradients contracted with the flux are built up in one pass over the directions, as
+     * tensor products of the one-dimensional Lagrange polynomials and their derivatives,
+     * without storing the Jacobians of the shape functions. The cost per point is of the order
+     * of the number of shape functions. For tensor-product quadrature rules the overload of
+     * integrateShapeFunctions() taking one-dimensional rules uses sum factorization instead.
+     *
+     * \param x Point in the reference cube where to evaluate the shape functions
+     * \param value The value q tested with the shape functions
+     * \param flux The flux F tested with the Jacobians of the shape functions
+     * \param[in,out] out The entry i is incremented by \f$q\phi_i(x) + F:\nabla\phi_i(x)\f$
+     */
+    template<class Out>
+    void addTransposedContraction(const typename Traits::DomainType& x, const typename Traits::RangeType& value,
+                                  const typename Traits::JacobianType& flux, Out& out) const
+    {
+      // a is the product of the polynomials in the leading directions, b the product with
+      // the derivative in one of these directions weighted by the flux, summed over the directions
+      std::array<R,size()> a, b;
+      a[0] = 1;
+      b[0] = 0;
+      unsigned int n = 1;
+      for (unsigned int l=0; l<dim; l++)
+      {
+        // Expand in place, the new index m + n*alpha is never smaller than the index m
+        for (unsigned int alpha=k+1; alpha-- > 0; )
         {
-          // Loop over all coordinate directions
-          for (unsigned int j=0; j<dim; j++)
+          const R px = p(alpha,x[l]);
+          const R dpx = dp(alpha,x[l]) * flux[0][l];
+          for (unsigned int m=n; m-- > 0; )
           {
-            // Initialize: the overall expression is a product
-            // if j-th bit of i is set to 1, else -11
-            out[i][0][j] = (i & (1<<j)) ? 1 : -1;
-
-            for (unsigned int l=0; l<dim; l++)
-            {
-              if (j!=l)
-                // if l-th bit of i is set multiply with x[l], else with 1-x[l]
-                out[i][0][j] *= (i & (1<<l)) ? x[l] :  1-x[l];
-            }
+            b[m + n*alpha] = b[m]*px + a[m]*dpx;
+            a[m + n*alpha] = a[m]*px;
           }
         }
-        return;
+        n *= k+1;
       }
 
-      // The general case
+      for (unsigned int i=0; i<size(); i++)
+        out[i] += value[0]*a[i] + b[i];
+    }
 
-      // Loop over all shape functions
-      for (size_t i=0; i<size(); i++)
+    /** \brief Integrate all shape functions against values and fluxes on a tensor-product quadrature rule
+     *
+     * The quadrature points are the tensor products of the one-dimensional points of all
+     * directions, numbered lexicographically with direction 0 running fastest, and their weights
+     * are the products of the one-dimensional weights. The weighted values and fluxes are
+     * contracted with the one-dimensional Lagrange polynomials, or with their derivatives in the
+     * direction of the flux component, one direction after the other. With n points per direction
+     * this costs of the order of \f$(dim+1)(k+1)n^{dim}\f$ operations, instead of
+     * \f$(k+1)^{dim}n^{dim}\f$ for testing point by point.
+     *
+     * \param points The one-dimensional quadrature points of each direction
+     * \param weights The one-dimensional quadrature weights of each direction
+     * \param values The values q at the tensor-product points, or an empty vector
+     * \param fluxes The fluxes F at the tensor-product points, or an empty vector
+     * \param[out] out The integrals \f$\sum_p w_p(q_p\phi_i(x_p) + F_p:\nabla\phi_i(x_p))\f$
+     */
+    template<class Weights, class Out>
+    void integrateShapeFunctions(const std::array<std::vector<D>,dim>& points, const std::array<Weights,dim>& weights,
+                                 const std::vector<typename Traits::RangeType>& values,
+                                 const std::vector<typename Traits::JacobianType>& fluxes, Out& out) const
+    {
+      // The one-dimensional polynomials and their derivatives, px[l][a + (k+1)*q] is p(a,points[l][q])
+      std::array<std::vector<R>,dim> px, dpx;
+      std::array<std::size_t,dim> n;
+      std::size_t numPoints = 1;
+      for (unsigned int l=0; l<dim; l++)
       {
-        // convert index i to multiindex
-        std::array<unsigned int,dim> alpha(multiindex(i));
+        n[l] = points[l].size();
+        numPoints *= n[l];
+        px[l].resize((k+1)*n[l]);
+        dpx[l].resize((k+1)*n[l]);
+        for (std::size_t q=0; q<n[l]; q++)
+          for (unsigned int a=0; a<=k; a++)
+          {
+            px[l][a + (k+1)*q] = p(a,points[l][q]);
+            dpx[l][a + (k+1)*q] = dp(a,points[l][q]);
+          }
+      }
 
-        // Loop over all coordinate directions
-        for (unsigned int j=0; j<dim; j++)
-        {
-          // Initialize: the overall expression is a product
-          // if j-th bit of i is set to -1, else 1
-          out[i][0][j] = dp(alpha[j],x[j]);
+      std::vector<R> weight(numPoints);
+      for (std::size_t q=0; q<numPoints; q++)
+      {
+        weight[q] = 1;
+        for (std::size_t l=0, m=q; l<dim; m/=n[l], l++)
+          weight[q] *= weights[l][m % n[l]];
+      }
 
-          // rest of the product
-          for (unsigned int l=0; l<dim; l++)
-            if (l!=j)
-              out[i][0][j] *= p(alpha[l],x[l]);
+      out.assign(size(), 0);
+
+      // The term 0 tests the values, the term j+1 the flux components in direction j
+      std::vector<R> t, s;
+      for (unsigned int term=0; term<=dim; term++)
+      {
+        if (term==0 ? values.empty() : fluxes.empty())
+          continue;
+
+        t.resize(numPoints);
+        for (std::size_t q=0; q<numPoints; q++)
+          t[q] = weight[q] * (term==0 ? values[q][0] : fluxes[q][0][term-1]);
+
+        // Replace the points of direction l by the polynomials, the directions before l
+        // are the fastest running indices and have already been replaced
+        std::size_t inner = 1, outer = numPoints;
+        for (unsigned int l=0; l<dim; l++)
+        {
+          outer /= n[l];
+          const std::vector<R>& f = (term == l+1) ? dpx[l] : px[l];
+          s.assign(inner*(k+1)*outer, 0);
+          for (std::size_t o=0; o<outer; o++)
+            for (std::size_t q=0; q<n[l]; q++)
+              for (unsigned int a=0; a<=k; a++)
+              {
+                const R fa = f[a + (k+1)*q];
+                for (std::size_t m=0; m<inner; m++)
+                  s[m + inner*(a + (k+1)*o)] += fa * t[m + inner*(q + n[l]*o)];
+              }
+          std::swap(s, t);
+          inner *= k+1;
         }
+
+        for (unsigned int i=0; i<size(); i++)
+          out[i] += t[i];
       }
     }
 
@@ -306,13 +572,12 @@ namespace Dune { namespace Impl
             }
           }
         }
-        else
-          DUNE_THROW(NotImplemented, "Partial derivative of order " << totalOrder << " is not implemented!");
 
-        return;
+        if (totalOrder <= 2)
+          return;
       }
 
-      // The case k>1
+      // The case k>1, and derivatives of higher order for k==1
 
       // Loop over all shape functions
       for (size_t i=0; i<size(); i++)
@@ -338,12 +603,56 @@ namespace Dune { namespace Impl
               out[i][0] *= ddp(alpha[l],in[l]);
               break;
             default:
-              DUNE_THROW(NotImplemented, "Desired derivative order is not implemented");
+              out[i][0] *= dnp(alpha[l],in[l],order[l]);
           }
         }
       }
     }
 
+    /** \brief Evaluate the partial derivatives of all shape functions given by a static multi-index
+     *
+     * In contrast to the method with a dynamic order, the order of the
+     * derivative is known at compile time. The derivatives of the
+     * one-dimensional factors are computed once per direction and the
+     * case distinctions are resolved by the compiler.
+     *
+     * \tparam orders Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    template<unsigned int... orders>
+    void partial(const typename Traits::DomainType& in,
+                 std::vector<typename Traits::RangeType>& out) const
+    {
+      static_assert(sizeof...(orders) == dim, "The multi-index of the partial derivative needs dim entries");
+      constexpr auto order = std::array<unsigned int,dim>{orders...};
+
+      out.resize(size());
+      if constexpr ((orders + ... + 0u) == 0)
+        evaluateFunction(in, out);
+      else if constexpr (((orders > k) or ... or false))
+      {
+        for (auto& out_i : out)
+          out_i = 0;
+      }
+      else
+      {
+        // f[l][a] is the derivative of the a-th Lagrange polynomial in direction l
+        std::array<std::array<R,k+1>,dim> f;
+        for (std::size_t l=0; l<dim; l++)
+          for (unsigned int a=0; a<=k; a++)
+            f[l][a] = (order[l]==0) ? p(a,in[l]) : (order[l]==1) ? dp(a,in[l]) : dnp(a,in[l],order[l]);
+
+        for (size_t i=0; i<size(); i++)
+        {
+          std::array<unsigned int,dim> alpha(multiindex(i));
+          out[i][0] = 1.0;
+          for (std::size_t l=0; l<dim; l++)
+            out[i][0] *= f[l][alpha[l]];
+        }
+      }
+    }
+
     //! \brief Polynomial order of the shape functions
     static constexpr unsigned int order ()
     {
@@ -359,10 +668,12 @@ namespace Dune { namespace Impl
   template<unsigned int dim, unsigned int k>
   class LagrangeCubeLocalCoefficients
   {
+    using SubEntities = std::array<unsigned int,power(k+1,dim)>;
+
     // Return i as a d-digit number in the (k+1)-nary system
-    static std::array<unsigned int,dim> multiindex (unsigned int i)
+    static constexpr std::array<unsigned int,dim> multiindex (unsigned int i)
     {
-      std::array<unsigned int,dim> alpha;
+      std::array<unsigned int,dim> alpha{};
       for (unsigned int j=0; j<dim; j++)
       {
         alpha[j] = i % (k+1);
@@ -372,7 +683,7 @@ namespace Dune { namespace Impl
     }
 
     /** \brief Set the 'subentity' field for each dof for a 1d element */
-    void setup1d(std::vector<unsigned int>& subEntity)
+    static constexpr void setup1d(SubEntities& subEntity)
     {
       assert(k>0);
 
@@ -392,7 +703,7 @@ namespace Dune { namespace Impl
       assert(power(k+1,dim)==lastIndex);
     }
 
-    void setup2d(std::vector<unsigned int>& subEntity)
+    static constexpr void setup2d(SubEntities& subEntity)
     {
       assert(k>0);
 
@@ -434,7 +745,7 @@ namespace Dune { namespace Impl
       assert(power(k+1,dim)==lastIndex);
     }
 
-    void setup3d(std::vector<unsigned int>& subEntity)
+    static constexpr void setup3d(SubEntities& subEntity)
     {
       assert(k>0);
 
@@ -537,28 +848,28 @@ namespace Dune { namespace Impl
       assert(numIndices==lastIndex);
     }
 
-  public:
-    //! \brief Default constructor
-    LagrangeCubeLocalCoefficients ()
-    : localKeys_(size())
+    // Compute the local keys of all degrees of freedom
+    static constexpr std::array<LocalKey,power(k+1,dim)> generateLocalKeys ()
     {
+      std::array<LocalKey,power(k+1,dim)> localKeys;
+
       if (k==0)
       {
-        localKeys_[0] = LocalKey(0,0,0);
-        return;
+        localKeys[0] = LocalKey(0,0,0);
+        return localKeys;
       }
 
       if (k==1)
       {
-        for (std::size_t i=0; i<size(); i++)
-          localKeys_[i] = LocalKey(i,dim,0);
-        return;
+        for (std::size_t i=0; i<localKeys.size(); i++)
+          localKeys[i] = LocalKey(i,dim,0);
+        return localKeys;
       }
 
       // Now: the general case
 
       // Set up array of codimension-per-dof-number
-      std::vector<unsigned int> codim(size());
+      std::array<unsigned int,power(k+1,dim)> codim{};
 
       for (std::size_t i=0; i<codim.size(); i++)
       {
@@ -577,9 +888,9 @@ namespace Dune { namespace Impl
       // To make it consecutive we interpret 'i' in the (k+1)-adic system, omit all digits
       // that correspond to axes where the dof is on the element boundary, and transform the
       // rest to the (k-1)-adic system.
-      std::vector<unsigned int> index(size());
+      std::array<unsigned int,power(k+1,dim)> index{};
 
-      for (std::size_t i=0; i<size(); i++)
+      for (std::size_t i=0; i<index.size(); i++)
       {
         index[i] = 0;
 
@@ -591,7 +902,7 @@ namespace Dune { namespace Impl
       }
 
       // Set up entity and dof numbers for each (supported) dimension separately
-      std::vector<unsigned int> subEntity(size());
+      SubEntities subEntity{};
 
       if (dim==1) {
 
@@ -606,10 +917,26 @@ namespace Dune { namespace Impl
         setup3d(subEntity);
 
       } else
-        DUNE_THROW(Dune::NotImplemented, "LagrangeCubeLocalCoefficients for order " << k << " and dim == " << dim);
+        return localKeys;   // not implemented, the constructor throws
 
-      for (size_t i=0; i<size(); i++)
-        localKeys_[i] = LocalKey(subEntity[i], codim[i], index[i]);
+      for (size_t i=0; i<localKeys.size(); i++)
+        localKeys[i] = LocalKey(subEntity[i], codim[i], index[i]);
+      return localKeys;
+    }
+
+    // The local keys shared by all instances
+    static const std::array<LocalKey,power(k+1,dim)>& localKeys ()
+    {
+      static constexpr std::array<LocalKey,power(k+1,dim)> keys = generateLocalKeys();
+      return keys;
+    }
+
+  public:
+    //! \brief Default constructor
+    LagrangeCubeLocalCoefficients ()
+    {
+      if (k>1 and dim>3)
+        DUNE_THROW(Dune::NotImplemented, "LagrangeCubeLocalCoefficients for order " << k << " and dim == " << dim);
     }
 
     //! number of coefficients
@@ -621,11 +948,15 @@ namespace Dune { namespace Impl
     //! get i-th index
     const LocalKey& localKey (std::size_t i) const
     {
-      return localKeys_[i];
+      return localKeys()[i];
     }
 
-  private:
-    std::vector<LocalKey> localKeys_;
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(LagrangeCubeLocalCoefficients{});
+      return table;
+    }
   };
 
   /** \brief Evaluate the degrees of freedom of a Lagrange basis
@@ -635,17 +966,9 @@ namespace Dune { namespace Impl
   template<class LocalBasis>
   class LagrangeCubeLocalInterpolation
   {
-  public:
-
-    /** \brief Evaluate a given function at the Lagrange nodes
-     *
-     * \tparam F Type of function to evaluate
-     * \tparam C Type used for the values of the function
-     * \param[in] f Function to evaluate
-     * \param[out] out Array of function values
-     */
-    template<typename F, typename C>
-    void interpolate (const F& f, std::vector<C>& out) const
+    // Call g(i,x) for all Lagrange nodes x in the order of the shape functions
+    template<class G>
+    static void forEachNode (G&& g)
     {
       constexpr auto dim = LocalBasis::Traits::dimDomain;
       constexpr auto k = LocalBasis::order();
@@ -653,13 +976,11 @@ namespace Dune { namespace Impl
 
       typename LocalBasis::Traits::DomainType x;
 
-      out.resize(LocalBasis::size());
-
       // Specialization for zero-order case
       if (k==0)
       {
         auto center = ReferenceElements<D,dim>::cube().position(0,0);
-        out[0] = f(center);
+        g(0u, center);
         return;
       }
 
@@ -672,7 +993,7 @@ namespace Dune { namespace Impl
           for (int j=0; j<dim; j++)
             x[j] = (i & (1<<j)) ? 1.0 : 0.0;
 
-          out[i] = f(x);
+          g(i, x);
         }
         return;
       }
@@ -687,10 +1008,47 @@ namespace Dune { namespace Impl
         for (unsigned int j=0; j<dim; j++)
           x[j] = (1.0*alpha[j])/k;
 
-        out[i] = f(x);
+        g(i, x);
       }
     }
 
+  public:
+
+    /** \brief Evaluate a given function at the Lagrange nodes
+     *
+     * \tparam F Type of function to evaluate
+     * \tparam C Type used for the values of the function
+     * \param[in] f Function to evaluate
+     * \param[out] out Array of function values
+     */
+    template<typename F, typename C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      out.resize(LocalBasis::size());
+      forEachNode([&](auto i, const auto& x) {
+        out[i] = f(x);
+      });
+    }
+
+    /** \brief Evaluate several functions at the Lagrange nodes at once
+     *
+     * \tparam F Type of function returning the values of all functions, e.g. as std::array
+     * \tparam C Type used for the values of the functions
+     * \param[in] f Function to evaluate
+     * \param[out] out Matrix of function values, the column j contains the coefficients of function j
+     */
+    template<typename F, typename C>
+    void interpolateFields (const F& f, DynamicMatrix<C>& out) const
+    {
+      forEachNode([&](auto i, const auto& x) {
+        const auto& values = f(x);
+        if (i == 0)
+          out.resize(LocalBasis::size(), values.size());
+        for (std::size_t j=0; j<values.size(); j++)
+          out[i][j] = values[j];
+      });
+    }
+
   };
 
 } }    // namespace Dune::Impl
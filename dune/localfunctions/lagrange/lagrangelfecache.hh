@@ -5,9 +5,12 @@
 #ifndef DUNE_LOCALFUNCTIONS_LAGRANGE_LAGRANGELFECACHE_HH
 #define DUNE_LOCALFUNCTIONS_LAGRANGE_LAGRANGELFECACHE_HH
 
+#include <cstddef>
 #include <tuple>
 #include <utility>
 
+#include <dune/common/exceptions.hh>
+
 #include <dune/geometry/type.hh>
 #include <dune/geometry/typeindex.hh>
 
@@ -99,6 +102,42 @@ namespace Impl {
     }
   };
 
+  // Provide implemented Lagrange local finite elements of the orders 1,...,maxOrder
+  // with the index gtIndex*maxOrder + order-1 for the key (GeometryType, order)
+
+  template<class D, class R, std::size_t dim, std::size_t maxOrder>
+  struct ImplementedHPLagrangeFiniteElements
+  {
+    static_assert(maxOrder >= 1, "The maximal order of an hp cache must be at least 1");
+
+    static std::size_t index(const GeometryType& gt, std::size_t order)
+    {
+      if (order < 1 or order > maxOrder)
+        DUNE_THROW(Dune::RangeError, "There is no Lagrange element of order " << order << " in a cache of the orders 1,...," << maxOrder);
+      return FixedDimLocalGeometryTypeIndex<dim>::index(gt)*maxOrder + order-1;
+    }
+
+    static auto getImplementations()
+    {
+      return implementations(std::make_index_sequence<maxOrder>{});
+    }
+
+  private:
+    template<std::size_t... i>
+    static auto implementations(std::index_sequence<i...>)
+    {
+      return std::tuple_cat(implementations<i+1>()...);
+    }
+
+    template<std::size_t order>
+    static auto implementations()
+    {
+      return std::apply([](auto... impl) {
+        return std::make_tuple(std::make_pair(impl.first*maxOrder + order-1, impl.second)...);
+      }, ImplementedLagrangeFiniteElements<D,R,dim,order>::getImplementations());
+    }
+  };
+
 } // namespace Impl
 
 
@@ -111,11 +150,32 @@ namespace Impl {
  * \tparam R Type used for shape function values
  * \tparam dim Element dimension
  * \tparam order Element order
+ * \tparam lazy Create the elements on first request, see LocalFiniteElementVariantCache
  *
  * The cached finite element implementations can be obtained using get(GeometryType).
  */
-template<class D, class R, std::size_t dim, std::size_t order>
-using LagrangeLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedLagrangeFiniteElements<D,R,dim,order>>;
+template<class D, class R, std::size_t dim, std::size_t order, bool lazy = false>
+using LagrangeLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedLagrangeFiniteElements<D,R,dim,order>, lazy>;
+
+
+/** \brief A cache that stores all available Pk/Qk like local finite elements for the given dimension and the orders 1,...,maxOrder
+ *
+ * In contrast to DynamicLagrangeLocalFiniteElementCache the order is selected at run time
+ * among the hand-written implementations of LagrangeLocalFiniteElementCache, e.g. for
+ * p-adaptive methods. The exported FiniteElementType is a LocalFiniteElementVariant of
+ * the elements of all orders, hence elements of different orders are returned as the same
+ * type without any allocation. Prisms and pyramids are only available for the orders 1 and 2.
+ *
+ * \tparam D Type used for domain coordinates
+ * \tparam R Type used for shape function values
+ * \tparam dim Element dimension
+ * \tparam maxOrder Maximal element order
+ * \tparam lazy Create the elements on first request, see LocalFiniteElementVariantCache
+ *
+ * The cached finite element implementations can be obtained using get(GeometryType, order).
+ */
+template<class D, class R, std::size_t dim, std::size_t maxOrder, bool lazy = false>
+using HPLagrangeLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedHPLagrangeFiniteElements<D,R,dim,maxOrder>, lazy>;
 
 
 
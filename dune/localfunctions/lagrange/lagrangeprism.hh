@@ -492,56 +492,70 @@ namespace Dune { namespace Impl
   template<unsigned int k>
   class LagrangePrismLocalCoefficients
   {
-  public:
-    //! \brief Default constructor
-    LagrangePrismLocalCoefficients ()
-    : localKeys_(size())
+    // Compute the local keys of all degrees of freedom
+    static constexpr auto generateLocalKeys ()
     {
+      std::array<LocalKey,size()> localKeys;
+
       if (k==0)
       {
-        localKeys_[0] = LocalKey(0,0,0);
-        return;
+        localKeys[0] = LocalKey(0,0,0);
+        return localKeys;
       }
 
       if (k==1)
       {
-        for (std::size_t i=0; i<size(); i++)
-          localKeys_[i] = LocalKey(i,3,0);
-        return;
+        for (std::size_t i=0; i<localKeys.size(); i++)
+          localKeys[i] = LocalKey(i,3,0);
+        return localKeys;
       }
 
       if (k==2)
       {
         // Vertex shape functions
-        localKeys_[0] = LocalKey(0,3,0);
-        localKeys_[1] = LocalKey(1,3,0);
-        localKeys_[2] = LocalKey(2,3,0);
-        localKeys_[3] = LocalKey(3,3,0);
-        localKeys_[4] = LocalKey(4,3,0);
-        localKeys_[5] = LocalKey(5,3,0);
+        localKeys[0] = LocalKey(0,3,0);
+        localKeys[1] = LocalKey(1,3,0);
+        localKeys[2] = LocalKey(2,3,0);
+        localKeys[3] = LocalKey(3,3,0);
+        localKeys[4] = LocalKey(4,3,0);
+        localKeys[5] = LocalKey(5,3,0);
 
         // Edge shape functions
-        localKeys_[6] = LocalKey(0,2,0);
-        localKeys_[7] = LocalKey(1,2,0);
-        localKeys_[8] = LocalKey(2,2,0);
-        localKeys_[9] = LocalKey(3,2,0);
-        localKeys_[10] = LocalKey(4,2,0);
-        localKeys_[11] = LocalKey(5,2,0);
-        localKeys_[12] = LocalKey(6,2,0);
-        localKeys_[13] = LocalKey(7,2,0);
-        localKeys_[14] = LocalKey(8,2,0);
+        localKeys[6] = LocalKey(0,2,0);
+        localKeys[7] = LocalKey(1,2,0);
+        localKeys[8] = LocalKey(2,2,0);
+        localKeys[9] = LocalKey(3,2,0);
+        localKeys[10] = LocalKey(4,2,0);
+        localKeys[11] = LocalKey(5,2,0);
+        localKeys[12] = LocalKey(6,2,0);
+        localKeys[13] = LocalKey(7,2,0);
+        localKeys[14] = LocalKey(8,2,0);
 
         // Quadrilateral sides shape functions
-        localKeys_[15] = LocalKey(0,1,0);
-        localKeys_[16] = LocalKey(1,1,0);
-        localKeys_[17] = LocalKey(2,1,0);
+        localKeys[15] = LocalKey(0,1,0);
+        localKeys[16] = LocalKey(1,1,0);
+        localKeys[17] = LocalKey(2,1,0);
 
-        return;
+        return localKeys;
       }
 
-      // Now: the general case
-      DUNE_THROW(NotImplemented, "LagrangePrismLocalCoefficients not implemented for order " << k);
+      // Not implemented, the constructor throws
+      return localKeys;
+    }
 
+    // The local keys shared by all instances
+    static const auto& localKeys ()
+    {
+      static constexpr auto keys = generateLocalKeys();
+      return keys;
+    }
+
+  public:
+    //! \brief Default constructor
+    LagrangePrismLocalCoefficients ()
+    {
+      if (k>2)
+        DUNE_THROW(NotImplemented, "LagrangePrismLocalCoefficients not implemented for order " << k);
     }
 
     //! number of coefficients
@@ -553,11 +567,8 @@ namespace Dune { namespace Impl
     //! get i-th index
     const LocalKey& localKey (std::size_t i) const
     {
-      return localKeys_[i];
+      return localKeys()[i];
     }
-
-  private:
-    std::vector<LocalKey> localKeys_;
   };
 
   /** \brief Evaluate the degrees of freedom of a Lagrange basis
@@ -633,52 +633,66 @@ namespace Dune { namespace Impl
   template<unsigned int k>
   class LagrangePyramidLocalCoefficients
   {
-  public:
-    //! \brief Default constructor
-    LagrangePyramidLocalCoefficients ()
-    : localKeys_(size())
+    // Compute the local keys of all degrees of freedom
+    static constexpr auto generateLocalKeys ()
     {
+      std::array<LocalKey,size()> localKeys;
+
       if (k==0)
       {
-        localKeys_[0] = LocalKey(0,0,0);
-        return;
+        localKeys[0] = LocalKey(0,0,0);
+        return localKeys;
       }
 
       if (k==1)
       {
-        for (std::size_t i=0; i<size(); i++)
-          localKeys_[i] = LocalKey(i,3,0);
-        return;
+        for (std::size_t i=0; i<localKeys.size(); i++)
+          localKeys[i] = LocalKey(i,3,0);
+        return localKeys;
       }
 
       if (k==2)
       {
         // Vertex shape functions
-        localKeys_[0] = LocalKey(0,3,0);
-        localKeys_[1] = LocalKey(1,3,0);
-        localKeys_[2] = LocalKey(2,3,0);
-        localKeys_[3] = LocalKey(3,3,0);
-        localKeys_[4] = LocalKey(4,3,0);
+        localKeys[0] = LocalKey(0,3,0);
+        localKeys[1] = LocalKey(1,3,0);
+        localKeys[2] = LocalKey(2,3,0);
+        localKeys[3] = LocalKey(3,3,0);
+        localKeys[4] = LocalKey(4,3,0);
 
         // Edge shape functions
-        localKeys_[5] = LocalKey(0,2,0);
-        localKeys_[6] = LocalKey(1,2,0);
-        localKeys_[7] = LocalKey(2,2,0);
-        localKeys_[8] = LocalKey(3,2,0);
-        localKeys_[9] = LocalKey(4,2,0);
-        localKeys_[10] = LocalKey(5,2,0);
-        localKeys_[11] = LocalKey(6,2,0);
-        localKeys_[12] = LocalKey(7,2,0);
+        localKeys[5] = LocalKey(0,2,0);
+        localKeys[6] = LocalKey(1,2,0);
+        localKeys[7] = LocalKey(2,2,0);
+        localKeys[8] = LocalKey(3,2,0);
+        localKeys[9] = LocalKey(4,2,0);
+        localKeys[10] = LocalKey(5,2,0);
+        localKeys[11] = LocalKey(6,2,0);
+        localKeys[12] = LocalKey(7,2,0);
 
         // base face shape function
-        localKeys_[13] = LocalKey(0,1,0);
+        localKeys[13] = LocalKey(0,1,0);
 
-        return;
+        return localKeys;
       }
 
-      // No general case
-      DUNE_THROW(NotImplemented, "LagrangePyramidLocalCoefficients for order " << k);
+      // Not implemented, the constructor throws
+      return localKeys;
+    }
 
+    // The local keys shared by all instances
+    static const auto& localKeys ()
+    {
+      static constexpr auto keys = generateLocalKeys();
+      return keys;
+    }
+
+  public:
+    //! \brief Default constructor
+    LagrangePyramidLocalCoefficients ()
+    {
+      if (k>2)
+        DUNE_THROW(NotImplemented, "LagrangePyramidLocalCoefficients for order " << k);
     }
 
     //! number of coefficients
@@ -693,11 +707,8 @@ namespace Dune { namespace Impl
     //! get i-th index
     const LocalKey& localKey (std::size_t i) const
     {
-      return localKeys_[i];
+      return localKeys()[i];
     }
-
-  private:
-    std::vector<LocalKey> localKeys_;
   };
 
   /** \brief Evaluate the degrees of freedom of a Lagrange basis
@@ -9,6 +9,7 @@
 #include <numeric>
 #include <algorithm>
 
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/exceptions.hh>
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
@@ -21,9 +22,14 @@
 #include <dune/localfunctions/common/localbasis.hh>
 #include <dune/localfunctions/common/localfiniteelementtraits.hh>
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
 
 namespace Dune { namespace Impl
 {
+  // Forward declaration
+  template<class LocalBasis>
+  struct StaticLocalBasis;
+
    /** \brief Lagrange shape functions of arbitrary order on the reference simplex
 
      Lagrange shape functions of arbitrary order have the property that
@@ -37,6 +43,7 @@ namespace Dune { namespace Impl
   template<class D, class R, unsigned int dim, unsigned int k>
   class LagrangeSimplexLocalBasis
   {
+    friend struct StaticLocalBasis<LagrangeSimplexLocalBasis<D,R,dim,k> >;
 
     // Compute the rescaled barycentric coordinates of x.
     // We rescale the simplex by k and then compute the
@@ -45,7 +52,7 @@ namespace Dune { namespace Impl
     // Notice that then the Lagrange points have the barycentric
     // coordinates (i_0,...,i_d) where i_j are all non-negative
     // integers satisfying the constraint sum i_j = k.
-    constexpr auto barycentric(const auto& x) const
+    static constexpr auto barycentric(const auto& x)
     {
       auto b = std::array<R,dim+1>{};
       b[dim] = k;
@@ -89,90 +96,133 @@ namespace Dune { namespace Impl
     using BarycentricMultiIndex = std::array<unsigned int,dim+1>;
 
 
-    // This computed the required partial derivative given by the multi-index
-    // beta of a product of a function given as a product of dim+1 derivatives
-    // of univariate Lagrange polynomials of the dim+1 barycentric coordinates.
-    // The polynomials in the product are specified as follows:
+    // This computes the partial derivative given by the multi-index beta of
+    // the product f(x) = \prod_{j=0}^{d} L_{i_j}(z_j) of univariate Lagrange
+    // polynomials of the rescaled barycentric coordinates z.
     //
     // The table L contains all required derivatives of all univariate
-    // polynomials evaluated at all barycentric coordinates.  The two
-    // multi-indices i and alpha encode that the polynomial for the
-    // j-th barycentric coordinate is the alpha-j-th derivative of
-    // the i_j-the Lagrange polynomial.
+    // polynomials evaluated at all barycentric coordinates, L[j][m][i] is the
+    // m-th derivative of the i-th polynomial at z_j.
+    //
+    // Since x_j only enters z_j = k x_j and z_d = k(1 - x_0 - ... - x_{d-1}),
+    // the Leibniz rule gives the closed form
     //
-    // Hence this method computes D_beta f(x) where f(x) is the product
-    // \f$f(x) = \prod_{j=0}^{d} L_{i_j}^{(alpha_j)}(x_j) \f$.
+    // D_beta f = k^{|beta|} \sum_{gamma <= beta} (-1)^{|beta-gamma|} L_{i_d}^{(|beta-gamma|)}(z_d)
+    //            \prod_{j=0}^{d-1} binom(beta_j,gamma_j) L_{i_j}^{(gamma_j)}(z_j)
+    //
+    // with (beta_0+1)*...*(beta_{d-1}+1) terms, instead of the 2^{|beta|} terms
+    // of applying the product and chain rule to one direction after the other.
     static constexpr R barycentricDerivative(
-        BarycentricMultiIndex beta,
+        const BarycentricMultiIndex& beta,
         const auto&L,
-        const BarycentricMultiIndex& i,
-        const BarycentricMultiIndex& alpha = {})
-    {
-      // If there are unprocessed derivatives left we search the first unprocessed
-      // partial derivative direction j and compute it using the product and chain rule.
-      // The remaining partial derivatives are forwarded to the recursion.
-      // Notice that the partial derivative of the last barycentric component
-      // wrt to the j-th component is -1 which is responsible for the second
-      // term in the sum. Furthermore we get the factor k due to the scaling of
-      // the simplex.
+        const BarycentricMultiIndex& i)
+    {
+      auto totalOrder = 0u;
       for(auto j : Dune::range(dim))
+        totalOrder += beta[j];
+      auto scale = R(1);
+      for(auto m = 0u; m < totalOrder; ++m)
+        scale *= k;
+
+      // Sum over all gamma <= beta, enumerated with the first direction running fastest
+      auto gamma = BarycentricMultiIndex{};
+      auto y = R(0);
+      while (true)
       {
-        if (beta[j] > 0)
+        auto remaining = totalOrder;
+        auto term = R(1);
+        for(auto j : Dune::range(dim))
         {
-          auto leftDerivatives = alpha;
-          auto rightDerivatives = alpha;
-          leftDerivatives[j]++;
-          rightDerivatives.back()++;
-          beta[j]--;
-          return (barycentricDerivative(beta, L, i, leftDerivatives) - barycentricDerivative(beta, L, i, rightDerivatives))*k;
+          term *= binomial(beta[j], gamma[j]) * L[j][gamma[j]][i[j]];
+          remaining -= gamma[j];
+        }
+        term *= L[dim][remaining][i[dim]];
+        y += (remaining % 2 == 0) ? term : -term;
+
+        auto j = 0u;
+        for (; j < dim; ++j)
+        {
+          if (gamma[j] < beta[j])
+          {
+            ++gamma[j];
+            break;
+          }
+          gamma[j] = 0;
         }
+        if (j == dim)
+          break;
       }
-      // If there are no unprocessed derivatives we can simply evaluate
-      // the product of the derivatives of the Lagrange polynomials with
-      // given indices i_j and derivative orders alpha_j
-      // Evaluate the product of the univariate Lagrange polynomials
-      // with given indices and orders.
-      auto y = R(1);
-      for(auto j : Dune::range(dim+1))
-        y *= L[j][alpha[j]][i[j]];
-      return y;
+      return y*scale;
     }
 
+    // Evaluate the partial derivatives given by order, whose total order
+    // 0 < totalOrder <= k is known at compile time
+    template<std::size_t totalOrder>
+    void partial(const std::array<unsigned int,dim>& order,
+                 const FieldVector<D,dim>& in,
+                 std::vector<FieldVector<R,1> >& out,
+                 Dune::index_constant<totalOrder>) const
+    {
+      // Compute rescaled barycentric coordinates of x
+      auto z = barycentric(in);
 
-  public:
-    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+      // L[j][m][i] is the m-th derivative of the i-th Lagrange polynomial at z[j]
+      auto L = std::array<std::array<std::array<R, k+1>, totalOrder+1>, dim+1>();
+      for (auto j : Dune::range(dim))
+        evaluateLagrangePolynomialDerivative(z[j], L[j], order[j]);
+      evaluateLagrangePolynomialDerivative(z[dim], L[dim], totalOrder);
 
-    /** \brief Number of shape functions
-     *
-     * See https://en.wikipedia.org/wiki/Figurate_number for an explanation of the formula
-     */
-    static constexpr unsigned int size ()
-    {
-      return binomial(k+dim,dim);
+      auto barycentricOrder = BarycentricMultiIndex{};
+      for (auto j : Dune::range(dim))
+        barycentricOrder[j] = order[j];
+      barycentricOrder[dim] = 0;
+
+      if constexpr (dim==1)
+      {
+        unsigned int n = 0;
+        for (auto i0 : Dune::range(k + 1))
+          for (auto i1 : std::array{k - i0})
+            out[n++] = barycentricDerivative(barycentricOrder, L, BarycentricMultiIndex{i0, i1});
+      }
+      if constexpr (dim==2)
+      {
+        unsigned int n=0;
+        for (auto i1 : Dune::range(k + 1))
+          for (auto i0 : Dune::range(k - i1 + 1))
+            for (auto i2 : std::array{k - i1 - i0})
+              out[n++] = barycentricDerivative(barycentricOrder, L, BarycentricMultiIndex{i0, i1, i2});
+      }
+      if constexpr (dim==3)
+      {
+        unsigned int n = 0;
+        for (auto i2 : Dune::range(k + 1))
+          for (auto i1 : Dune::range(k - i2 + 1))
+            for (auto i0 : Dune::range(k - i2 - i1 + 1))
+              for (auto i3 : std::array{k - i2 - i1 - i0})
+                out[n++] = barycentricDerivative(barycentricOrder, L, BarycentricMultiIndex{i0, i1, i2, i3});
+      }
     }
 
-    //! \brief Evaluate all shape functions
-    void evaluateFunction(const typename Traits::DomainType& x,
-                          std::vector<typename Traits::RangeType>& out) const
+    // Call g(n,value) with the value of the shape function n
+    template<class G>
+    void forEachValue(const FieldVector<D,dim>& x, G&& g) const
     {
-      out.resize(size());
-
       // Specialization for zero-order case
       if (k==0)
       {
-        out[0] = 1;
+        g(0, R(1));
         return;
       }
 
       // Specialization for first-order case
       if (k==1)
       {
-        out[0] = 1.0;
+        R value = 1.0;
         for (size_t i=0; i<dim; i++)
-        {
-          out[0]  -= x[i];
-          out[i+1] = x[i];
-        }
+          value -= x[i];
+        g(0, value);
+        for (size_t i=0; i<dim; i++)
+          g(i+1, R(x[i]));
         return;
       }
 
@@ -188,7 +238,7 @@ namespace Dune { namespace Impl
         unsigned int n = 0;
         for (auto i0 : Dune::range(k + 1))
           for (auto i1 : std::array{k - i0})
-            out[n++] = L[0][i0] * L[1][i1];
+            g(n++, L[0][i0] * L[1][i1]);
         return;
       }
       if (dim==2)
@@ -197,7 +247,7 @@ namespace Dune { namespace Impl
         for (auto i1 : Dune::range(k + 1))
           for (auto i0 : Dune::range(k - i1 + 1))
             for (auto i2 : std::array{k - i1 - i0})
-              out[n++] = L[0][i0] * L[1][i1] * L[2][i2];
+              g(n++, L[0][i0] * L[1][i1] * L[2][i2]);
         return;
       }
       if (dim==3)
@@ -207,39 +257,43 @@ namespace Dune { namespace Impl
           for (auto i1 : Dune::range(k - i2 + 1))
             for (auto i0 : Dune::range(k - i2 - i1 + 1))
               for (auto i3 : std::array{k - i2 - i1 - i0})
-                out[n++] = L[0][i0] * L[1][i1]  * L[2][i2] * L[3][i3];
+                g(n++, L[0][i0] * L[1][i1]  * L[2][i2] * L[3][i3]);
         return;
       }
 
       DUNE_THROW(NotImplemented, "LagrangeSimplexLocalBasis for k>=2 only implemented for dim<=3");
     }
 
-    /** \brief Evaluate Jacobian of all shape functions
-     *
-     * \param x Point in the reference simplex where to evaluation the Jacobians
-     * \param[out] out The Jacobians of all shape functions at the point x
-     */
-    void evaluateJacobian(const typename Traits::DomainType& x,
-                          std::vector<typename Traits::JacobianType>& out) const
+    // Call g(n,value,gradient) with the value and the gradient of the shape function n,
+    // the Lagrange polynomials and their derivatives are evaluated only once
+    template<class G>
+    void forEachValueAndGradient(const FieldVector<D,dim>& x, G&& g) const
     {
-      out.resize(size());
+      FieldVector<R,dim> gradient;
 
       // Specialization for k==0
       if (k==0)
       {
-        std::fill(out[0][0].begin(), out[0][0].end(), 0);
+        gradient = 0;
+        g(0, R(1), gradient);
         return;
       }
 
       // Specialization for k==1
       if (k==1)
       {
-        std::fill(out[0][0].begin(), out[0][0].end(), -1);
+        R value = 1.0;
+        for (size_t i=0; i<dim; i++)
+          value -= x[i];
+        gradient = -1;
+        g(0, value, gradient);
 
         for (unsigned int i=0; i<dim; i++)
+        {
           for (unsigned int j=0; j<dim; j++)
-            out[i+1][0][j] = (i==j);
-
+            gradient[j] = (i==j);
+          g(i+1, R(x[i]), gradient);
+        }
         return;
       }
 
@@ -258,7 +312,8 @@ namespace Dune { namespace Impl
         {
           for (auto i1 : std::array{k-i0})
           {
-            out[n][0][0] = (L[0][1][i0] * L[1][0][i1] - L[0][0][i0] * L[1][1][i1])*k;
+            gradient[0] = (L[0][1][i0] * L[1][0][i1] - L[0][0][i0] * L[1][1][i1])*k;
+            g(n, L[0][0][i0] * L[1][0][i1], gradient);
             ++n;
           }
         }
@@ -273,8 +328,9 @@ namespace Dune { namespace Impl
           {
             for (auto i2 : std::array{k - i1 - i0})
             {
-              out[n][0][0] = (L[0][1][i0] * L[1][0][i1] * L[2][0][i2] - L[0][0][i0] * L[1][0][i1] * L[2][1][i2])*k;
-              out[n][0][1] = (L[0][0][i0] * L[1][1][i1] * L[2][0][i2] - L[0][0][i0] * L[1][0][i1] * L[2][1][i2])*k;
+              gradient[0] = (L[0][1][i0] * L[1][0][i1] * L[2][0][i2] - L[0][0][i0] * L[1][0][i1] * L[2][1][i2])*k;
+              gradient[1] = (L[0][0][i0] * L[1][1][i1] * L[2][0][i2] - L[0][0][i0] * L[1][0][i1] * L[2][1][i2])*k;
+              g(n, L[0][0][i0] * L[1][0][i1] * L[2][0][i2], gradient);
               ++n;
             }
           }
@@ -292,9 +348,10 @@ namespace Dune { namespace Impl
             {
               for (auto i3 : std::array{k - i2 - i1 - i0})
               {
-                out[n][0][0] = (L[0][1][i0] * L[1][0][i1] * L[2][0][i2] * L[3][0][i3] - L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][1][i3])*k;
-                out[n][0][1] = (L[0][0][i0] * L[1][1][i1] * L[2][0][i2] * L[3][0][i3] - L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][1][i3])*k;
-                out[n][0][2] = (L[0][0][i0] * L[1][0][i1] * L[2][1][i2] * L[3][0][i3] - L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][1][i3])*k;
+                gradient[0] = (L[0][1][i0] * L[1][0][i1] * L[2][0][i2] * L[3][0][i3] - L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][1][i3])*k;
+                gradient[1] = (L[0][0][i0] * L[1][1][i1] * L[2][0][i2] * L[3][0][i3] - L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][1][i3])*k;
+                gradient[2] = (L[0][0][i0] * L[1][0][i1] * L[2][1][i2] * L[3][0][i3] - L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][1][i3])*k;
+                g(n, L[0][0][i0] * L[1][0][i1] * L[2][0][i2] * L[3][0][i3], gradient);
                 ++n;
               }
             }
@@ -307,6 +364,122 @@ namespace Dune { namespace Impl
       DUNE_THROW(NotImplemented, "LagrangeSimplexLocalBasis for k>=2 only implemented for dim<=3");
     }
 
+    // Call g(n,j,value) with the derivative of the shape function n in direction j
+    template<class G>
+    void forEachJacobianEntry(const FieldVector<D,dim>& x, G&& g) const
+    {
+      // The unused values are optimized away after inlining
+      forEachValueAndGradient(x, [&](auto n, const R&, const FieldVector<R,dim>& gradient) {
+        for (unsigned int j=0; j<dim; j++)
+          g(n, j, gradient[j]);
+      });
+    }
+
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    /** \brief Number of shape functions
+     *
+     * See https://en.wikipedia.org/wiki/Figurate_number for an explanation of the formula
+     */
+    static constexpr unsigned int size ()
+    {
+      return binomial(k+dim,dim);
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+      forEachValue(x, [&](auto n, const R& value) {
+        out[n] = value;
+      });
+    }
+
+    /** \brief Evaluate a linear combination of the shape functions
+     *
+     * The shape functions are combined while they are evaluated, without storing their values.
+     *
+     * \param x Point in the reference simplex where to evaluate the linear combination
+     * \param coefficients The coefficients of all shape functions
+     * \param[out] y The value of the linear combination at the point x
+     */
+    template<class Coefficients>
+    void contractFunction(const typename Traits::DomainType& x, const Coefficients& coefficients,
+                          typename Traits::RangeType& y) const
+    {
+      y = 0;
+      forEachValue(x, [&](auto n, const R& value) {
+        y[0] += coefficients[n] * value;
+      });
+    }
+
+    /** \brief Evaluate the Jacobian of a linear combination of the shape functions
+     *
+     * \param x Point in the reference simplex where to evaluate the Jacobian
+     * \param coefficients The coefficients of all shape functions
+     * \param[out] y The Jacobian of the linear combination at the point x
+     */
+    template<class Coefficients>
+    void contractJacobian(const typename Traits::DomainType& x, const Coefficients& coefficients,
+                          typename Traits::JacobianType& y) const
+    {
+      y = 0;
+      forEachJacobianEntry(x, [&](auto n, auto j, const R& value) {
+        y[0][j] += coefficients[n] * value;
+      });
+    }
+
+    /** \brief Add the shape functions tested against a value and a flux at a point
+     *
+     * The values and gradients of the shape functions are accumulated in a single traversal,
+     * which evaluates the barycentric Lagrange polynomials and their derivatives only once,
+     * without storing the values and gradients of all shape functions.
+     *
+     * \param x Point in the reference simplex where to evaluate the shape functions
+     * \param value The value q tested with the shape functions
+     * \param flux The flux F tested with the Jacobians of the shape functions
+     * \param[in,out] out The entry n is incremented by \f$q\phi_n(x) + F:\nabla\phi_n(x)\f$
+     */
+    template<class Out>
+    void addTransposedContraction(const typename Traits::DomainType& x, const typename Traits::RangeType& value,
+                                  const typename Traits::JacobianType& flux, Out& out) const
+    {
+      forEachValueAndGradient(x, [&](auto n, const R& phi, const FieldVector<R,dim>& gradient) {
+        out[n] += value[0] * phi + flux[0] * gradient;
+      });
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions
+     *
+     * \param x Point in the reference simplex where to evaluation the Jacobians
+     * \param[out] out The Jacobians of all shape functions at the point x
+     */
+    void evaluateJacobian(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+      forEachJacobianEntry(x, [&](auto n, auto j, const R& value) {
+        out[n][0][j] = value;
+      });
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions into one array per direction
+     *
+     * \param x Point in the reference simplex where to evaluation the Jacobians
+     * \param[out] out The derivative of shape function n in direction j is stored in out[j][n*stride]
+     * \param stride Distance of the derivatives of consecutive shape functions in the arrays
+     */
+    void evaluateJacobianSoA(const typename Traits::DomainType& x,
+                             const std::array<R*,dim>& out, std::size_t stride = 1) const
+    {
+      forEachJacobianEntry(x, [&](auto n, auto j, const R& value) {
+        out[j][n*stride] = value;
+      });
+    }
+
     /** \brief Evaluate partial derivatives of any order of all shape functions
      *
      * \param order Order of the partial derivatives, in the classic multi-index notation
@@ -355,46 +528,46 @@ namespace Dune { namespace Impl
       // static orders.
       auto supportedStaticOrders = Dune::range(Dune::index_constant<1>{}, Dune::index_constant<k+1>{});
       return Dune::Hybrid::switchCases(supportedStaticOrders, totalOrder, [&](auto staticTotalOrder) {
+        partial(order, in, out, staticTotalOrder);
+      });
+    }
 
-        // Compute rescaled barycentric coordinates of x
-        auto z = barycentric(in);
-
-        // L[j][m][i] is the m-th derivative of the i-th Lagrange polynomial at z[j]
-        auto L = std::array<std::array<std::array<R, k+1>, staticTotalOrder+1>, dim+1>();
-        for (auto j : Dune::range(dim))
-          evaluateLagrangePolynomialDerivative(z[j], L[j], order[j]);
-        evaluateLagrangePolynomialDerivative(z[dim], L[dim], totalOrder);
-
-        auto barycentricOrder = BarycentricMultiIndex{};
-        for (auto j : Dune::range(dim))
-          barycentricOrder[j] = order[j];
-        barycentricOrder[dim] = 0;
+    /** \brief Evaluate the partial derivatives of all shape functions given by a static multi-index
+     *
+     * In contrast to the method with a dynamic order, the order of the
+     * derivative is known at compile time, hence the case distinction and
+     * the sizes of all temporaries are resolved by the compiler.
+     *
+     * \tparam orders Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    template<unsigned int... orders>
+    void partial(const typename Traits::DomainType& in,
+                 std::vector<typename Traits::RangeType>& out) const
+    {
+      static_assert(sizeof...(orders) == dim, "The multi-index of the partial derivative needs dim entries");
+      constexpr unsigned int totalOrder = (orders + ... + 0u);
+      constexpr auto order = std::array<unsigned int,dim>{orders...};
 
-        if constexpr (dim==1)
-        {
-          unsigned int n = 0;
-          for (auto i0 : Dune::range(k + 1))
-            for (auto i1 : std::array{k - i0})
-              out[n++] = barycentricDerivative(barycentricOrder, L, BarycentricMultiIndex{i0, i1});
-        }
-        if constexpr (dim==2)
-        {
-          unsigned int n=0;
-          for (auto i1 : Dune::range(k + 1))
-            for (auto i0 : Dune::range(k - i1 + 1))
-              for (auto i2 : std::array{k - i1 - i0})
-                out[n++] = barycentricDerivative(barycentricOrder, L, BarycentricMultiIndex{i0, i1, i2});
-        }
-        if constexpr (dim==3)
-        {
-          unsigned int n = 0;
-          for (auto i2 : Dune::range(k + 1))
-            for (auto i1 : Dune::range(k - i2 + 1))
-              for (auto i0 : Dune::range(k - i2 - i1 + 1))
-                for (auto i3 : std::array{k - i2 - i1 - i0})
-                  out[n++] = barycentricDerivative(barycentricOrder, L, BarycentricMultiIndex{i0, i1, i2, i3});
-        }
-      });
+      out.resize(size());
+      if constexpr (totalOrder == 0)
+        evaluateFunction(in, out);
+      else if constexpr (totalOrder > k)
+      {
+        for(auto& out_i : out)
+          out_i = 0;
+      }
+      else if constexpr (totalOrder == 1)
+      {
+        constexpr auto direction = std::size_t(std::find(order.begin(), order.end(), 1u) - order.begin());
+        forEachJacobianEntry(in, [&](auto n, auto j, const R& value) {
+          if (j == direction)
+            out[n] = value;
+        });
+      }
+      else
+        partial(order, in, out, Dune::index_constant<totalOrder>{});
     }
 
     //! \brief Polynomial order of the shape functions
@@ -412,32 +585,37 @@ namespace Dune { namespace Impl
   template<unsigned int dim, unsigned int k>
   class LagrangeSimplexLocalCoefficients
   {
-  public:
-    //! \brief Default constructor
-    LagrangeSimplexLocalCoefficients ()
-    : localKeys_(size())
+    using LocalKeys = std::array<LocalKey,binomial(k+dim,dim)>;
+
+    // The number of tabulated numberings: the default one and one for each order of the vertices in 2d and 3d
+    static constexpr std::size_t numOrientations = (dim==2 || dim==3) ? 1 + factorial(dim+1) : 1;
+
+    // The local keys of the default numbering
+    static constexpr LocalKeys defaultLocalKeys ()
     {
+      LocalKeys localKeys;
+
       if (k==0)
       {
-        localKeys_[0] = LocalKey(0,0,0);
-        return;
+        localKeys[0] = LocalKey(0,0,0);
+        return localKeys;
       }
 
       if (k==1)
       {
-        for (std::size_t i=0; i<size(); i++)
-          localKeys_[i] = LocalKey(i,dim,0);
-        return;
+        for (std::size_t i=0; i<localKeys.size(); i++)
+          localKeys[i] = LocalKey(i,dim,0);
+        return localKeys;
       }
 
       if (dim==1)
       {
         // Order is at least 2 here
-        localKeys_[0] = LocalKey(0,1,0);          // vertex dof
+        localKeys[0] = LocalKey(0,1,0);          // vertex dof
         for (unsigned int i=1; i<k; i++)
-          localKeys_[i] = LocalKey(0,0,i-1);      // element dofs
-        localKeys_.back() = LocalKey(1,1,0);      // vertex dof
-        return;
+          localKeys[i] = LocalKey(0,0,i-1);      // element dofs
+        localKeys[k] = LocalKey(1,1,0);          // vertex dof
+        return localKeys;
       }
 
       if (dim==2)
@@ -449,99 +627,55 @@ namespace Dune { namespace Impl
           {
             if (i==0 && j==0)
             {
-              localKeys_[n++] = LocalKey(0,2,0);
+              localKeys[n++] = LocalKey(0,2,0);
               continue;
             }
             if (i==k && j==0)
             {
-              localKeys_[n++] = LocalKey(1,2,0);
+              localKeys[n++] = LocalKey(1,2,0);
               continue;
             }
             if (i==0 && j==k)
             {
-              localKeys_[n++] = LocalKey(2,2,0);
+              localKeys[n++] = LocalKey(2,2,0);
               continue;
             }
             if (j==0)
             {
-              localKeys_[n++] = LocalKey(0,1,i-1);
+              localKeys[n++] = LocalKey(0,1,i-1);
               continue;
             }
             if (i==0)
             {
-              localKeys_[n++] = LocalKey(1,1,j-1);
+              localKeys[n++] = LocalKey(1,1,j-1);
               continue;
             }
             if (i+j==k)
             {
-              localKeys_[n++] = LocalKey(2,1,j-1);
+              localKeys[n++] = LocalKey(2,1,j-1);
               continue;
             }
-            localKeys_[n++] = LocalKey(0,0,c++);
+            localKeys[n++] = LocalKey(0,0,c++);
           }
-        return;
+        return localKeys;
       }
 
       if (dim==3)
-      {
-        std::array<unsigned int, dim+1> vertexMap;
-        for (unsigned int i=0; i<=dim; i++)
-          vertexMap[i] = i;
-        generateLocalKeys(vertexMap);
-        return;
-      }
-      DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for k<=1 or dim<=3!");
-    }
-
-    /** Constructor for variants with permuted vertices
-     *
-     * \param vertexmap The permutation of the vertices.  This
-     *   can for instance be generated from the global indices of
-     *   the vertices by reducing those to the integers 0...dim
-     */
-    LagrangeSimplexLocalCoefficients (const std::array<unsigned int, dim+1> vertexMap)
-    : localKeys_(size())
-    {
-      if (dim!=2 && dim!=3)
-        DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for dim==2 and dim==3!");
+        return orientedLocalKeys(vertexOrder(0));
 
-      generateLocalKeys(vertexMap);
+      // Not implemented, the constructor throws
+      return localKeys;
     }
 
-
-    template<class VertexMap>
-    LagrangeSimplexLocalCoefficients(const VertexMap &vertexmap)
-    : localKeys_(size())
+    // The local keys of the numbering for the given permutation of the vertices
+    static constexpr LocalKeys orientedLocalKeys (const std::array<unsigned int, dim+1>& vertexMap)
     {
-      if (dim!=2 && dim!=3)
-        DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for dim==2 and dim==3!");
+      LocalKeys localKeys;
 
-      std::array<unsigned int, dim+1> vertexmap_array;
-      std::copy(vertexmap, vertexmap + dim + 1, vertexmap_array.begin());
-      generateLocalKeys(vertexmap_array);
-    }
-
-    //! number of coefficients
-    static constexpr std::size_t size ()
-    {
-      return binomial(k+dim,dim);
-    }
-
-    //! get i'th index
-    const LocalKey& localKey (std::size_t i) const
-    {
-      return localKeys_[i];
-    }
-
-  private:
-    std::vector<LocalKey> localKeys_;
-
-    void generateLocalKeys(const std::array<unsigned int, dim+1> vertexMap)
-    {
       if (k==0)
       {
-        localKeys_[0] = LocalKey(0,0,0);
-        return;
+        localKeys[0] = LocalKey(0,0,0);
+        return localKeys;
       }
 
       if (dim==2)
@@ -554,53 +688,53 @@ namespace Dune { namespace Impl
           {
             if (i==0 && j==0)
             {
-              localKeys_[n++] = LocalKey(0,2,0);
+              localKeys[n++] = LocalKey(0,2,0);
               continue;
             }
             if (i==k && j==0)
             {
-              localKeys_[n++] = LocalKey(1,2,0);
+              localKeys[n++] = LocalKey(1,2,0);
               continue;
             }
             if (i==0 && j==k)
             {
-              localKeys_[n++] = LocalKey(2,2,0);
+              localKeys[n++] = LocalKey(2,2,0);
               continue;
             }
             if (j==0)
             {
-              localKeys_[n++] = LocalKey(0,1,i-1);
+              localKeys[n++] = LocalKey(0,1,i-1);
               continue;
             }
             if (i==0)
             {
-              localKeys_[n++] = LocalKey(1,1,j-1);
+              localKeys[n++] = LocalKey(1,1,j-1);
               continue;
             }
             if (i+j==k)
             {
-              localKeys_[n++] = LocalKey(2,1,j-1);
+              localKeys[n++] = LocalKey(2,1,j-1);
               continue;
             }
-            localKeys_[n++] = LocalKey(0,0,c++);
+            localKeys[n++] = LocalKey(0,0,c++);
           }
 
         // Flip edge orientations, if requested
-        bool flip[3];
+        bool flip[3] = {};
         flip[0] = vertexMap[0] > vertexMap[1];
         flip[1] = vertexMap[0] > vertexMap[2];
         flip[2] = vertexMap[1] > vertexMap[2];
         for (std::size_t i=0; i<size(); i++)
-          if (localKeys_[i].codim()==1 && flip[localKeys_[i].subEntity()])
-            localKeys_[i].index(k-2-localKeys_[i].index());
+          if (localKeys[i].codim()==1 && flip[localKeys[i].subEntity()])
+            localKeys[i].index(k-2-localKeys[i].index());
 
-        return;
+        return localKeys;
       }
 
       if (dim!=3)
-        DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for dim==3!");
+        return localKeys;
 
-      unsigned int subindex[16];
+      unsigned int subindex[16] = {0};
       unsigned int codim_count[4] = {0};
       for (unsigned int m = 1; m < 16; ++m)
       {
@@ -611,13 +745,13 @@ namespace Dune { namespace Impl
       int a1 = (3*k + 12)*k + 11;
       int a2 = -3*k - 6;
       unsigned int dof_count[16] = {0};
-      unsigned int i[4];
+      unsigned int i[4] = {0};
       for (i[3] = 0; i[3] <= k; ++i[3])
         for (i[2] = 0; i[2] <= k - i[3]; ++i[2])
           for (i[1] = 0; i[1] <= k - i[2] - i[3]; ++i[1])
           {
             i[0] = k - i[1] - i[2] - i[3];
-            unsigned int j[4];
+            unsigned int j[4] = {0};
             unsigned int entity = 0;
             unsigned int codim = 0;
             for (unsigned int m = 0; m < 4; ++m)
@@ -628,9 +762,127 @@ namespace Dune { namespace Impl
             }
             int local_index = j[3]*(a1 + (a2 + j[3])*j[3])/6
                               + j[2]*(2*(k - j[3]) + 3 - j[2])/2 + j[1];
-            localKeys_[local_index] = LocalKey(subindex[entity], codim, dof_count[entity]++);
+            localKeys[local_index] = LocalKey(subindex[entity], codim, dof_count[entity]++);
           }
+      return localKeys;
+    }
+
+    // The order of the vertices with the given lexicographic rank
+    static constexpr std::array<unsigned int, dim+1> vertexOrder (std::size_t rank)
+    {
+      std::array<unsigned int, dim+1> available{}, vertexMap{};
+      for (unsigned int i=0; i<=dim; i++)
+        available[i] = i;
+      for (unsigned int i=0; i<=dim; i++)
+      {
+        const std::size_t f = factorial(dim-i);
+        std::size_t m = rank / f;
+        rank %= f;
+        vertexMap[i] = available[m];
+        for (; m<dim-i; m++)
+          available[m] = available[m+1];
+      }
+      return vertexMap;
+    }
+
+    // The lexicographic rank of the order of the given vertices
+    static constexpr std::size_t vertexOrderRank (const std::array<unsigned int, dim+1>& vertexMap)
+    {
+      std::size_t rank = 0;
+      for (unsigned int i=0; i<=dim; i++)
+        for (unsigned int j=i+1; j<=dim; j++)
+          if (vertexMap[i] > vertexMap[j])
+            rank += factorial(dim-i);
+      return rank;
+    }
+
+    // The local keys of all numberings, shared by all instances
+    static const LocalKeys& localKeys (std::size_t orientation)
+    {
+      static constexpr std::array<LocalKeys,numOrientations> localKeys = [] {
+        std::array<LocalKeys,numOrientations> result{};
+        result[0] = defaultLocalKeys();
+        for (std::size_t r=1; r<numOrientations; r++)
+          result[r] = orientedLocalKeys(vertexOrder(r-1));
+        return result;
+      }();
+      return localKeys[orientation];
+    }
+
+  public:
+    //! \brief Default constructor
+    LagrangeSimplexLocalCoefficients ()
+    {
+      if (k>1 && dim>3)
+        DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for k<=1 or dim<=3!");
+    }
+
+    /** Constructor for variants with permuted vertices
+     *
+     * \param vertexmap The permutation of the vertices.  This
+     *   can for instance be generated from the global indices of
+     *   the vertices by reducing those to the integers 0...dim
+     */
+    LagrangeSimplexLocalCoefficients (const std::array<unsigned int, dim+1> vertexMap)
+    {
+      if (dim!=2 && dim!=3)
+        DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for dim==2 and dim==3!");
+
+      orientation_ = 1 + vertexOrderRank(vertexMap);
+    }
+
+
+    template<class VertexMap>
+    LagrangeSimplexLocalCoefficients(const VertexMap &vertexmap)
+    {
+      if (dim!=2 && dim!=3)
+        DUNE_THROW(NotImplemented, "LagrangeSimplexLocalCoefficients only implemented for dim==2 and dim==3!");
+
+      std::array<unsigned int, dim+1> vertexmap_array;
+      std::copy(vertexmap, vertexmap + dim + 1, vertexmap_array.begin());
+      orientation_ = 1 + vertexOrderRank(vertexmap_array);
     }
+
+    //! number of coefficients
+    static constexpr std::size_t size ()
+    {
+      return binomial(k+dim,dim);
+    }
+
+    //! get i'th index
+    const LocalKey& localKey (std::size_t i) const
+    {
+      return localKeys(orientation_)[i];
+    }
+
+    /** \brief The local indices of the degrees of freedom of each subentity
+     *
+     * The tables are shared by all coefficients with the same vertex map,
+     * there is one for the default numbering and one for each order of the
+     * vertices in 2d and 3d.
+     */
+    const SubEntityDofTable& subEntityDofTable () const
+    {
+      static const std::vector<SubEntityDofTable> tables = [] {
+        std::vector<SubEntityDofTable> result;
+        result.emplace_back(LagrangeSimplexLocalCoefficients());
+        if constexpr (dim==2 || dim==3)
+        {
+          // All vertex orders in lexicographic order, the same order as in localKeys()
+          std::array<unsigned int, dim+1> vertexMap;
+          std::iota(vertexMap.begin(), vertexMap.end(), 0);
+          do
+            result.emplace_back(LagrangeSimplexLocalCoefficients(vertexMap));
+          while (std::next_permutation(vertexMap.begin(), vertexMap.end()));
+        }
+        return result;
+      }();
+      return tables[orientation_];
+    }
+
+  private:
+    // 0 for the default numbering, or one plus the lexicographic rank of the order of the vertices
+    unsigned int orientation_ = 0;
   };
 
   /** \brief Evaluate the degrees of freedom of a Lagrange basis
@@ -641,17 +893,10 @@ namespace Dune { namespace Impl
   class LagrangeSimplexLocalInterpolation
   {
     static const int kdiv = (LocalBasis::order() == 0 ? 1 : LocalBasis::order());
-  public:
 
-    /** \brief Evaluate a given function at the Lagrange nodes
-     *
-     * \tparam F Type of function to evaluate
-     * \tparam C Type used for the values of the function
-     * \param[in] f Function to evaluate
-     * \param[out] out Array of function values
-     */
-    template<typename F, typename C>
-    void interpolate (const F& f, std::vector<C>& out) const
+    // Call g(n,x) for all Lagrange nodes x in the order of the shape functions
+    template<class G>
+    static void forEachNode (G&& g)
     {
       constexpr auto dim = LocalBasis::Traits::dimDomain;
       constexpr auto k = LocalBasis::order();
@@ -659,13 +904,11 @@ namespace Dune { namespace Impl
 
       typename LocalBasis::Traits::DomainType x;
 
-      out.resize(LocalBasis::size());
-
       // Specialization for zero-order case
       if (k==0)
       {
         auto center = ReferenceElements<D,dim>::simplex().position(0,0);
-        out[0] = f(center);
+        g(0, center);
         return;
       }
 
@@ -674,7 +917,7 @@ namespace Dune { namespace Impl
       {
         // vertex 0
         std::fill(x.begin(), x.end(), 0);
-        out[0] = f(x);
+        g(0, x);
 
         // remaining vertices
         for (int i=0; i<dim; i++)
@@ -682,7 +925,7 @@ namespace Dune { namespace Impl
           for (int j=0; j<dim; j++)
             x[j] = (i==j);
 
-          out[i+1] = f(x);
+          g(i+1, x);
         }
         return;
       }
@@ -692,7 +935,7 @@ namespace Dune { namespace Impl
         for (unsigned int i=0; i<k+1; i++)
         {
           x[0] = ((D)i)/k;
-          out[i] = f(x);
+          g(i, x);
         }
         return;
       }
@@ -704,7 +947,7 @@ namespace Dune { namespace Impl
           for (unsigned int i=0; i<=k-j; i++)
           {
             x = { ((D)i)/k, ((D)j)/k };
-            out[n] = f(x);
+            g(n, x);
             n++;
           }
         return;
@@ -721,11 +964,48 @@ namespace Dune { namespace Impl
             x[0] = ((D)i0)/((D)kdiv);
             x[1] = ((D)i1)/((D)kdiv);
             x[2] = ((D)i2)/((D)kdiv);
-            out[n] = f(x);
+            g(n, x);
             n++;
           }
     }
 
+  public:
+
+    /** \brief Evaluate a given function at the Lagrange nodes
+     *
+     * \tparam F Type of function to evaluate
+     * \tparam C Type used for the values of the function
+     * \param[in] f Function to evaluate
+     * \param[out] out Array of function values
+     */
+    template<typename F, typename C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      out.resize(LocalBasis::size());
+      forEachNode([&](auto n, const auto& x) {
+        out[n] = f(x);
+      });
+    }
+
+    /** \brief Evaluate several functions at the Lagrange nodes at once
+     *
+     * \tparam F Type of function returning the values of all functions, e.g. as std::array
+     * \tparam C Type used for the values of the functions
+     * \param[in] f Function to evaluate
+     * \param[out] out Matrix of function values, the column j contains the coefficients of function j
+     */
+    template<typename F, typename C>
+    void interpolateFields (const F& f, DynamicMatrix<C>& out) const
+    {
+      forEachNode([&](auto n, const auto& x) {
+        const auto& values = f(x);
+        if (n == 0)
+          out.resize(LocalBasis::size(), values.size());
+        for (std::size_t j=0; j<values.size(); j++)
+          out[n][j] = values[j];
+      });
+    }
+
   };
 
 } }    // namespace Dune::Impl
@@ -0,0 +1,343 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_LAGRANGE_STATICTABULATION_HH
+#define DUNE_LOCALFUNCTIONS_LAGRANGE_STATICTABULATION_HH
+
+#include <array>
+#include <cstddef>
+
+#include <dune/common/math.hh>
+
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/lagrange/p0/p0localbasis.hh>
+
+namespace Dune
+{
+
+  /** \brief A quadrature rule whose points and weights are known at compile time
+   *
+   * In contrast to the rules of QuadratureRules this is a literal type, hence
+   * a rule can be a constexpr variable and the shape functions can be
+   * tabulated at its points by tabulateFunction() and tabulateJacobian() at
+   * compile time.
+   *
+   * \tparam D Type of the coordinates and weights
+   * \tparam dim Dimension of the reference element
+   * \tparam n Number of points
+   */
+  template<class D, int dim, std::size_t n>
+  struct StaticQuadratureRule
+  {
+    //! Type of a point
+    using Point = std::array<D,dim>;
+
+    //! Number of points
+    static constexpr std::size_t size ()
+    {
+      return n;
+    }
+
+    std::array<Point,n> points;
+    std::array<D,n> weights;
+  };
+
+
+  namespace Impl
+  {
+
+    // The Gauss-Legendre points and weights on [0,1] with m points
+    template<class D, std::size_t m>
+    constexpr std::array<std::array<D,2>,m> gaussLegendre1d ()
+    {
+      static_assert(m >= 1 and m <= 3, "Static Gauss rules are only available with up to 3 points per direction");
+      if constexpr (m == 1)
+        return {{ {D(0.5), D(1)} }};
+      else if constexpr (m == 2)
+        return {{ {D(0.211324865405187117745425609749), D(0.5)},
+                  {D(0.788675134594812882254574390251), D(0.5)} }};
+      else
+        return {{ {D(0.112701665379258311482073460022), D(5)/D(18)},
+                  {D(0.5), D(8)/D(18)},
+                  {D(0.887298334620741688517926539978), D(5)/D(18)} }};
+    }
+
+    // Values and first derivatives of the Lagrange shape functions of P0,
+    // and of the Lagrange shape functions of Pk and Qk in the order of
+    // LagrangeSimplexLocalBasis and LagrangeCubeLocalBasis, evaluated in
+    // constant expressions by the constexpr polynomial helpers of these bases
+    template<class LocalBasis>
+    struct StaticLocalBasis;
+
+    template<class D, class R, int dim>
+    struct StaticLocalBasis<P0LocalBasis<D,R,dim> >
+    {
+      static constexpr std::size_t size = 1;
+
+      static constexpr std::array<R,size> values (const std::array<D,dim>&)
+      {
+        return {R(1)};
+      }
+
+      static constexpr std::array<std::array<R,dim>,size> gradients (const std::array<D,dim>&)
+      {
+        return {};
+      }
+    };
+
+    template<class D, class R, unsigned int dim, unsigned int k>
+    struct StaticLocalBasis<LagrangeSimplexLocalBasis<D,R,dim,k> >
+    {
+      using Basis = LagrangeSimplexLocalBasis<D,R,dim,k>;
+
+      static constexpr std::size_t size = binomial(k+dim,dim);
+
+      // Call g(n, i) for the indices i of the univariate Lagrange polynomials of the
+      // rescaled barycentric coordinates of all shape functions, in the order of the basis
+      template<class G>
+      static constexpr void forEachNode (G&& g)
+      {
+        std::array<unsigned int,dim+1> i{};
+        std::size_t n = 0;
+        for (std::size_t l = 0; l < power(std::size_t(k+1), dim); ++l)
+        {
+          unsigned int rest = l, sum = 0;
+          for (unsigned int j = 0; j < dim; ++j)
+          {
+            i[j] = rest % (k+1);
+            rest /= (k+1);
+            sum += i[j];
+          }
+          if (sum > k)
+            continue;
+          i[dim] = k - sum;
+          g(n++, i);
+        }
+      }
+
+      static constexpr std::array<R,size> values (const std::array<D,dim>& x)
+      {
+        const auto z = Basis::barycentric(x);
+        std::array<std::array<R,k+1>,dim+1> L{};
+        for (unsigned int j = 0; j <= dim; ++j)
+          Basis::evaluateLagrangePolynomials(z[j], L[j]);
+
+        std::array<R,size> out{};
+        forEachNode([&](std::size_t n, const auto& i) {
+          R y = 1;
+          for (unsigned int j = 0; j <= dim; ++j)
+            y *= L[j][i[j]];
+          out[n] = y;
+        });
+        return out;
+      }
+
+      static constexpr std::array<std::array<R,dim>,size> gradients (const std::array<D,dim>& x)
+      {
+        // L[j][m][i] is the m-th derivative of the i-th Lagrange polynomial at z[j]
+        const auto z = Basis::barycentric(x);
+        std::array<std::array<std::array<R,k+1>,2>,dim+1> L{};
+        for (unsigned int j = 0; j <= dim; ++j)
+          Basis::evaluateLagrangePolynomialDerivative(z[j], L[j], 1);
+
+        std::array<std::array<R,dim>,size> out{};
+        forEachNode([&](std::size_t n, const auto& i) {
+          // Derivatives of the product with respect to the rescaled barycentric coordinates
+          std::array<R,dim+1> d{};
+          for (unsigned int m = 0; m <= dim; ++m)
+          {
+            d[m] = L[m][1][i[m]];
+            for (unsigned int j = 0; j <= dim; ++j)
+              if (j != m)
+                d[m] *= L[j][0][i[j]];
+          }
+          for (unsigned int j = 0; j < dim; ++j)
+            out[n][j] = (d[j] - d[dim])*k;
+        });
+        return out;
+      }
+    };
+
+    template<class D, class R, unsigned int dim, unsigned int k>
+    struct StaticLocalBasis<LagrangeCubeLocalBasis<D,R,dim,k> >
+    {
+      using Basis = LagrangeCubeLocalBasis<D,R,dim,k>;
+
+      static constexpr std::size_t size = power(k+1,dim);
+
+      static constexpr std::array<R,size> values (const std::array<D,dim>& x)
+      {
+        std::array<R,size> out{};
+        for (std::size_t n = 0; n < size; ++n)
+        {
+          R y = 1;
+          for (unsigned int j = 0, rest = n; j < dim; ++j, rest /= (k+1))
+            y *= Basis::p(rest % (k+1), x[j]);
+          out[n] = y;
+        }
+        return out;
+      }
+
+      static constexpr std::array<std::array<R,dim>,size> gradients (const std::array<D,dim>& x)
+      {
+        std::array<std::array<R,dim>,size> out{};
+        for (std::size_t n = 0; n < size; ++n)
+          for (unsigned int l = 0; l < dim; ++l)
+          {
+            R y = 1;
+            for (unsigned int j = 0, rest = n; j < dim; ++j, rest /= (k+1))
+              y *= (j == l) ? Basis::dp(rest % (k+1), x[j]) : Basis::p(rest % (k+1), x[j]);
+            out[n][l] = y;
+          }
+        return out;
+      }
+    };
+
+  } // namespace Impl
+
+
+  /** \brief Gauss-Legendre rule on the reference cube that is exact for polynomials of the given order in each direction
+   *
+   * The points are the tensor products of the points in each direction, with
+   * the first direction running fastest.
+   *
+   * \tparam D Type of the coordinates and weights
+   * \tparam dim Dimension of the reference cube
+   * \tparam order Polynomial order for which the rule is exact, at most 5
+   */
+  template<class D, int dim, int order>
+  constexpr auto staticCubeQuadratureRule ()
+  {
+    constexpr std::size_t m = order/2 + 1;
+    constexpr auto rule1d = Impl::gaussLegendre1d<D,m>();
+    StaticQuadratureRule<D,dim,power(m,std::size_t(dim))> rule{};
+    for (std::size_t q = 0; q < rule.size(); ++q)
+    {
+      rule.weights[q] = 1;
+      for (std::size_t j = 0, rest = q; j < std::size_t(dim); ++j, rest /= m)
+      {
+        rule.points[q][j] = rule1d[rest % m][0];
+        rule.weights[q] *= rule1d[rest % m][1];
+      }
+    }
+    return rule;
+  }
+
+  /** \brief Quadrature rule on the reference simplex that is exact for polynomials of the given total order
+   *
+   * The rule of order 0 and 1 is the midpoint rule, the rule of order 2 has
+   * dim+1 symmetric points in the interior.
+   *
+   * \tparam D Type of the coordinates and weights
+   * \tparam dim Dimension of the reference simplex, 1, 2 or 3
+   * \tparam order Polynomial order for which the rule is exact, at most 2
+   */
+  template<class D, int dim, int order>
+  constexpr auto staticSimplexQuadratureRule ()
+  {
+    static_assert(dim >= 1 and dim <= 3, "Static simplex rules are only available for dim = 1, 2, 3");
+    static_assert(order <= 2, "Static simplex rules are only available up to order 2");
+    constexpr D volume = D(1) / factorial(dim);
+
+    if constexpr (order <= 1)
+    {
+      StaticQuadratureRule<D,dim,1> rule{};
+      rule.points[0].fill(D(1)/(dim+1));
+      rule.weights[0] = volume;
+      return rule;
+    }
+    else if constexpr (dim == 1)
+      return staticCubeQuadratureRule<D,1,order>();
+    else
+    {
+      // Points with barycentric coordinates (b,a,...,a) and all permutations
+      constexpr D a = (dim == 2) ? D(1)/D(6) : D(0.138196601125010515179541316563);
+      constexpr D b = 1 - dim*a;
+      StaticQuadratureRule<D,dim,dim+1> rule{};
+      for (std::size_t q = 0; q <= std::size_t(dim); ++q)
+      {
+        rule.points[q].fill(a);
+        if (q > 0)
+          rule.points[q][q-1] = b;
+        rule.weights[q] = volume / (dim+1);
+      }
+      return rule;
+    }
+  }
+
+  /** \brief Evaluate all shape functions at a point in a constant expression
+   *
+   * Available for P0LocalBasis and the bases of LagrangeSimplexLocalFiniteElement
+   * and LagrangeCubeLocalFiniteElement. The shape functions are evaluated by
+   * the same one-dimensional Lagrange polynomials as in the local basis.
+   *
+   * \tparam LocalBasis The local basis
+   * \param x The point in the reference element
+   * \returns The values of all shape functions
+   */
+  template<class LocalBasis, class D, std::size_t dim>
+  constexpr auto evaluateFunctionStatic (const std::array<D,dim>& x)
+  {
+    static_assert(dim == std::size_t(LocalBasis::Traits::dimDomain));
+    return Impl::StaticLocalBasis<LocalBasis>::values(x);
+  }
+
+  /** \brief Evaluate the gradients of all shape functions at a point in a constant expression
+   *
+   * \tparam LocalBasis The local basis, see evaluateFunctionStatic()
+   * \param x The point in the reference element
+   * \returns The gradients of all shape functions
+   */
+  template<class LocalBasis, class D, std::size_t dim>
+  constexpr auto evaluateJacobianStatic (const std::array<D,dim>& x)
+  {
+    static_assert(dim == std::size_t(LocalBasis::Traits::dimDomain));
+    return Impl::StaticLocalBasis<LocalBasis>::gradients(x);
+  }
+
+  /** \brief Tabulate the values of all shape functions at all points of a quadrature rule
+   *
+   * Assigned to a constexpr variable, e.g.
+   * \code
+   * static constexpr auto rule = staticCubeQuadratureRule<double,2,3>();
+   * static constexpr auto values = tabulateFunction<Basis>(rule);
+   * \endcode
+   * the table is computed by the compiler and the entries values[q][i] of the
+   * shape function i at the point q are constants in the assembly kernels.
+   *
+   * \tparam LocalBasis The local basis, see evaluateFunctionStatic()
+   * \param rule The quadrature rule
+   */
+  template<class LocalBasis, class D, int dim, std::size_t n>
+  constexpr auto tabulateFunction (const StaticQuadratureRule<D,dim,n>& rule)
+  {
+    using Basis = Impl::StaticLocalBasis<LocalBasis>;
+    std::array<decltype(Basis::values(rule.points[0])),n> table{};
+    for (std::size_t q = 0; q < n; ++q)
+      table[q] = Basis::values(rule.points[q]);
+    return table;
+  }
+
+  /** \brief Tabulate the gradients of all shape functions at all points of a quadrature rule
+   *
+   * The entry table[q][i][j] is the derivative of the shape function i in
+   * direction j at the point q.
+   *
+   * \tparam LocalBasis The local basis, see evaluateFunctionStatic()
+   * \param rule The quadrature rule
+   */
+  template<class LocalBasis, class D, int dim, std::size_t n>
+  constexpr auto tabulateJacobian (const StaticQuadratureRule<D,dim,n>& rule)
+  {
+    using Basis = Impl::StaticLocalBasis<LocalBasis>;
+    std::array<decltype(Basis::gradients(rule.points[0])),n> table{};
+    for (std::size_t q = 0; q < n; ++q)
+      table[q] = Basis::gradients(rule.points[q]);
+    return table;
+  }
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_LAGRANGE_STATICTABULATION_HH
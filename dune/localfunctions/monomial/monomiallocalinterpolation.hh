@@ -7,6 +7,7 @@
 
 #include <vector>
 
+#include <dune/common/dynmatrix.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
@@ -81,6 +82,42 @@ namespace Dune
       }
     }
 
+    /** \brief Determine coefficients interpolating several functions at once
+     *
+     * The function f returns the values of all functions, e.g. as std::array.
+     * The local basis is evaluated once per quadrature point and the column j
+     * of out contains the coefficients of the L^2 projection of function j.
+     */
+    template<typename F, typename C>
+    void interpolateFields (const F& f, DynamicMatrix<C>& out) const
+    {
+      // The moments of all functions with respect to the local basis
+      DynamicMatrix<C> moments;
+      std::vector<R> base;
+      bool first = true;
+
+      const QRiterator qrend = qr.end();
+      for(QRiterator qrit = qr.begin(); qrit != qrend; ++qrit) {
+        const auto& values = f(qrit->position());
+        if (first) {
+          moments.resize(size, values.size(), 0);
+          first = false;
+        }
+
+        lb.evaluateFunction(qrit->position(),base);
+
+        for(unsigned int i = 0; i < size; ++i)
+          for(std::size_t j = 0; j < values.size(); ++j)
+            moments[i][j] += qrit->weight() * R(values[j]) * base[i];
+      }
+
+      out.resize(size, moments.M(), 0);
+      for(unsigned int i = 0; i < size; ++i)
+        for(unsigned int k = 0; k < size; ++k)
+          for(std::size_t j = 0; j < moments.M(); ++j)
+            out[i][j] += Minv[i][k] * moments[k][j];
+    }
+
   private:
     GeometryType gt;
     const LB &lb;
@@ -6,6 +6,7 @@
 #define DUNE_LOCALFUNCTIONS_NEDELEC_NEDELEC1STKINDCUBE_HH
 
 #include <numeric>
+#include <type_traits>
 
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
@@ -17,6 +18,8 @@
 #include <dune/localfunctions/common/localbasis.hh>
 #include <dune/localfunctions/common/localfiniteelementtraits.hh>
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
+#include <dune/localfunctions/utility/tensorproductvectorcube.hh>
 
 namespace Dune
 {
@@ -397,6 +400,13 @@ namespace Impl
       return localKey_[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(Nedelec1stKindCubeLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> localKey_;
   };
@@ -480,8 +490,17 @@ namespace Impl
    * and by Kirby, Logg, Rognes, Terrel, "Common and unusual finite elements",
    * https://doi.org/10.1007/978-3-642-23099-8_3
    *
+   * The elements of order k>1 are constructed as tensor products of univariate
+   * polynomials, see Impl::TensorProductVectorCubeStructure. Their degrees of
+   * freedom are the moments of the tangential components on the edges against
+   * Legendre polynomials, followed by the moments on the faces and in the interior.
+   *
    * \note These shape functions are implemented for the reference cube only!
    *   The transformation to other cubes has to be done by the user.
+   *   Flipping the orientation of an edge by the constructor argument reverses
+   *   its tangent and the parametrization of the edge moments. The moments on
+   *   the faces of hexahedra are taken with respect to the local coordinates,
+   *   so there the local coordinates of neighboring elements must agree.
    *
    * \ingroup Nedelec
    *
@@ -495,12 +514,16 @@ namespace Impl
   class Nedelec1stKindCubeLocalFiniteElement
   {
   public:
-    using Traits = LocalFiniteElementTraits<Impl::Nedelec1stKindCubeLocalBasis<D,R,dim,k>,
-                                            Impl::Nedelec1stKindCubeLocalCoefficients<dim,k>,
-                                            Impl::Nedelec1stKindCubeLocalInterpolation<Impl::Nedelec1stKindCubeLocalBasis<D,R,dim,k> > >;
+    using Traits = std::conditional_t<k==1,
+      LocalFiniteElementTraits<Impl::Nedelec1stKindCubeLocalBasis<D,R,dim,k>,
+                               Impl::Nedelec1stKindCubeLocalCoefficients<dim,k>,
+                               Impl::Nedelec1stKindCubeLocalInterpolation<Impl::Nedelec1stKindCubeLocalBasis<D,R,dim,k> > >,
+      LocalFiniteElementTraits<Impl::TensorProductVectorCubeLocalBasis<D,R,dim,k,false>,
+                               Impl::TensorProductVectorCubeLocalCoefficients<dim,k,false>,
+                               Impl::TensorProductVectorCubeLocalInterpolation<Impl::TensorProductVectorCubeLocalBasis<D,R,dim,k,false> > > >;
 
     static_assert(dim==2 || dim==3, "Nedelec elements are only implemented for 2d and 3d elements.");
-    static_assert(k==1,   "Nedelec elements of the first kind are currently only implemented for order k==1.");
+    static_assert(k>=1,   "The order of Nedelec elements of the first kind starts at k==1.");
 
     /** \brief Default constructor
      */
@@ -16,6 +16,7 @@
 #include <dune/localfunctions/common/localbasis.hh>
 #include <dune/localfunctions/common/localfiniteelementtraits.hh>
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
 
 namespace Dune
 {
@@ -303,6 +304,13 @@ namespace Impl
       return localKey_[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(Nedelec1stKindSimplexLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> localKey_;
   };
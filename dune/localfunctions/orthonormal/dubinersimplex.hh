@@ -0,0 +1,321 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_ORTHONORMAL_DUBINERSIMPLEX_HH
+#define DUNE_LOCALFUNCTIONS_ORTHONORMAL_DUBINERSIMPLEX_HH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/hierarchical/integratedlegendre.hh>
+#include <dune/localfunctions/utility/dglocalcoefficients.hh>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief Orthonormal Dubiner (Proriol-Koornwinder) basis on the reference simplex
+   *
+   * The shape functions are the products
+   * \f[ \phi_\alpha(x) = c_\alpha \prod_{i=0}^{dim-1} t_i^{\alpha_i} P^{(a_i,0)}_{\alpha_i}\Big(\frac{2x_i-t_i}{t_i}\Big),
+   *     \qquad t_i = 1-\sum_{j>i}x_j, \quad a_i = 2(\alpha_0+\dots+\alpha_{i-1})+i, \f]
+   * of Jacobi polynomials in collapsed coordinates. The factors are evaluated
+   * as scaled Jacobi polynomials with their three-term recurrence, such that
+   * no division by \f$t_i\f$ is required and the evaluation is stable up to the
+   * vertices. The squared \f$L^2\f$ norm of the unnormalized products is
+   * \f$\prod_i 1/(2\alpha_i+a_i+1)\f$.
+   *
+   * The shape functions are ordered by total degree, such that the first
+   * \f$\binom{p+dim}{dim}\f$ functions span the polynomials of degree p.
+   *
+   * \tparam D Type to represent the field in the domain
+   * \tparam R Type to represent the field in the range
+   * \tparam dim Dimension of the reference simplex
+   * \tparam k Polynomial order
+   */
+  template<class D, class R, unsigned int dim, unsigned int k>
+  class DubinerSimplexLocalBasis
+  {
+    // Tables of the scaled Jacobi polynomials of parameter 2s+i in direction i for all s,
+    // together with their derivatives with respect to both arguments
+    struct Tables
+    {
+      using Table = std::array<std::array<std::array<R,k+1>,k+1>,dim>;
+      Table P, Px, Pt;
+    };
+
+    static Tables evaluateTables (const FieldVector<D,dim>& x)
+    {
+      Tables tables;
+      R t = 1;
+      for (int i=dim-1; i>=0; --i)
+      {
+        // Only the parameter 0 is needed in the first direction
+        for (unsigned int s=0; s<=((i == 0) ? 0 : k); ++s)
+          evaluateScaledJacobi(2*s+i, k-s, R(2*x[i]-t), t, tables.P[i][s], tables.Px[i][s], tables.Pt[i][s]);
+        t -= x[i];
+      }
+      return tables;
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return binomial(k+dim, dim);
+    }
+
+    //! \brief Return the multi-indices of all shape functions, ordered by total degree
+    static constexpr auto multiIndices ()
+    {
+      std::array<std::array<unsigned int,dim>,size()> result{};
+      std::size_t n = 0;
+      for (unsigned int p=0; p<=k; ++p)
+      {
+        std::array<unsigned int,dim> alpha{};
+        while (true)
+        {
+          unsigned int degree = 0;
+          for (unsigned int i=0; i<dim; ++i)
+            degree += alpha[i];
+          if (degree == p)
+            result[n++] = alpha;
+
+          unsigned int i = 0;
+          for (; i<dim; ++i)
+          {
+            if (++alpha[i] <= p)
+              break;
+            alpha[i] = 0;
+          }
+          if (i == dim)
+            break;
+        }
+      }
+      return result;
+    }
+
+    //! \brief Default constructor computing the normalization constants
+    DubinerSimplexLocalBasis ()
+    {
+      using std::sqrt;
+      for (auto n : Dune::range(size()))
+      {
+        R scale = 1;
+        unsigned int a = 0;
+        for (auto i : Dune::range(dim))
+        {
+          scale *= 2*multiIndices_[n][i] + a + 1;
+          a += 2*multiIndices_[n][i] + 1;
+        }
+        scale_[n] = sqrt(scale);
+      }
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+      const auto tables = evaluateTables(x);
+      for (auto n : Dune::range(size()))
+      {
+        const auto& alpha = multiIndices_[n];
+        R y = scale_[n];
+        unsigned int s = 0;
+        for (auto i : Dune::range(dim))
+        {
+          y *= tables.P[i][s][alpha[i]];
+          s += alpha[i];
+        }
+        out[n] = y;
+      }
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions
+     *
+     * The factor of direction i depends on \f$x_i\f$ through its first argument
+     * \f$2x_i-t_i\f$ and on \f$x_l\f$, l>i, through both arguments.
+     */
+    void evaluateJacobian (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+      const auto tables = evaluateTables(x);
+      for (auto n : Dune::range(size()))
+      {
+        const auto& alpha = multiIndices_[n];
+        std::array<R,dim> value, dx, dt;
+        unsigned int s = 0;
+        for (auto i : Dune::range(dim))
+        {
+          value[i] = tables.P[i][s][alpha[i]];
+          dx[i] = tables.Px[i][s][alpha[i]];
+          dt[i] = tables.Pt[i][s][alpha[i]];
+          s += alpha[i];
+        }
+
+        for (auto l : Dune::range(dim))
+        {
+          R y = 0;
+          for (unsigned int i=0; i<=l; ++i)
+          {
+            R z = (i == l) ? 2*dx[i] : dx[i] - dt[i];
+            for (auto j : Dune::range(dim))
+              if (j != i)
+                z *= value[j];
+            y += z;
+          }
+          out[n][0][l] = scale_[n]*y;
+        }
+      }
+    }
+
+    //! \brief Evaluate partial derivatives of all shape functions, only orders up to one are implemented
+    void partial (const std::array<unsigned int,dim>& order,
+                  const typename Traits::DomainType& in,
+                  std::vector<typename Traits::RangeType>& out) const
+    {
+      auto totalOrder = std::accumulate(order.begin(), order.end(), 0u);
+      if (totalOrder == 0)
+        evaluateFunction(in, out);
+      else if (totalOrder == 1)
+      {
+        auto direction = std::distance(order.begin(), std::find(order.begin(), order.end(), 1u));
+        std::vector<typename Traits::JacobianType> jacobians;
+        evaluateJacobian(in, jacobians);
+        out.resize(size());
+        for (auto n : Dune::range(size()))
+          out[n] = jacobians[n][0][direction];
+      }
+      else
+        DUNE_THROW(NotImplemented, "Desired derivative order is not implemented");
+    }
+
+    //! \brief Polynomial order of the shape functions
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+
+  private:
+    static constexpr auto multiIndices_ = multiIndices();
+    std::array<R,size()> scale_;
+  };
+
+  /** \brief L2 projection onto the orthonormal Dubiner basis
+   *
+   * Since the basis is orthonormal, the coefficients are the moments of the
+   * function against the shape functions.
+   *
+   * \tparam LB The local basis
+   */
+  template<class LB>
+  class DubinerSimplexLocalInterpolation
+  {
+    static constexpr auto dim = LB::Traits::dimDomain;
+    using D = typename LB::Traits::DomainFieldType;
+
+  public:
+    //! \brief Compute the moments of a given function
+    template<class F, class C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      out.resize(LB::size());
+      std::fill(out.begin(), out.end(), 0);
+      std::vector<typename LB::Traits::RangeType> values;
+      for (const auto& qp : QuadratureRules<D,dim>::rule(GeometryTypes::simplex(dim), 2*LB::order()))
+      {
+        basis_.evaluateFunction(qp.position(), values);
+        typename LB::Traits::RangeType y = f(qp.position());
+        for (auto i : Dune::range(LB::size()))
+          out[i] += qp.weight()*y[0]*values[i][0];
+      }
+    }
+
+  private:
+    LB basis_;
+  };
+
+} }    // namespace Dune::Impl
+
+namespace Dune
+{
+
+  /** \brief Discontinuous finite element with the orthonormal Dubiner basis on simplices
+   *
+   * In contrast to OrthonormalLocalFiniteElement, which orthonormalizes monomials,
+   * the shape functions are evaluated directly by the recurrences of the Jacobi
+   * polynomials, see Impl::DubinerSimplexLocalBasis. Construction does not require
+   * any setup and evaluation costs a number of operations proportional to the
+   * number of shape functions.
+   *
+   * \ingroup Orthonormal
+   *
+   * \tparam D Type to represent the field in the domain
+   * \tparam R Type to represent the field in the range
+   * \tparam dim Dimension of the reference simplex
+   * \tparam k Polynomial order
+   */
+  template<class D, class R, unsigned int dim, unsigned int k>
+  class DubinerSimplexLocalFiniteElement
+  {
+  public:
+    using Traits = LocalFiniteElementTraits<Impl::DubinerSimplexLocalBasis<D,R,dim,k>,
+                                            DGLocalCoefficients,
+                                            Impl::DubinerSimplexLocalInterpolation<Impl::DubinerSimplexLocalBasis<D,R,dim,k> > >;
+
+    DubinerSimplexLocalFiniteElement ()
+      : coefficients_(size())
+    {}
+
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    static constexpr std::size_t size ()
+    {
+      return Traits::LocalBasisType::size();
+    }
+
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::simplex(dim);
+    }
+
+  private:
+    typename Traits::LocalBasisType basis_;
+    typename Traits::LocalCoefficientsType coefficients_;
+    typename Traits::LocalInterpolationType interpolation_;
+  };
+
+}
+
+#endif   // DUNE_LOCALFUNCTIONS_ORTHONORMAL_DUBINERSIMPLEX_HH
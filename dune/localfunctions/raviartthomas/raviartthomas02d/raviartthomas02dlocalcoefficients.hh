@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
 
 namespace Dune
 {
@@ -43,6 +44,13 @@ namespace Dune
       return li[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(RT02DLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> li;
   };
@@ -13,6 +13,7 @@
 
 #include <dune/localfunctions/common/localbasis.hh>
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
 
 namespace Dune
 {
@@ -205,6 +206,13 @@ namespace Dune
       return li[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(RT0Cube2DLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> li;
   };
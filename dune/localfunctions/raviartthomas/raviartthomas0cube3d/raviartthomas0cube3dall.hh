@@ -13,6 +13,7 @@
 
 #include <dune/localfunctions/common/localbasis.hh>
 #include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
 
 namespace Dune
 {
@@ -234,6 +235,13 @@ namespace Dune
       return li[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(RT0Cube3DLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> li;
   };
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "../../common/localkey.hh"
+#include "../../common/subentitydoftable.hh"
 
 namespace Dune
 {
@@ -44,6 +45,13 @@ namespace Dune
       return li[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(RT0PyramidLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> li;
   };
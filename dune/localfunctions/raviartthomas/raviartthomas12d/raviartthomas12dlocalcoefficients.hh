@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "../../common/localkey.hh"
+#include "../../common/subentitydoftable.hh"
 
 namespace Dune
 {
@@ -49,6 +50,13 @@ namespace Dune
       return li[i];
     }
 
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(RT12DLocalCoefficients{});
+      return table;
+    }
+
   private:
     std::vector<LocalKey> li;
   };
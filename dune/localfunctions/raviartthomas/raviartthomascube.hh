@@ -5,6 +5,13 @@
 #ifndef DUNE_LOCALFUNCTIONS_RAVIARTTHOMAS_CUBE_HH
 #define DUNE_LOCALFUNCTIONS_RAVIARTTHOMAS_CUBE_HH
 
+#include <bitset>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/utility/tensorproductvectorcube.hh>
+
 #include "raviartthomas0cube2d.hh"
 #include "raviartthomas0cube3d.hh"
 #include "raviartthomas1cube2d.hh"
@@ -26,18 +33,78 @@ namespace Dune
    *
    * Convenience class to access all implemented Raviart-Thomas local
    * finite elements for cubes.
-   * Generic Raviart-Thomas local finite elements for cubes like for
-   * simpleces could be written.
+   * The elements of dimension 2 and order up to 4 as well as dimension 3 and
+   * order up to 1 are implemented explicitly. All other elements are
+   * constructed as tensor products of univariate polynomials, see
+   * Impl::TensorProductVectorCubeStructure. Their degrees of freedom are the
+   * moments of the normal components on the faces against products of Legendre
+   * polynomials and the interior moments of the components.
+   *
+   * \note Flipping the orientation of a face by the constructor argument reverses
+   *   its normal and its first tangential coordinate. In 2d this makes the elements
+   *   conforming for any mesh of positively oriented elements. In 3d the local
+   *   coordinates on shared faces must agree up to this reflection, as for
+   *   translated elements.
    *
    * \ingroup RaviartThomas
    *
    * \tparam D type to represent the field in the domain.
    * \tparam R type to represent the field in the range.
-   * \tparam dim dimension of the reference elements, must be 2 or 3.
-   * \tparam order order of the element, depending on \a dim it can be 0, 1, or 2.
+   * \tparam dim dimension of the reference elements.
+   * \tparam order order of the element.
    */
   template<class D, class R, unsigned int dim, unsigned int order>
-  class RaviartThomasCubeLocalFiniteElement;
+  class RaviartThomasCubeLocalFiniteElement
+  {
+  public:
+    using Traits = LocalFiniteElementTraits<
+        Impl::TensorProductVectorCubeLocalBasis<D,R,dim,order+1,true>,
+        Impl::TensorProductVectorCubeLocalCoefficients<dim,order+1,true>,
+        Impl::TensorProductVectorCubeLocalInterpolation<Impl::TensorProductVectorCubeLocalBasis<D,R,dim,order+1,true> > >;
+
+    //! \brief Standard constructor
+    RaviartThomasCubeLocalFiniteElement() = default;
+
+    /**
+     * \brief Make set number s, where 0 <= s < 2^(2*dim)
+     *
+     * \param s Face orientation indicator
+     */
+    RaviartThomasCubeLocalFiniteElement(std::bitset<2*dim> s)
+      : basis_(s),
+        interpolation_(basis_)
+    {}
+
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    static constexpr unsigned int size ()
+    {
+      return Traits::LocalBasisType::size();
+    }
+
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::cube(dim);
+    }
+
+  private:
+    typename Traits::LocalBasisType basis_;
+    typename Traits::LocalCoefficientsType coefficients_;
+    typename Traits::LocalInterpolationType interpolation_;
+  };
 
   /**
    * \brief Raviart-Thomas local finite elements for cubes with dimension 2 and order 0.
@@ -51,8 +118,8 @@ namespace Dune
       : RT0Cube2DLocalFiniteElement<D, R>::RT0Cube2DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT0Cube2DLocalFiniteElement<D, R>::RT0Cube2DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<4> s)
+      : RT0Cube2DLocalFiniteElement<D, R>::RT0Cube2DLocalFiniteElement(s.to_ulong())
     {}
   };
 
@@ -68,8 +135,8 @@ namespace Dune
       : RT1Cube2DLocalFiniteElement<D, R>::RT1Cube2DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT1Cube2DLocalFiniteElement<D, R>::RT1Cube2DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<4> s)
+      : RT1Cube2DLocalFiniteElement<D, R>::RT1Cube2DLocalFiniteElement(s.to_ulong())
     {}
   };
 
@@ -85,8 +152,8 @@ namespace Dune
       : RT2Cube2DLocalFiniteElement<D, R>::RT2Cube2DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT2Cube2DLocalFiniteElement<D, R>::RT2Cube2DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<4> s)
+      : RT2Cube2DLocalFiniteElement<D, R>::RT2Cube2DLocalFiniteElement(s.to_ulong())
     {}
   };
 
@@ -102,8 +169,8 @@ namespace Dune
       : RT3Cube2DLocalFiniteElement<D, R>::RT3Cube2DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT3Cube2DLocalFiniteElement<D, R>::RT3Cube2DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<4> s)
+      : RT3Cube2DLocalFiniteElement<D, R>::RT3Cube2DLocalFiniteElement(s.to_ulong())
     {}
   };
 
@@ -119,8 +186,8 @@ namespace Dune
       : RT4Cube2DLocalFiniteElement<D, R>::RT4Cube2DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT4Cube2DLocalFiniteElement<D, R>::RT4Cube2DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<4> s)
+      : RT4Cube2DLocalFiniteElement<D, R>::RT4Cube2DLocalFiniteElement(s.to_ulong())
     {}
   };
 
@@ -136,8 +203,8 @@ namespace Dune
       : RT0Cube3DLocalFiniteElement<D, R>::RT0Cube3DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT0Cube3DLocalFiniteElement<D, R>::RT0Cube3DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<6> s)
+      : RT0Cube3DLocalFiniteElement<D, R>::RT0Cube3DLocalFiniteElement(s.to_ulong())
     {}
   };
 
@@ -153,8 +220,8 @@ namespace Dune
       : RT1Cube3DLocalFiniteElement<D, R>::RT1Cube3DLocalFiniteElement()
     {}
 
-    RaviartThomasCubeLocalFiniteElement(int s)
-      : RT1Cube3DLocalFiniteElement<D, R>::RT1Cube3DLocalFiniteElement(s)
+    RaviartThomasCubeLocalFiniteElement(std::bitset<6> s)
+      : RT1Cube3DLocalFiniteElement<D, R>::RT1Cube3DLocalFiniteElement(s.to_ulong())
     {}
   };
 } // namespace Dune
@@ -24,6 +24,32 @@ namespace Impl {
   struct ImplementedRaviartThomasLocalFiniteElements
   {};
 
+  // Higher orders are only available for cubes
+
+  template<class D, class R, std::size_t order>
+  struct ImplementedRaviartThomasLocalFiniteElements<D,R,2,order> : public FixedDimLocalGeometryTypeIndex<2>
+  {
+    using FixedDimLocalGeometryTypeIndex<2>::index;
+    static auto getImplementations()
+    {
+      return std::make_tuple(
+        std::make_pair(index(GeometryTypes::quadrilateral), []() { return RaviartThomasCubeLocalFiniteElement<D,R,2,order>(); })
+      );
+    }
+  };
+
+  template<class D, class R, std::size_t order>
+  struct ImplementedRaviartThomasLocalFiniteElements<D,R,3,order> : public FixedDimLocalGeometryTypeIndex<3>
+  {
+    using FixedDimLocalGeometryTypeIndex<3>::index;
+    static auto getImplementations()
+    {
+      return std::make_tuple(
+        std::make_pair(index(GeometryTypes::hexahedron), []() { return RaviartThomasCubeLocalFiniteElement<D,R,3,order>(); })
+      );
+    }
+  };
+
   template<class D, class R>
   struct ImplementedRaviartThomasLocalFiniteElements<D,R,2,0> : public FixedDimLocalGeometryTypeIndex<2>
   {
@@ -82,7 +108,7 @@ namespace Impl {
     static auto getImplementations()
     {
       return std::make_tuple(
-        std::make_pair(index(GeometryTypes::hexahedron), []() { RT1Cube3DLocalFiniteElement<D,R>(); })
+        std::make_pair(index(GeometryTypes::hexahedron), []() { return RT1Cube3DLocalFiniteElement<D,R>(); })
       );
     }
   };
@@ -97,11 +123,12 @@ namespace Impl {
  * \tparam R Type used for shape function values
  * \tparam dim Element dimension
  * \tparam order Element order
+ * \tparam lazy Create the elements on first request, see LocalFiniteElementVariantCache
  *
  * The cached finite element implementations can be obtained using get(GeometryType).
  */
-template<class D, class R, std::size_t dim, std::size_t order>
-using RaviartThomasLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedRaviartThomasLocalFiniteElements<D,R,dim,order>>;
+template<class D, class R, std::size_t dim, std::size_t order, bool lazy = false>
+using RaviartThomasLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedRaviartThomasLocalFiniteElements<D,R,dim,order>, lazy>;
 
 } // namespace Dune
 
@@ -8,5 +8,6 @@
  */
 
 
+#include <dune/localfunctions/refined/refinedlagrange.hh>
 #include <dune/localfunctions/refined/refinedp0.hh>
 #include <dune/localfunctions/refined/refinedp1.hh>
@@ -0,0 +1,293 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_REFINED_COMMON_REFINEMENTTRANSFER_HH
+#define DUNE_LOCALFUNCTIONS_REFINED_COMMON_REFINEMENTTRANSFER_HH
+
+/** \file
+    \brief Prolongation and restriction matrices between a reference element and the children of its uniform refinement
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/utility/lazycache.hh>
+
+namespace Dune
+{
+
+  /** \brief The children of the uniform refinement of a reference simplex or cube
+   *
+   * The children of a simplex are numbered as the subelements of
+   * RefinedSimplexLocalBasis, hence simplices are only supported up to
+   * dimension three. The \f$2^{dim}\f$ children of a cube are numbered
+   * lexicographically, the bit i of the child index is set if the child
+   * is in the upper half of the direction i.
+   *
+   * \tparam D Type to represent the field in the domain
+   * \tparam dim Dimension of the reference element
+   */
+  template<class D, int dim>
+  class UniformRefinementChildren
+  {
+  public:
+    //! The affine map from the reference element into a child
+    using Geometry = AffineGeometry<D,dim,dim>;
+
+    //! Construct the children of the uniform refinement of the reference element of the given type
+    explicit UniformRefinementChildren (const GeometryType& type)
+      : type_(type)
+    {
+      using Corners = std::vector<FieldVector<D,dim> >;
+      if (type.isCube())
+      {
+        // Each child is the parent scaled by 1/2 and shifted to its lower corner
+        typename Geometry::JacobianTransposed jacobianTransposed(0);
+        for (int i = 0; i < dim; ++i)
+          jacobianTransposed[i][i] = D(1) / 2;
+        for (unsigned int child = 0; child < (1u << dim); ++child)
+        {
+          FieldVector<D,dim> origin;
+          for (int i = 0; i < dim; ++i)
+            origin[i] = D((child >> i) & 1) / 2;
+          children_.emplace_back(referenceElement<D,dim>(type), origin, jacobianTransposed);
+        }
+      }
+      else if (type.isSimplex())
+      {
+        for (const auto& vertices : simplexChildren())
+        {
+          Corners corners;
+          for (const auto& vertex : vertices)
+            corners.push_back(simplexPoint(vertex));
+          children_.emplace_back(type, corners);
+        }
+      }
+      else
+        DUNE_THROW(NotImplemented, "Uniform refinement is only implemented for simplices and cubes");
+    }
+
+    //! The type of the reference element
+    GeometryType type () const
+    {
+      return type_;
+    }
+
+    //! Number of children
+    std::size_t size () const
+    {
+      return children_.size();
+    }
+
+    //! The map from the reference element into a child
+    const Geometry& geometry (std::size_t child) const
+    {
+      return children_[child];
+    }
+
+  private:
+    // The vertices of the children of a simplex as multiples of 1/2
+    static std::vector<std::vector<std::array<int,dim> > > simplexChildren ()
+    {
+      if constexpr (dim == 1)
+        return {{{0}, {1}}, {{1}, {2}}};
+      else if constexpr (dim == 2)
+        return {{{0,0}, {1,0}, {0,1}},
+                {{1,0}, {2,0}, {1,1}},
+                {{0,1}, {1,1}, {0,2}},
+                {{1,1}, {0,1}, {1,0}}};
+      else if constexpr (dim == 3)
+        // The points 4,...,9 of RefinedSimplexLocalBasis<D,3> are the midpoints
+        // of the edges, the children 4,...,7 partition the inner octahedron
+        return {{{0,0,0}, {1,0,0}, {0,1,0}, {0,0,1}},
+                {{1,0,0}, {2,0,0}, {1,1,0}, {1,0,1}},
+                {{0,1,0}, {1,1,0}, {0,2,0}, {0,1,1}},
+                {{0,0,1}, {1,0,1}, {0,1,1}, {0,0,2}},
+                {{1,0,0}, {0,1,0}, {0,0,1}, {1,0,1}},
+                {{1,1,0}, {0,1,0}, {1,0,0}, {1,0,1}},
+                {{0,1,0}, {0,0,1}, {1,0,1}, {0,1,1}},
+                {{0,1,0}, {0,1,1}, {1,0,1}, {1,1,0}}};
+      else
+        DUNE_THROW(NotImplemented, "Uniform refinement of simplices is only implemented for dim <= 3");
+    }
+
+    static FieldVector<D,dim> simplexPoint (const std::array<int,dim>& vertex)
+    {
+      FieldVector<D,dim> x;
+      for (int i = 0; i < dim; ++i)
+        x[i] = D(vertex[i]) / 2;
+      return x;
+    }
+
+    GeometryType type_;
+    std::vector<Geometry> children_;
+  };
+
+
+  /** \brief Prolongation and restriction matrices for the uniform refinement of a local finite element
+   *
+   * The prolongation matrix of a child maps the coefficients of a function
+   * on the parent element to the coefficients of its restriction to the
+   * child, i.e. entry (i,j) is the coefficient i of the interpolation of the
+   * parent shape function j composed with the map of the child.
+   *
+   * The restriction matrices map the coefficients on the children back to the
+   * coefficients on the parent, i.e. the coefficients of the interpolation
+   * of the piecewise defined function are the sum over all children of the
+   * products of the restriction matrices with the coefficients of the children.
+   * Points on the boundary between children are evaluated in the child with the
+   * lowest index. Hence for continuous Lagrange elements the restriction is the
+   * left inverse of the prolongation. For multigrid methods the transposed
+   * prolongation matrices should be used instead.
+   *
+   * \tparam LocalFiniteElement Type of the local finite element of both the parent and the children
+   */
+  template<class LocalFiniteElement>
+  class RefinementTransferMatrices
+  {
+    using LocalBasisTraits = typename LocalFiniteElement::Traits::LocalBasisType::Traits;
+    using D = typename LocalBasisTraits::DomainFieldType;
+    using R = typename LocalBasisTraits::RangeFieldType;
+    static constexpr int dim = LocalBasisTraits::dimDomain;
+    using Domain = typename LocalBasisTraits::DomainType;
+    using Range = typename LocalBasisTraits::RangeType;
+
+  public:
+    //! Type of the stored matrices
+    using Matrix = DynamicMatrix<R>;
+
+    //! Compute the prolongation and restriction matrices for all children
+    explicit RefinementTransferMatrices (const LocalFiniteElement& fe)
+      : children_(fe.type())
+    {
+      const auto& basis = fe.localBasis();
+      const auto& interpolation = fe.localInterpolation();
+      const auto& refElement = ReferenceElements<D,dim>::general(fe.type());
+      const std::size_t n = fe.size();
+      std::vector<Range> values;
+      std::vector<R> coefficients;
+
+      for (std::size_t c = 0; c < children_.size(); ++c)
+      {
+        const auto& child = children_.geometry(c);
+
+        Matrix prolongation(n, n, 0);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          interpolation.interpolate([&](const Domain& x) {
+            basis.evaluateFunction(child.global(x), values);
+            return values[j];
+          }, coefficients);
+          for (std::size_t i = 0; i < n; ++i)
+            prolongation[i][j] = coefficients[i];
+        }
+        prolongation_.push_back(prolongation);
+
+        // Evaluate the child shape function j only at points for which c is the first child containing them
+        Matrix restriction(n, n, 0);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          interpolation.interpolate([&](const Domain& x) {
+            Range y(0);
+            if (firstChild(refElement, x) == c)
+            {
+              basis.evaluateFunction(child.local(x), values);
+              y = values[j];
+            }
+            return y;
+          }, coefficients);
+          for (std::size_t i = 0; i < n; ++i)
+            restriction[i][j] = coefficients[i];
+        }
+        restriction_.push_back(restriction);
+      }
+    }
+
+    //! The children of the refinement
+    const UniformRefinementChildren<D,dim>& children () const
+    {
+      return children_;
+    }
+
+    //! The matrix mapping the coefficients of the parent to the coefficients of a child
+    const Matrix& prolongation (std::size_t child) const
+    {
+      return prolongation_[child];
+    }
+
+    //! The matrix mapping the coefficients of a child to its contribution to the coefficients of the parent
+    const Matrix& restriction (std::size_t child) const
+    {
+      return restriction_[child];
+    }
+
+  private:
+    template<class RefElement>
+    std::size_t firstChild (const RefElement& refElement, const Domain& x) const
+    {
+      for (std::size_t c = 0; c < children_.size(); ++c)
+        if (refElement.checkInside(children_.geometry(c).local(x)))
+          return c;
+      DUNE_THROW(InvalidStateException, "Point " << x << " is not contained in any child");
+    }
+
+    UniformRefinementChildren<D,dim> children_;
+    std::vector<Matrix> prolongation_;
+    std::vector<Matrix> restriction_;
+  };
+
+
+  /** \brief A cache storing the refinement transfer matrices of the elements of a local finite element cache
+   *
+   * The matrices are computed on first request, e.g. for the elements of a
+   * LagrangeLocalFiniteElementCache of any order and each GeometryType.
+   * get() is thread safe if the get() of the underlying cache is, see
+   * Impl::PointerKeyedLazyCache.
+   *
+   * \tparam LocalFiniteElementCache Type of the underlying cache of local finite elements
+   */
+  template<class LocalFiniteElementCache>
+  class RefinementTransferMatricesCache
+  {
+  public:
+    //! Type of the local finite elements of the underlying cache
+    using FiniteElementType = typename LocalFiniteElementCache::FiniteElementType;
+
+    //! Type of the stored transfer matrices
+    using MatricesType = RefinementTransferMatrices<FiniteElementType>;
+
+    /** \brief Construct an empty cache
+     *
+     * \note This class stores the reference to the cache passed here, which
+     *       must outlive this object. The underlying cache must return
+     *       references to local finite elements that stay valid.
+     */
+    explicit RefinementTransferMatricesCache (const LocalFiniteElementCache& localFiniteElementCache)
+      : localFiniteElementCache_(localFiniteElementCache)
+    {}
+
+    //! Get the transfer matrices of the local finite element for the given key data
+    template<class... Key>
+    const MatricesType& get (const Key&... key) const
+    {
+      return data_.get(&localFiniteElementCache_.get(key...));
+    }
+
+  private:
+    const LocalFiniteElementCache& localFiniteElementCache_;
+    Impl::PointerKeyedLazyCache<const FiniteElementType*, MatricesType> data_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_REFINED_COMMON_REFINEMENTTRANSFER_HH
@@ -0,0 +1,587 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_REFINED_REFINEDLAGRANGE_HH
+#define DUNE_LOCALFUNCTIONS_REFINED_REFINEDLAGRANGE_HH
+
+/** \file
+    \brief Continuous Lagrange shape functions of arbitrary order on a reference element refined uniformly an arbitrary number of times
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief Continuous piecewise Lagrange shape functions of order k on a uniformly refined simplex
+   *
+   * The reference simplex is refined by the Freudenthal (Kuhn) subdivision into
+   * \f$N^{dim}\f$ congruent subsimplices, \f$N=2^{levels}\f$. In the coordinates
+   * \f$z_i = N\sum_{j\ge i}x_j\f$ the reference simplex is the set
+   * \f$N\ge z_0\ge\dots\ge z_{dim-1}\ge 0\f$ and each subsimplex is the part of
+   * an integer cell \f$c+[0,1]^{dim}\f$ on which the fractional parts \f$z-c\f$
+   * have a fixed ordering. Hence the subsimplex containing a point is found by
+   * rounding and sorting dim numbers. For one and two dimensions the subdivision
+   * coincides with the one of RefinedSimplexLocalBasis for a single level.
+   *
+   * The shape functions are associated to the Lagrange nodes of order Nk of
+   * the reference simplex and are numbered as the shape functions of
+   * LagrangeSimplexLocalBasis of that order. For each subsimplex the indices
+   * of its Lagrange nodes of order k are tabulated once.
+   *
+   * \tparam D Type to represent the field in the domain
+   * \tparam R Type to represent the field in the range
+   * \tparam dim Dimension of the domain simplex
+   * \tparam k Polynomial order on the subsimplices
+   * \tparam levels Number of uniform refinements
+   */
+  template<class D, class R, unsigned int dim, unsigned int k, unsigned int levels>
+  class RefinedLagrangeSimplexLocalBasis
+  {
+    static_assert(k >= 1, "RefinedLagrangeSimplexLocalBasis requires k >= 1");
+
+    static constexpr unsigned int cells = 1u << levels;
+    static constexpr unsigned int nodes = cells*k;
+    static constexpr unsigned int subSize = binomial(k+dim, dim);
+    static constexpr unsigned int permutations = factorial(dim);
+
+    // Barycentric multi-indices of the Lagrange nodes of a subsimplex
+    static std::vector<std::array<unsigned int,dim+1> > subMultiIndices ()
+    {
+      std::vector<std::array<unsigned int,dim+1> > result;
+      std::array<unsigned int,dim+1> beta{};
+      while (true)
+      {
+        if (std::accumulate(beta.begin(), beta.end(), 0u) == k)
+          result.push_back(beta);
+        unsigned int i = 0;
+        for (; i <= dim; ++i)
+        {
+          if (++beta[i] <= k)
+            break;
+          beta[i] = 0;
+        }
+        if (i > dim)
+          return result;
+      }
+    }
+
+    // Index of a Lagrange node of order Nk, given by its lattice coordinates
+    static unsigned int latticeIndex (const std::array<unsigned int,dim>& X)
+    {
+      // Count the nodes preceding X in the lexicographic order with the last coordinate running slowest
+      unsigned int index = 0;
+      unsigned int remaining = nodes;
+      for (int i = dim-1; i >= 0; --i)
+      {
+        // nodes with a smaller coordinate i and equal coordinates i+1,...,dim-1
+        for (unsigned int a = 0; a < X[i]; ++a)
+          index += binomial(remaining - a + i, (unsigned int)i);
+        remaining -= X[i];
+      }
+      return index;
+    }
+
+    // The global indices of the Lagrange nodes of all subsimplices, the subsimplex of
+    // the cell c and the permutation of rank r has the index r + permutations*(linear index of c)
+    struct DofTable
+    {
+      std::vector<std::array<unsigned int,dim+1> > beta;
+      std::vector<std::array<unsigned int,subSize> > indices;
+
+      DofTable ()
+        : beta(subMultiIndices())
+        , indices(permutations*power(cells, dim))
+      {
+        std::array<unsigned int,dim> cell{};
+        for (std::size_t c = 0; c < power(cells, dim); ++c)
+        {
+          std::size_t linear = c;
+          for (unsigned int i = 0; i < dim; ++i)
+          {
+            cell[i] = linear % cells;
+            linear /= cells;
+          }
+
+          std::array<unsigned int,dim> pi;
+          std::iota(pi.begin(), pi.end(), 0);
+          std::size_t rank = 0;
+          do {
+            auto& table = indices[rank + permutations*c];
+            for (std::size_t b = 0; b < beta.size(); ++b)
+            {
+              // lattice coordinates of the node in the z-coordinates scaled by k
+              std::array<int,dim+1> Z{};
+              for (unsigned int l = 0; l < dim; ++l)
+              {
+                Z[pi[l]] = k*cell[pi[l]];
+                for (unsigned int m = l+1; m <= dim; ++m)
+                  Z[pi[l]] += beta[b][m];
+              }
+              // Subsimplices outside of the reference simplex are never located
+              bool inside = (Z[0] <= int(nodes));
+              std::array<unsigned int,dim> X;
+              for (unsigned int i = 0; i < dim; ++i)
+              {
+                inside = inside and (Z[i] >= Z[i+1]);
+                X[i] = Z[i] - Z[i+1];
+              }
+              table[b] = inside ? latticeIndex(X) : 0;
+            }
+            ++rank;
+          } while (std::next_permutation(pi.begin(), pi.end()));
+        }
+      }
+    };
+
+    static const DofTable& dofTable ()
+    {
+      static const DofTable table;
+      return table;
+    }
+
+    // Locate the subsimplex containing x and compute the barycentric coordinates
+    // in the subsimplex and the permutation of the fractional parts
+    static std::size_t locate (const FieldVector<D,dim>& x,
+                               std::array<unsigned int,dim>& pi,
+                               std::array<R,dim+1>& lambda)
+    {
+      std::array<R,dim> f;
+      std::array<unsigned int,dim> cell;
+      R z = 0;
+      for (int i = dim-1; i >= 0; --i)
+      {
+        // The z-coordinates are non-increasing, also for points slightly outside
+        z = std::max(z, R(z + cells*x[i]));
+        const R zi = std::min(z, R(cells));
+        cell[i] = std::min((unsigned int)std::max(std::floor(zi), R(0)), cells-1);
+        f[i] = zi - cell[i];
+      }
+
+      // Sort the fractional parts descending, ties by increasing index
+      std::iota(pi.begin(), pi.end(), 0);
+      std::stable_sort(pi.begin(), pi.end(), [&](unsigned int a, unsigned int b) { return f[a] > f[b]; });
+
+      lambda[0] = 1 - f[pi[0]];
+      for (unsigned int m = 1; m < dim; ++m)
+        lambda[m] = f[pi[m-1]] - f[pi[m]];
+      lambda[dim] = f[pi[dim-1]];
+
+      // Rank of the permutation in lexicographic order
+      std::size_t rank = 0;
+      for (unsigned int i = 0; i < dim; ++i)
+      {
+        unsigned int smaller = 0;
+        for (unsigned int j = i+1; j < dim; ++j)
+          smaller += (pi[j] < pi[i]);
+        rank = rank*(dim-i) + smaller;
+      }
+
+      std::size_t linear = 0;
+      for (int i = dim-1; i >= 0; --i)
+        linear = linear*cells + cell[i];
+      return rank + permutations*linear;
+    }
+
+    // Values and derivatives of the univariate factors (k t - j)/(j+1), j < b
+    static void evaluateFactors (const R& t, std::array<R,k+1>& L, std::array<R,k+1>& dL)
+    {
+      L[0] = 1;
+      dL[0] = 0;
+      for (unsigned int b = 1; b <= k; ++b)
+      {
+        L[b] = L[b-1] * (k*t - (b-1)) / b;
+        dL[b] = (dL[b-1] * (k*t - (b-1)) + k*L[b-1]) / b;
+      }
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    RefinedLagrangeSimplexLocalBasis ()
+    {
+      // Set up the table before the first evaluation
+      dofTable();
+    }
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return binomial(nodes+dim, dim);
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::RangeType>& out) const
+    {
+      out.assign(size(), 0);
+      std::array<unsigned int,dim> pi;
+      std::array<R,dim+1> lambda;
+      const auto& table = dofTable();
+      const auto& indices = table.indices[locate(x, pi, lambda)];
+
+      std::array<std::array<R,k+1>,dim+1> L, dL;
+      for (unsigned int m = 0; m <= dim; ++m)
+        evaluateFactors(lambda[m], L[m], dL[m]);
+
+      for (std::size_t b = 0; b < subSize; ++b)
+      {
+        R y = 1;
+        for (unsigned int m = 0; m <= dim; ++m)
+          y *= L[m][table.beta[b][m]];
+        out[indices[b]] = y;
+      }
+    }
+
+    //! \brief Evaluate Jacobian of all shape functions
+    void evaluateJacobian (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.assign(size(), 0);
+      std::array<unsigned int,dim> pi;
+      std::array<R,dim+1> lambda;
+      const auto& table = dofTable();
+      const auto& indices = table.indices[locate(x, pi, lambda)];
+
+      std::array<std::array<R,k+1>,dim+1> L, dL;
+      for (unsigned int m = 0; m <= dim; ++m)
+        evaluateFactors(lambda[m], L[m], dL[m]);
+
+      for (std::size_t b = 0; b < subSize; ++b)
+      {
+        const auto& beta = table.beta[b];
+
+        // derivatives with respect to the barycentric coordinates
+        std::array<R,dim+1> dLambda;
+        for (unsigned int m = 0; m <= dim; ++m)
+        {
+          dLambda[m] = dL[m][beta[m]];
+          for (unsigned int l = 0; l <= dim; ++l)
+            if (l != m)
+              dLambda[m] *= L[l][beta[l]];
+        }
+
+        // derivatives with respect to the z-coordinates
+        std::array<R,dim> dz;
+        for (unsigned int l = 0; l < dim; ++l)
+          dz[pi[l]] = dLambda[l+1] - dLambda[l];
+
+        R sum = 0;
+        for (unsigned int j = 0; j < dim; ++j)
+        {
+          sum += dz[j];
+          out[indices[b]][0][j] = cells*sum;
+        }
+      }
+    }
+
+    //! \brief Evaluate partial derivatives of all shape functions, only orders up to one are implemented
+    void partial (const std::array<unsigned int,dim>& order,
+                  const typename Traits::DomainType& in,
+                  std::vector<typename Traits::RangeType>& out) const
+    {
+      auto totalOrder = std::accumulate(order.begin(), order.end(), 0u);
+      if (totalOrder == 0)
+        evaluateFunction(in, out);
+      else if (totalOrder == 1)
+      {
+        auto direction = std::distance(order.begin(), std::find(order.begin(), order.end(), 1u));
+        std::vector<typename Traits::JacobianType> jacobians;
+        evaluateJacobian(in, jacobians);
+        out.resize(size());
+        for (std::size_t i = 0; i < size(); ++i)
+          out[i] = jacobians[i][0][direction];
+      }
+      else
+        DUNE_THROW(NotImplemented, "Desired derivative order is not implemented");
+    }
+
+    //! \brief Polynomial order of the shape functions on the subsimplices
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+  };
+
+
+  /** \brief Continuous piecewise Lagrange shape functions of order k on a uniformly refined cube
+   *
+   * The reference cube is divided into \f$N^{dim}\f$ subcubes, \f$N=2^{levels}\f$.
+   * The subcube containing a point is found by rounding its scaled coordinates.
+   * The shape functions are associated to the Lagrange nodes of order Nk of the
+   * reference cube and are numbered as the shape functions of LagrangeCubeLocalBasis
+   * of that order. On each subcube the univariate Lagrange polynomials are tabulated
+   * once per direction.
+   *
+   * \tparam D Type to represent the field in the domain
+   * \tparam R Type to represent the field in the range
+   * \tparam dim Dimension of the domain cube
+   * \tparam k Polynomial order in each direction on the subcubes
+   * \tparam levels Number of uniform refinements
+   */
+  template<class D, class R, unsigned int dim, unsigned int k, unsigned int levels>
+  class RefinedLagrangeCubeLocalBasis
+  {
+    static_assert(k >= 1, "RefinedLagrangeCubeLocalBasis requires k >= 1");
+
+    static constexpr unsigned int cells = 1u << levels;
+    static constexpr unsigned int nodes = cells*k;
+
+    // Locate the subcube and tabulate the univariate Lagrange polynomials and their derivatives
+    static void tabulate (const FieldVector<D,dim>& x, std::array<unsigned int,dim>& offset,
+                          std::array<std::array<R,k+1>,dim>& p, std::array<std::array<R,k+1>,dim>& dp)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+      {
+        const R xi = std::clamp(R(cells*x[i]), R(0), R(cells));
+        const unsigned int cell = std::min((unsigned int)std::floor(xi), cells-1);
+        const R t = xi - cell;
+        offset[i] = k*cell;
+        for (unsigned int a = 0; a <= k; ++a)
+        {
+          p[i][a] = 1;
+          dp[i][a] = 0;
+          for (unsigned int b = 0; b <= k; ++b)
+            if (b != a)
+            {
+              dp[i][a] = dp[i][a] * (k*t - b) / (int(a) - int(b)) + p[i][a] * R(k) / (int(a) - int(b));
+              p[i][a] *= (k*t - b) / (int(a) - int(b));
+            }
+          dp[i][a] *= cells;
+        }
+      }
+    }
+
+    // Global index of the node with the local multi-index alpha in the subcube
+    static unsigned int index (const std::array<unsigned int,dim>& offset, const std::array<unsigned int,dim>& alpha)
+    {
+      unsigned int result = 0;
+      for (int i = dim-1; i >= 0; --i)
+        result = result*(nodes+1) + offset[i] + alpha[i];
+      return result;
+    }
+
+    static std::array<unsigned int,dim> multiindex (unsigned int n)
+    {
+      std::array<unsigned int,dim> alpha;
+      for (unsigned int i = 0; i < dim; ++i)
+      {
+        alpha[i] = n % (k+1);
+        n /= k+1;
+      }
+      return alpha;
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return power(nodes+1, dim);
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::RangeType>& out) const
+    {
+      out.assign(size(), 0);
+      std::array<unsigned int,dim> offset;
+      std::array<std::array<R,k+1>,dim> p, dp;
+      tabulate(x, offset, p, dp);
+      for (unsigned int n = 0; n < power(k+1, dim); ++n)
+      {
+        const auto alpha = multiindex(n);
+        R y = 1;
+        for (unsigned int i = 0; i < dim; ++i)
+          y *= p[i][alpha[i]];
+        out[index(offset, alpha)] = y;
+      }
+    }
+
+    //! \brief Evaluate Jacobian of all shape functions
+    void evaluateJacobian (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.assign(size(), 0);
+      std::array<unsigned int,dim> offset;
+      std::array<std::array<R,k+1>,dim> p, dp;
+      tabulate(x, offset, p, dp);
+      for (unsigned int n = 0; n < power(k+1, dim); ++n)
+      {
+        const auto alpha = multiindex(n);
+        auto& jacobian = out[index(offset, alpha)][0];
+        for (unsigned int j = 0; j < dim; ++j)
+        {
+          jacobian[j] = dp[j][alpha[j]];
+          for (unsigned int i = 0; i < dim; ++i)
+            if (i != j)
+              jacobian[j] *= p[i][alpha[i]];
+        }
+      }
+    }
+
+    //! \brief Evaluate partial derivatives of all shape functions, only orders up to one are implemented
+    void partial (const std::array<unsigned int,dim>& order,
+                  const typename Traits::DomainType& in,
+                  std::vector<typename Traits::RangeType>& out) const
+    {
+      auto totalOrder = std::accumulate(order.begin(), order.end(), 0u);
+      if (totalOrder == 0)
+        evaluateFunction(in, out);
+      else if (totalOrder == 1)
+      {
+        auto direction = std::distance(order.begin(), std::find(order.begin(), order.end(), 1u));
+        std::vector<typename Traits::JacobianType> jacobians;
+        evaluateJacobian(in, jacobians);
+        out.resize(size());
+        for (std::size_t i = 0; i < size(); ++i)
+          out[i] = jacobians[i][0][direction];
+      }
+      else
+        DUNE_THROW(NotImplemented, "Desired derivative order is not implemented");
+    }
+
+    //! \brief Polynomial order of the shape functions in each direction on the subcubes
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+  };
+
+} }    // namespace Dune::Impl
+
+namespace Dune
+{
+
+  /** \brief Continuous Lagrange functions of order k on a simplex refined uniformly levels times
+   *
+   * The degrees of freedom are the values at the Lagrange nodes of order
+   * \f$2^{levels}k\f$, hence the coefficients and the interpolation are those
+   * of the Lagrange element of that order. RefinedP1LocalFiniteElement
+   * corresponds to k=1 and levels=1 in one and two dimensions.
+   *
+   * \ingroup LocalFunctions
+   *
+   * \tparam D Number type used for domain coordinates
+   * \tparam R Number type used for shape function values
+   * \tparam dim Dimension of the domain, at most 3
+   * \tparam k Polynomial order on the subsimplices
+   * \tparam levels Number of uniform refinements
+   */
+  template<class D, class R, unsigned int dim, unsigned int k, unsigned int levels>
+  class RefinedLagrangeSimplexLocalFiniteElement
+  {
+    static constexpr unsigned int nodes = (1u << levels)*k;
+
+  public:
+    using Traits = LocalFiniteElementTraits<Impl::RefinedLagrangeSimplexLocalBasis<D,R,dim,k,levels>,
+                                            Impl::LagrangeSimplexLocalCoefficients<dim,nodes>,
+                                            Impl::LagrangeSimplexLocalInterpolation<Impl::LagrangeSimplexLocalBasis<D,R,dim,nodes> > >;
+
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    static constexpr std::size_t size ()
+    {
+      return Traits::LocalBasisType::size();
+    }
+
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::simplex(dim);
+    }
+
+  private:
+    typename Traits::LocalBasisType basis_;
+    typename Traits::LocalCoefficientsType coefficients_;
+    typename Traits::LocalInterpolationType interpolation_;
+  };
+
+  /** \brief Continuous Lagrange functions of order k on a cube refined uniformly levels times
+   *
+   * The degrees of freedom are the values at the Lagrange nodes of order
+   * \f$2^{levels}k\f$, hence the coefficients and the interpolation are those
+   * of the Lagrange element of that order.
+   *
+   * \ingroup LocalFunctions
+   *
+   * \tparam D Number type used for domain coordinates
+   * \tparam R Number type used for shape function values
+   * \tparam dim Dimension of the domain, at most 3
+   * \tparam k Polynomial order in each direction on the subcubes
+   * \tparam levels Number of uniform refinements
+   */
+  template<class D, class R, unsigned int dim, unsigned int k, unsigned int levels>
+  class RefinedLagrangeCubeLocalFiniteElement
+  {
+    static constexpr unsigned int nodes = (1u << levels)*k;
+
+  public:
+    using Traits = LocalFiniteElementTraits<Impl::RefinedLagrangeCubeLocalBasis<D,R,dim,k,levels>,
+                                            Impl::LagrangeCubeLocalCoefficients<dim,nodes>,
+                                            Impl::LagrangeCubeLocalInterpolation<Impl::LagrangeCubeLocalBasis<D,R,dim,nodes> > >;
+
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    static constexpr std::size_t size ()
+    {
+      return Traits::LocalBasisType::size();
+    }
+
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::cube(dim);
+    }
+
+  private:
+    typename Traits::LocalBasisType basis_;
+    typename Traits::LocalCoefficientsType coefficients_;
+    typename Traits::LocalInterpolationType interpolation_;
+  };
+
+}
+
+#endif   // DUNE_LOCALFUNCTIONS_REFINED_REFINEDLAGRANGE_HH
@@ -0,0 +1,475 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_SERENDIPITY_SERENDIPITYCUBE_HH
+#define DUNE_LOCALFUNCTIONS_SERENDIPITY_SERENDIPITYCUBE_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/common/subentitydoftable.hh>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief The serendipity space of order k on the reference cube and its Lagrange nodes
+   *
+   * The serendipity space \f$S_k\f$ is spanned by the monomials \f$x^\alpha\f$
+   * of superlinear degree at most k, i.e., the total degree ignoring the
+   * variables that enter linearly [Arnold, Awanou: The serendipity family of
+   * finite elements, 2011]. The degrees of freedom of a d-dimensional subentity
+   * correspond to the polynomials of degree k-2d on it. Here they are the values
+   * at the points \f$((a_1+1)/(k-d+2),\dots,(a_d+1)/(k-d+2))\f$ with
+   * \f$a_1+\dots+a_d\leq k-2d\f$ in the local coordinates of the subentity,
+   * hence there are k-1 equidistant points on each edge as for the Lagrange
+   * element of order k.
+   *
+   * For m=k-2d>0 these points are not invariant under the symmetries of the
+   * subentity. On a face shared by two elements with different orientations
+   * of the face the nodes would not match and the element would not be
+   * conforming. This only matters for the faces in 3d, which have interior
+   * degrees of freedom for k>=4, hence the order is restricted to k<=4 in 3d.
+   * In 2d the only subentity with m>0 is the element itself.
+   */
+  template<unsigned int dim, unsigned int k>
+  struct SerendipityCubeSpace
+  {
+    static_assert(dim < 3 || k <= 4,
+                  "The face nodes of serendipity elements are only symmetric for k<=4 in 3d");
+
+    using MultiIndex = std::array<unsigned int,dim>;
+
+    //! \brief Total degree of a monomial without the variables of degree one
+    static constexpr unsigned int superlinearDegree (const MultiIndex& alpha)
+    {
+      unsigned int result = 0;
+      for (auto a : alpha)
+        if (a != 1)
+          result += a;
+      return result;
+    }
+
+    //! \brief Number of monomials and of degrees of freedom
+    static constexpr unsigned int size ()
+    {
+      unsigned int result = 0;
+      for (auto l : Dune::range(power(k+1, dim)))
+        if (superlinearDegree(multiIndex(l)) <= k)
+          ++result;
+      return result;
+    }
+
+    //! \brief The exponents of all monomials spanning the space
+    static constexpr auto monomials ()
+    {
+      auto result = std::array<MultiIndex,size()>{};
+      std::size_t n = 0;
+      for (auto l : Dune::range(power(k+1, dim)))
+        if (superlinearDegree(multiIndex(l)) <= k)
+          result[n++] = multiIndex(l);
+      return result;
+    }
+
+    //! \brief Number of degrees of freedom in the interior of a d-dimensional subentity
+    static constexpr unsigned int interiorSize (unsigned int d)
+    {
+      return (k >= 2*d) ? binomial(k-d, d) : 0;
+    }
+
+    /** \brief Call g(x, key) for all nodes x and their local keys
+     *
+     * The nodes are enumerated by subentity, starting with the vertices, and
+     * with the first direction of the subentity running fastest.
+     */
+    template<class F, class G>
+    static void forEachNode (G&& g)
+    {
+      const auto& refElement = ReferenceElements<double,dim>::cube();
+      for (unsigned int codim = dim+1; codim-- > 0; )
+      {
+        const unsigned int d = dim - codim;
+        if (interiorSize(d) == 0)
+          continue;
+        const unsigned int m = k - 2*d;
+        for (auto e : Dune::range(refElement.size(codim)))
+        {
+          // The corners of a subentity are numbered lexicographically, the corner 2^l
+          // is the neighbor of the corner 0 in the local direction l
+          FieldVector<F,dim> origin;
+          std::array<FieldVector<F,dim>,dim> directions;
+          const auto& corner0 = refElement.position(refElement.subEntity(e, codim, 0, dim), dim);
+          for (auto i : Dune::range(dim))
+            origin[i] = corner0[i];
+          for (auto l : Dune::range(d))
+          {
+            const auto& corner = refElement.position(refElement.subEntity(e, codim, 1u << l, dim), dim);
+            for (auto i : Dune::range(dim))
+              directions[l][i] = corner[i] - corner0[i];
+          }
+
+          unsigned int index = 0;
+          for (auto l : Dune::range(power(m+1, d)))
+          {
+            std::array<unsigned int,dim> a{};
+            unsigned int rest = l, sum = 0;
+            for (auto j : Dune::range(d))
+            {
+              a[j] = rest % (m+1);
+              rest /= (m+1);
+              sum += a[j];
+            }
+            if (sum > m)
+              continue;
+
+            auto x = origin;
+            for (auto j : Dune::range(d))
+              x.axpy(F(a[j]+1)/F(m+2), directions[j]);
+            g(x, LocalKey(e, codim, index++));
+          }
+        }
+      }
+    }
+
+  private:
+    static constexpr MultiIndex multiIndex (unsigned int l)
+    {
+      MultiIndex alpha{};
+      for (auto j : Dune::range(dim))
+      {
+        alpha[j] = l % (k+1);
+        l /= (k+1);
+      }
+      return alpha;
+    }
+  };
+
+
+  /** \brief Nodal shape functions of the serendipity element of order k on the reference cube
+
+     The shape functions are the linear combinations of the monomials of the
+     serendipity space which are one at a node of SerendipityCubeSpace and zero
+     at all others. The coefficients are computed once by inverting the
+     Vandermonde matrix of the nodes. The monomials are taken in the variables
+     \f$2x_i-1\f$ centered in the cube, which keeps the Vandermonde matrix
+     much better conditioned than on \f$[0,1]^{dim}\f$.
+
+     \tparam D Type to represent the field in the domain
+     \tparam R Type to represent the field in the range
+     \tparam dim Dimension of the domain cube
+     \tparam k Polynomial order
+   */
+  template<class D, class R, unsigned int dim, unsigned int k>
+  class SerendipityCubeLocalBasis
+  {
+    using Space = SerendipityCubeSpace<dim,k>;
+
+    static constexpr auto monomials_ = Space::monomials();
+
+    // The coefficient (j,n) of the monomial j in the shape function n
+    static const DynamicMatrix<R>& coefficients ()
+    {
+      static const DynamicMatrix<R> matrix = [] {
+        auto V = DynamicMatrix<R>(size(), size(), 0);
+        unsigned int n = 0;
+        Space::template forEachNode<R>([&](const FieldVector<R,dim>& x, const LocalKey&) {
+          for (auto j : Dune::range(size()))
+          {
+            R y = 1;
+            for (auto i : Dune::range(dim))
+              for ([[maybe_unused]] auto e : Dune::range(monomials_[j][i]))
+                y *= 2*x[i] - 1;
+            V[n][j] = y;
+          }
+          ++n;
+        });
+        V.invert();
+        return V;
+      }();
+      return matrix;
+    }
+
+    // Evaluate the derivatives of the given orders of all monomials
+    static auto evaluateMonomials (const std::array<unsigned int,dim>& order, const FieldVector<D,dim>& x)
+    {
+      // table[i][e] is the derivative of (2x_i-1)^e
+      auto table = std::array<std::array<R,k+1>,dim>{};
+      for (auto i : Dune::range(dim))
+        for (auto e : Dune::range(k+1))
+        {
+          R y = (e >= order[i]) ? 1 : 0;
+          for (auto l : Dune::range(e))
+            y *= (l < order[i]) ? R(2*(e-l)) : R(2*x[i] - 1);
+          table[i][e] = y;
+        }
+
+      auto values = std::array<R,size()>{};
+      for (auto j : Dune::range(size()))
+      {
+        R y = 1;
+        for (auto i : Dune::range(dim))
+          y *= table[i][monomials_[j][i]];
+        values[j] = y;
+      }
+      return values;
+    }
+
+    // Combine the values of the monomials to the shape functions
+    template<class Out>
+    static void combine (const std::array<R,Space::size()>& values, Out&& out)
+    {
+      const auto& C = coefficients();
+      for (auto n : Dune::range(size()))
+      {
+        R y = 0;
+        for (auto j : Dune::range(size()))
+          y += C[j][n] * values[j];
+        out(n, y);
+      }
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,1,FieldVector<R,1>,FieldMatrix<R,1,dim> >;
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return Space::size();
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+      combine(evaluateMonomials({}, x), [&](auto n, const R& y) {
+        out[n] = y;
+      });
+    }
+
+    /** \brief Evaluate Jacobian of all shape functions
+     *
+     * \param x Point in the reference cube where to evaluation the Jacobians
+     * \param[out] out The Jacobians of all shape functions at the point x
+     */
+    void evaluateJacobian(const typename Traits::DomainType& x,
+                          std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+      for (auto l : Dune::range(dim))
+      {
+        std::array<unsigned int,dim> order{};
+        order[l] = 1;
+        combine(evaluateMonomials(order, x), [&](auto n, const R& y) {
+          out[n][0][l] = y;
+        });
+      }
+    }
+
+    /** \brief Evaluate partial derivatives of any order of all shape functions
+     *
+     * \param order Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    void partial(const std::array<unsigned int,dim>& order,
+                 const typename Traits::DomainType& in,
+                 std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+
+      // Derivatives of order >k in any direction vanish
+      if (std::any_of(order.begin(), order.end(), [](auto o) { return o > k; }))
+      {
+        std::fill(out.begin(), out.end(), 0);
+        return;
+      }
+
+      combine(evaluateMonomials(order, in), [&](auto n, const R& y) {
+        out[n] = y;
+      });
+    }
+
+    //! \brief Polynomial order of the shape functions in each direction
+    static constexpr unsigned int order ()
+    {
+      return k;
+    }
+  };
+
+  /** \brief Associations of the serendipity degrees of freedom to subentities of the reference cube
+   *
+   * \tparam dim Dimension of the reference cube
+   * \tparam k Polynomial order
+   */
+  template<unsigned int dim, unsigned int k>
+  class SerendipityCubeLocalCoefficients
+  {
+    // The local keys shared by all instances
+    static const std::array<LocalKey,SerendipityCubeSpace<dim,k>::size()>& localKeys ()
+    {
+      static const auto keys = [] {
+        std::array<LocalKey,SerendipityCubeSpace<dim,k>::size()> result;
+        std::size_t n = 0;
+        SerendipityCubeSpace<dim,k>::template forEachNode<double>([&](const auto&, const LocalKey& key) {
+          result[n++] = key;
+        });
+        return result;
+      }();
+      return keys;
+    }
+
+  public:
+    //! number of coefficients
+    static constexpr std::size_t size ()
+    {
+      return SerendipityCubeSpace<dim,k>::size();
+    }
+
+    //! get i'th index
+    const LocalKey& localKey (std::size_t i) const
+    {
+      return localKeys()[i];
+    }
+
+    //! The local indices of the degrees of freedom of each subentity, shared by all instances
+    static const SubEntityDofTable& subEntityDofTable ()
+    {
+      static const SubEntityDofTable table(SerendipityCubeLocalCoefficients{});
+      return table;
+    }
+  };
+
+  /** \brief Evaluate the degrees of freedom of the serendipity element, i.e., the values at the nodes
+   *
+   * \tparam LocalBasis The corresponding set of shape functions
+   */
+  template<class LocalBasis>
+  class SerendipityCubeLocalInterpolation
+  {
+    static constexpr auto dim = LocalBasis::Traits::dimDomain;
+    static constexpr auto k = LocalBasis::order();
+    using D = typename LocalBasis::Traits::DomainFieldType;
+
+    static const std::vector<typename LocalBasis::Traits::DomainType>& nodes ()
+    {
+      static const std::vector<typename LocalBasis::Traits::DomainType> nodes = [] {
+        std::vector<typename LocalBasis::Traits::DomainType> result;
+        SerendipityCubeSpace<dim,k>::template forEachNode<D>([&](const auto& x, const LocalKey&) {
+          result.push_back(x);
+        });
+        return result;
+      }();
+      return nodes;
+    }
+
+  public:
+
+    /** \brief Evaluate a given function at the nodes
+     *
+     * \tparam F Type of function to evaluate
+     * \tparam C Type used for the values of the function
+     * \param[in] f Function to evaluate
+     * \param[out] out Array of function values
+     */
+    template<typename F, typename C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      const auto& x = nodes();
+      out.resize(x.size());
+      for (auto n : Dune::range(x.size()))
+        out[n] = f(x[n]);
+    }
+  };
+
+} }    // namespace Dune::Impl
+
+namespace Dune
+{
+  /** \brief Serendipity finite element of arbitrary order on cubes
+   *
+   * The shape functions span the serendipity space \f$S_k\f$ of the
+   * polynomials of superlinear degree at most k, which contains \f$P_k\f$ and
+   * has the same traces on the edges as the Lagrange element \f$Q_k\f$ of
+   * LagrangeCubeLocalFiniteElement, but far fewer degrees of freedom in the
+   * interior of the faces and of the element, e.g., 8 instead of 9 for k=2
+   * in 2d and 20 instead of 27 for k=2 and 32 instead of 64 for k=3 in 3d.
+   * The degrees of freedom are the values at the vertices, at k-1 equidistant
+   * points on each edge, and for k>=4 at a few points in the interior of the
+   * faces, see Impl::SerendipityCubeSpace. In 3d only the orders k<=4 are
+   * implemented, for which a face has at most its center as interior node.
+   *
+   * \tparam D type used for domain coordinates
+   * \tparam R type used for function values
+   * \tparam dim dimension of the reference element
+   * \tparam k polynomial order
+   */
+  template<class D, class R, int dim, int k>
+  class SerendipityCubeLocalFiniteElement
+  {
+    static_assert(k >= 1, "SerendipityCubeLocalFiniteElement requires k>=1");
+
+  public:
+    /** \brief Export number types, dimensions, etc.
+     */
+    using Traits = LocalFiniteElementTraits<Impl::SerendipityCubeLocalBasis<D,R,dim,k>,
+                                            Impl::SerendipityCubeLocalCoefficients<dim,k>,
+                                            Impl::SerendipityCubeLocalInterpolation<Impl::SerendipityCubeLocalBasis<D,R,dim,k> > >;
+
+    /** \brief Returns the local basis, i.e., the set of shape functions
+     */
+    const typename Traits::LocalBasisType& localBasis () const
+    {
+      return basis_;
+    }
+
+    /** \brief Returns the assignment of the degrees of freedom to the element subentities
+     */
+    const typename Traits::LocalCoefficientsType& localCoefficients () const
+    {
+      return coefficients_;
+    }
+
+    /** \brief Returns object that evaluates degrees of freedom
+     */
+    const typename Traits::LocalInterpolationType& localInterpolation () const
+    {
+      return interpolation_;
+    }
+
+    /** \brief The number of shape functions */
+    static constexpr std::size_t size ()
+    {
+      return Impl::SerendipityCubeLocalBasis<D,R,dim,k>::size();
+    }
+
+    /** \brief The reference element that the local finite element is defined on
+     */
+    static constexpr GeometryType type ()
+    {
+      return GeometryTypes::cube(dim);
+    }
+
+  private:
+    Impl::SerendipityCubeLocalBasis<D,R,dim,k> basis_;
+    Impl::SerendipityCubeLocalCoefficients<dim,k> coefficients_;
+    Impl::SerendipityCubeLocalInterpolation<Impl::SerendipityCubeLocalBasis<D,R,dim,k> > interpolation_;
+  };
+
+}        // namespace Dune
+
+#endif   // DUNE_LOCALFUNCTIONS_SERENDIPITY_SERENDIPITYCUBE_HH
@@ -0,0 +1,65 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_SERENDIPITY_SERENDIPITYLFECACHE_HH
+#define DUNE_LOCALFUNCTIONS_SERENDIPITY_SERENDIPITYLFECACHE_HH
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <dune/geometry/type.hh>
+#include <dune/geometry/typeindex.hh>
+
+#include <dune/localfunctions/common/localfiniteelementvariantcache.hh>
+#include <dune/localfunctions/serendipity/serendipitycube.hh>
+
+
+namespace Dune {
+
+
+
+namespace Impl {
+
+  // Provide implemented serendipity local finite elements
+
+  template<class D, class R, std::size_t dim, std::size_t order>
+  struct ImplementedSerendipityFiniteElements : public FixedDimLocalGeometryTypeIndex<dim>
+  {
+    using FixedDimLocalGeometryTypeIndex<dim>::index;
+    static auto getImplementations()
+    {
+      return std::make_tuple(
+        std::make_pair(index(GeometryTypes::cube(dim)), []() { return SerendipityCubeLocalFiniteElement<D,R,dim,order>(); })
+      );
+    }
+  };
+
+} // namespace Impl
+
+
+
+/** \brief A cache that stores the serendipity local finite elements for the given dimension and order
+ *
+ * Serendipity elements are only implemented on cubes.
+ *
+ * \tparam D Type used for domain coordinates
+ * \tparam R Type used for shape function values
+ * \tparam dim Element dimension
+ * \tparam order Element order
+ * \tparam lazy Create the elements on first request, see LocalFiniteElementVariantCache
+ *
+ * The cached finite element implementations can be obtained using get(GeometryType).
+ */
+template<class D, class R, std::size_t dim, std::size_t order, bool lazy = false>
+using SerendipityLocalFiniteElementCache = LocalFiniteElementVariantCache<Impl::ImplementedSerendipityFiniteElements<D,R,dim,order>, lazy>;
+
+
+
+} // namespace Dune
+
+
+
+
+#endif // DUNE_LOCALFUNCTIONS_SERENDIPITY_SERENDIPITYLFECACHE_HH
@@ -0,0 +1,55 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+// Writes the header with the generated bases used by test-basiscodegenerator.cc
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/lagrange/equidistantpoints.hh>
+#include <dune/localfunctions/lagrange/lagrangebasis.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex/raviartthomassimplexbasis.hh>
+#include <dune/localfunctions/utility/basiscodegenerator.hh>
+
+template<class BasisFactory, Dune::GeometryType::Id geometryId>
+void generate(std::ostream& out, unsigned int order, const std::string& className)
+{
+  const typename BasisFactory::Object& basis = *BasisFactory::template create<geometryId>(order);
+  out << "\n";
+  Dune::generateBasisCode<geometryId>(out, basis, className);
+  BasisFactory::release(&basis);
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <header>" << std::endl;
+    return 1;
+  }
+
+  std::ofstream out(argv[1]);
+  out << "#ifndef DUNE_LOCALFUNCTIONS_TEST_GENERATEDBASES_HH\n"
+      << "#define DUNE_LOCALFUNCTIONS_TEST_GENERATEDBASES_HH\n\n"
+      << "#include <array>\n"
+      << "#include <vector>\n\n"
+      << "#include <dune/common/fmatrix.hh>\n"
+      << "#include <dune/common/fvector.hh>\n\n"
+      << "#include <dune/localfunctions/common/localbasis.hh>\n";
+
+  constexpr auto triangle = Dune::GeometryTypes::triangle;
+  constexpr auto tetrahedron = Dune::GeometryTypes::tetrahedron;
+  constexpr auto prism = Dune::GeometryTypes::prism;
+  generate<Dune::RaviartThomasBasisFactory<2,double,double>,triangle>(out, 0, "GeneratedRaviartThomasSimplex2DOrder0");
+  generate<Dune::RaviartThomasBasisFactory<2,double,double>,triangle>(out, 2, "GeneratedRaviartThomasSimplex2DOrder2");
+  generate<Dune::RaviartThomasBasisFactory<3,double,double>,tetrahedron>(out, 1, "GeneratedRaviartThomasSimplex3DOrder1");
+  generate<Dune::LagrangeBasisFactory<Dune::EquidistantPointSet,3,double,double>,prism>(out, 2, "GeneratedLagrangePrismOrder2");
+
+  out << "\n#endif // DUNE_LOCALFUNCTIONS_TEST_GENERATEDBASES_HH\n";
+  return out ? 0 : 1;
+}
@@ -3,12 +3,119 @@
 // SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
 // SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/referenceelements.hh>
 
 #include <dune/localfunctions/hierarchical.hh>
 
 #include <dune/localfunctions/test/test-localfe.hh>
 
+// Check that the shape functions of order k-1 are a prefix of the shape functions of order k
+template<class FE, class FEReduced>
+bool testHierarchy(const FE& fe, const FEReduced& feReduced)
+{
+  bool success = true;
+  const auto& quad = Dune::QuadratureRules<double,FE::Traits::LocalBasisType::Traits::dimDomain>::rule(fe.type(), 3);
+  std::vector<typename FE::Traits::LocalBasisType::Traits::RangeType> values, valuesReduced;
+  for (const auto& qp : quad)
+  {
+    fe.localBasis().evaluateFunction(qp.position(), values);
+    feReduced.localBasis().evaluateFunction(qp.position(), valuesReduced);
+    for (std::size_t i=0; i<feReduced.size(); ++i)
+      if (std::abs(values[i]-valuesReduced[i]) > 1e-10)
+      {
+        std::cerr << "Shape function " << i << " of hierarchical element changes when raising the order" << std::endl;
+        success = false;
+      }
+  }
+  for (std::size_t i=0; i<feReduced.size(); ++i)
+  {
+    const auto& key = fe.localCoefficients().localKey(i);
+    const auto& keyReduced = feReduced.localCoefficients().localKey(i);
+    if ((key < keyReduced) or (keyReduced < key))
+    {
+      std::cerr << "Local key " << i << " of hierarchical element changes when raising the order" << std::endl;
+      success = false;
+    }
+  }
+  return success;
+}
+
+// Check that the shape functions of two elements with given global vertex numbers coincide
+// on their shared subentities, i.e., that the element is conforming for any vertex numbering.
+template<class FE, int dim>
+bool testConformity(const std::vector<Dune::FieldVector<double,dim>>& corners0, const std::vector<unsigned int>& ids0,
+                    const std::vector<Dune::FieldVector<double,dim>>& corners1, const std::vector<unsigned int>& ids1)
+{
+  bool success = true;
+  const FE fe0(ids0), fe1(ids1);
+  const auto type = FE::type();
+  const auto& refElement = Dune::ReferenceElements<double,dim>::general(type);
+  const Dune::MultiLinearGeometry<double,dim,dim> geometry0(type, corners0), geometry1(type, corners1);
+
+  auto globalVertices = [&](const auto& ids, const Dune::LocalKey& key) {
+    std::vector<unsigned int> result;
+    for (int l=0; l<refElement.size(key.subEntity(), key.codim(), dim); ++l)
+      result.push_back(ids[refElement.subEntity(key.subEntity(), key.codim(), l, dim)]);
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  std::vector<typename FE::Traits::LocalBasisType::Traits::RangeType> values0, values1;
+  for (std::size_t i=0; i<fe0.size(); ++i)
+  {
+    const auto& key0 = fe0.localCoefficients().localKey(i);
+    const auto vertices0 = globalVertices(ids0, key0);
+    if (not std::all_of(vertices0.begin(), vertices0.end(), [&](auto v) {
+      return std::find(ids1.begin(), ids1.end(), v) != ids1.end(); }))
+      continue;
+
+    // Find the corresponding shape function of the neighbor
+    std::size_t j = 0;
+    while ((j < fe1.size()) and not ((fe1.localCoefficients().localKey(j).index() == key0.index())
+                                     and (fe1.localCoefficients().localKey(j).codim() == key0.codim())
+                                     and (globalVertices(ids1, fe1.localCoefficients().localKey(j)) == vertices0)))
+      ++j;
+    if (j == fe1.size())
+    {
+      std::cerr << "No matching shape function for shared degree of freedom " << i << std::endl;
+      success = false;
+      continue;
+    }
+
+    // Compare the shape functions at points on the shared subentity
+    for (int sample=0; sample<5; ++sample)
+    {
+      Dune::FieldVector<double,dim> x(0);
+      double weightSum = 0;
+      for (int l=0; l<refElement.size(key0.subEntity(), key0.codim(), dim); ++l)
+      {
+        const double weight = 1.0 + std::sin(1.0 + 3*sample + 7*l);
+        x.axpy(weight, corners0[refElement.subEntity(key0.subEntity(), key0.codim(), l, dim)]);
+        weightSum += weight;
+      }
+      x /= weightSum;
+      fe0.localBasis().evaluateFunction(geometry0.local(x), values0);
+      fe1.localBasis().evaluateFunction(geometry1.local(x), values1);
+      if (std::abs(values0[i]-values1[j]) > 1e-10)
+      {
+        std::cerr << "Shape functions " << i << " and " << j << " do not coincide on shared subentity: "
+                  << values0[i] << " != " << values1[j] << std::endl;
+        success = false;
+      }
+    }
+  }
+  return success;
+}
+
 int main(int argc, char** argv)
 {
   bool success = true;
@@ -34,5 +141,54 @@ int main(int argc, char** argv)
   Dune::HierarchicalP2WithElementBubbleLocalFiniteElement<double,double,3> hierarchicalp2bubble3dlfem;
   TEST_FE(hierarchicalp2bubble3dlfem);
 
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto km1) {
+    constexpr int k = km1+1;
+
+    Dune::HierarchicalCubeLocalFiniteElement<double,double,1,k> hierarchicalCube1d;
+    TEST_FE3(hierarchicalCube1d, DisableNone, 2);
+    Dune::HierarchicalCubeLocalFiniteElement<double,double,2,k> hierarchicalCube2d;
+    TEST_FE3(hierarchicalCube2d, DisableNone, 2);
+    Dune::HierarchicalCubeLocalFiniteElement<double,double,3,k> hierarchicalCube3d;
+    TEST_FE3(hierarchicalCube3d, DisableNone, 2);
+
+    Dune::HierarchicalSimplexLocalFiniteElement<double,double,1,k> hierarchicalSimplex1d;
+    TEST_FE3(hierarchicalSimplex1d, DisableNone, 1);
+    Dune::HierarchicalSimplexLocalFiniteElement<double,double,2,k> hierarchicalSimplex2d;
+    TEST_FE3(hierarchicalSimplex2d, DisableNone, 1);
+    Dune::HierarchicalSimplexLocalFiniteElement<double,double,3,k> hierarchicalSimplex3d;
+    TEST_FE3(hierarchicalSimplex3d, DisableNone, 1);
+
+    if constexpr (k > 1)
+    {
+      success &= testHierarchy(hierarchicalCube2d, Dune::HierarchicalCubeLocalFiniteElement<double,double,2,k-1>());
+      success &= testHierarchy(hierarchicalCube3d, Dune::HierarchicalCubeLocalFiniteElement<double,double,3,k-1>());
+      success &= testHierarchy(hierarchicalSimplex2d, Dune::HierarchicalSimplexLocalFiniteElement<double,double,2,k-1>());
+      success &= testHierarchy(hierarchicalSimplex3d, Dune::HierarchicalSimplexLocalFiniteElement<double,double,3,k-1>());
+    }
+
+    // Two elements sharing a facet with different local orientations
+    success &= testConformity<Dune::HierarchicalSimplexLocalFiniteElement<double,double,2,k>,2>(
+      {{0,0}, {1,0}, {0,1}}, {0, 1, 2},
+      {{1,1}, {0,1}, {1,0}}, {3, 2, 1});
+    success &= testConformity<Dune::HierarchicalSimplexLocalFiniteElement<double,double,3,k>,3>(
+      {{0,0,0}, {1,0,0}, {0,1,0}, {0,0,1}}, {0, 1, 2, 3},
+      {{1,1,1}, {0,0,1}, {1,0,0}, {0,1,0}}, {4, 3, 1, 2});
+    success &= testConformity<Dune::HierarchicalCubeLocalFiniteElement<double,double,2,k>,2>(
+      {{0,0}, {1,0}, {0,1}, {1,1}}, {0, 1, 2, 3},
+      {{1,1}, {2,1}, {1,0}, {2,0}}, {3, 5, 1, 4});
+    success &= testConformity<Dune::HierarchicalCubeLocalFiniteElement<double,double,3,k>,3>(
+      {{0,0,0}, {1,0,0}, {0,1,0}, {1,1,0}, {0,0,1}, {1,0,1}, {0,1,1}, {1,1,1}}, {0, 1, 2, 3, 4, 5, 6, 7},
+      {{1,1,0}, {1,0,0}, {2,1,0}, {2,0,0}, {1,1,1}, {1,0,1}, {2,1,1}, {2,0,1}}, {3, 1, 8, 9, 7, 5, 10, 11});
+  });
+
+  Dune::HierarchicalSimplexLocalFiniteElement<double,double,3,4> hierarchicalSimplexPermuted(std::array<unsigned int,4>{3,0,2,1});
+  TEST_FE3(hierarchicalSimplexPermuted, DisableNone, 1);
+
+  Dune::HierarchicalCubeLocalFiniteElement<double,double,3,4> hierarchicalCubePermuted(std::array<unsigned int,8>{7,2,5,0,3,6,1,4});
+  TEST_FE3(hierarchicalCubePermuted, DisableNone, 2);
+
+  Dune::HierarchicalSimplexLocalFiniteElement<double,double,4,3> hierarchicalSimplex4d;
+  TEST_FE(hierarchicalSimplex4d);
+
   return success ? 0 : 1;
 }
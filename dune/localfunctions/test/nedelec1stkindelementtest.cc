@@ -54,5 +54,30 @@ int main(int argc, char** argv)
     TEST_FE3(nedelecLFEMCube1stOrder, DisableNone, 2);
   }
 
+  // Higher orders on squares and cubes
+  Nedelec1stKindCubeLocalFiniteElement<double,double,2,2> nedelecLFEMSquare2ndOrder;
+  TEST_FE3(nedelecLFEMSquare2ndOrder, DisableNone, 2);
+
+  for (unsigned int s = 0; s < 16; s++)
+  {
+    Nedelec1stKindCubeLocalFiniteElement<double,double,2,2> nedelecLFEMSquare2ndOrder(s);
+    TEST_FE3(nedelecLFEMSquare2ndOrder, DisableNone, 2);
+  }
+
+  Nedelec1stKindCubeLocalFiniteElement<double,double,2,4> nedelecLFEMSquare4thOrder;
+  TEST_FE3(nedelecLFEMSquare4thOrder, DisableNone, 2);
+
+  Nedelec1stKindCubeLocalFiniteElement<double,double,3,2> nedelecLFEMCube2ndOrder;
+  TEST_FE3(nedelecLFEMCube2ndOrder, DisableNone, 2);
+
+  for (unsigned int s = 0; s < 4096; s += 91)
+  {
+    Nedelec1stKindCubeLocalFiniteElement<double,double,3,2> nedelecLFEMCube2ndOrder(s);
+    TEST_FE3(nedelecLFEMCube2ndOrder, DisableNone, 2);
+  }
+
+  Nedelec1stKindCubeLocalFiniteElement<double,double,3,3> nedelecLFEMCube3rdOrder;
+  TEST_FE3(nedelecLFEMCube3rdOrder, DisableNone, 2);
+
   return success ? 0 : 1;
 }
@@ -84,6 +84,26 @@ int main(int argc, char** argv)
     TEST_FE(rt4cube2dlfem);
   }
 
+  // Tensor-product elements of arbitrary order
+  Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,5> rt5cube2dlfem;
+  TEST_FE3(rt5cube2dlfem, DisableNone, 2);
+  for (unsigned int s = 0; s < 16; s++)
+  {
+    Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,5> rt5cube2dlfem(s);
+    TEST_FE(rt5cube2dlfem);
+  }
+
+  Dune::RaviartThomasCubeLocalFiniteElement<double,double,3,2> rt2cube3dlfem;
+  TEST_FE3(rt2cube3dlfem, DisableNone, 2);
+  for (unsigned int s = 0; s < 64; s++)
+  {
+    Dune::RaviartThomasCubeLocalFiniteElement<double,double,3,2> rt2cube3dlfem(s);
+    TEST_FE(rt2cube3dlfem);
+  }
+
+  Dune::RaviartThomasCubeLocalFiniteElement<double,double,3,3> rt3cube3dlfem;
+  TEST_FE3(rt3cube3dlfem, DisableNone, 2);
+
   Dune::RT0Cube2DLocalFiniteElement<double,double> rt0cube2dlfemDedicated;
   TEST_FE(rt0cube2dlfemDedicated);
   for (unsigned int s = 0; s < 16; s++)
@@ -176,5 +196,8 @@ int main(int argc, char** argv)
   }
   success &= lagrangeLFESuccess;
 
+  Dune::RaviartThomasLocalFiniteElementCache<double,double,3,2> rt2LFECache;
+  TEST_FE(rt2LFECache.get(Dune::GeometryTypes::cube(3)));
+
   return success ? 0 : 1;
 }
@@ -3,13 +3,156 @@
 // SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
 // SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
 
+#include <cmath>
 #include <iostream>
+#include <vector>
 
+#include <dune/common/dynvector.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/localfunctions/lagrange/lagrangelfecache.hh>
+#include <dune/localfunctions/refined/common/refinementtransfer.hh>
+#include <dune/localfunctions/refined/refinedlagrange.hh>
 #include <dune/localfunctions/refined/refinedp1.hh>
 #include <dune/localfunctions/refined/refinedp0.hh>
 
 #include <dune/localfunctions/test/test-localfe.hh>
 
+// Check that the children of UniformRefinementChildren are numbered as the subelements of RefinedSimplexLocalBasis
+template<int dim>
+struct TestRefinedSimplexChildren
+  : public Dune::RefinedSimplexLocalBasis<double,dim>
+{
+  static bool test ()
+  {
+    bool success = true;
+    Dune::UniformRefinementChildren<double,dim> children(Dune::GeometryTypes::simplex(dim));
+    for (std::size_t c = 0; c < children.size(); ++c)
+    {
+      const auto& child = children.geometry(c);
+      const auto center = child.center();
+      int subElement;
+      Dune::FieldVector<double,dim> local;
+      TestRefinedSimplexChildren::getSubElement(center, subElement, local);
+      if (subElement != int(c) or (local - child.local(center)).two_norm() > 1e-12)
+      {
+        std::cout << "Child " << c << " of the " << dim << "d simplex does not match RefinedSimplexLocalBasis" << std::endl;
+        success = false;
+      }
+    }
+    return success;
+  }
+};
+
+// Check the prolongation and restriction matrices of Lagrange elements
+template<class Cache>
+bool testRefinementTransfer (const Cache& cache, Dune::GeometryType type)
+{
+  bool success = true;
+  Dune::RefinementTransferMatricesCache<Cache> transferCache(cache);
+  const auto& fe = cache.get(type);
+  const auto& transfer = transferCache.get(type);
+  const std::size_t n = fe.size();
+  constexpr int dim = Cache::FiniteElementType::Traits::LocalBasisType::Traits::dimDomain;
+
+  Dune::DynamicVector<double> parent(n), childCoefficients(n), restricted(n, 0.0);
+  for (std::size_t i = 0; i < n; ++i)
+    parent[i] = std::cos(1.0 + i);
+
+  std::vector<typename Cache::FiniteElementType::Traits::LocalBasisType::Traits::RangeType> parentValues, childValues;
+  for (std::size_t c = 0; c < transfer.children().size(); ++c)
+  {
+    const auto& child = transfer.children().geometry(c);
+    transfer.prolongation(c).mv(parent, childCoefficients);
+    transfer.restriction(c).umv(childCoefficients, restricted);
+
+    // The prolongated function coincides with the parent function on the child
+    for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(type, 3))
+    {
+      fe.localBasis().evaluateFunction(qp.position(), childValues);
+      fe.localBasis().evaluateFunction(child.global(qp.position()), parentValues);
+      double childValue = 0, parentValue = 0;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        childValue += childCoefficients[i] * childValues[i][0];
+        parentValue += parent[i] * parentValues[i][0];
+      }
+      // Written such that NaN values fail as well
+      if (!(std::abs(childValue - parentValue) <= 1e-10))
+      {
+        std::cout << "Prolongation to child " << c << " of " << type << " with "
+                  << n << " shape functions is wrong" << std::endl;
+        success = false;
+        break;
+      }
+    }
+  }
+
+  // The restriction of the prolongated function gives the original coefficients
+  restricted -= parent;
+  if (!(restricted.two_norm() <= 1e-10))
+  {
+    std::cout << "Restriction of " << type << " with " << n
+              << " shape functions is not the left inverse of the prolongation" << std::endl;
+    success = false;
+  }
+  return success;
+}
+
+// Whether a point is on the boundary of a subsimplex of the refinement of the reference simplex into n^dim subsimplices
+template<int dim>
+bool onSubsimplexBoundary (const Dune::FieldVector<double,dim>& x, int n)
+{
+  for (int i = 0; i < dim; ++i)
+  {
+    double z = 0;
+    for (int l = i; l < dim; ++l)
+    {
+      z += n*x[l];
+      if (std::abs(z - std::round(z)) < 1e-8)
+        return true;
+    }
+  }
+  return false;
+}
+
+// Whether a point is on the boundary of a subcube of the refinement of the reference cube into n^dim subcubes
+template<int dim>
+bool onSubcubeBoundary (const Dune::FieldVector<double,dim>& x, int n)
+{
+  for (int i = 0; i < dim; ++i)
+    if (std::abs(n*x[i] - std::round(n*x[i])) < 1e-8)
+      return true;
+  return false;
+}
+
+// Check that two local bases have the same values at the points of a quadrature rule,
+// and the same Jacobians at the points where both are differentiable
+template<class LB1, class LB2>
+bool testEqualBases (const LB1& basis1, const LB2& basis2, Dune::GeometryType type, int n = 1)
+{
+  constexpr int dim = LB1::Traits::dimDomain;
+  bool success = (basis1.size() == basis2.size());
+  std::vector<typename LB1::Traits::RangeType> values1, values2;
+  std::vector<typename LB1::Traits::JacobianType> jacobians1, jacobians2;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(type, 5))
+  {
+    basis1.evaluateFunction(qp.position(), values1);
+    basis2.evaluateFunction(qp.position(), values2);
+    basis1.evaluateJacobian(qp.position(), jacobians1);
+    basis2.evaluateJacobian(qp.position(), jacobians2);
+    const bool differentiable = not onSubsimplexBoundary(qp.position(), n);
+    for (std::size_t i = 0; success and i < basis1.size(); ++i)
+      success = std::abs(values1[i][0] - values2[i][0]) < 1e-12
+                and (not differentiable or (jacobians1[i][0] - jacobians2[i][0]).two_norm() < 1e-10);
+  }
+  if (not success)
+    std::cout << "Refined Lagrange basis on " << type << " does not coincide with the reference basis" << std::endl;
+  return success;
+}
+
 int main(int argc, char** argv)
 {
   bool success = true;
@@ -29,5 +172,54 @@ int main(int argc, char** argv)
   Dune::RefinedP0LocalFiniteElement<double,double,2> refp02dlfem;
   TEST_FE(refp02dlfem);
 
+  Dune::RefinedLagrangeSimplexLocalFiniteElement<double,double,1,1,1> reflagrange111lfem;
+  TEST_FE4(reflagrange111lfem, DisableNone, 0, [](const auto& x) { return onSubsimplexBoundary(x, 2); });
+
+  Dune::RefinedLagrangeSimplexLocalFiniteElement<double,double,1,3,2> reflagrange132lfem;
+  TEST_FE4(reflagrange132lfem, DisableNone, 0, [](const auto& x) { return onSubsimplexBoundary(x, 4); });
+
+  Dune::RefinedLagrangeSimplexLocalFiniteElement<double,double,2,1,1> reflagrange211lfem;
+  TEST_FE4(reflagrange211lfem, DisableNone, 0, [](const auto& x) { return onSubsimplexBoundary(x, 2); });
+
+  Dune::RefinedLagrangeSimplexLocalFiniteElement<double,double,2,2,2> reflagrange222lfem;
+  TEST_FE4(reflagrange222lfem, DisableNone, 0, [](const auto& x) { return onSubsimplexBoundary(x, 4); });
+
+  Dune::RefinedLagrangeSimplexLocalFiniteElement<double,double,3,1,2> reflagrange312lfem;
+  TEST_FE4(reflagrange312lfem, DisableNone, 0, [](const auto& x) { return onSubsimplexBoundary(x, 4); });
+
+  Dune::RefinedLagrangeSimplexLocalFiniteElement<double,double,3,2,1> reflagrange321lfem;
+  TEST_FE4(reflagrange321lfem, DisableNone, 0, [](const auto& x) { return onSubsimplexBoundary(x, 2); });
+
+  Dune::RefinedLagrangeCubeLocalFiniteElement<double,double,1,2,2> reflagrangecube122lfem;
+  TEST_FE4(reflagrangecube122lfem, DisableNone, 0, [](const auto& x) { return onSubcubeBoundary(x, 4); });
+
+  Dune::RefinedLagrangeCubeLocalFiniteElement<double,double,2,2,1> reflagrangecube221lfem;
+  TEST_FE4(reflagrangecube221lfem, DisableNone, 0, [](const auto& x) { return onSubcubeBoundary(x, 2); });
+
+  Dune::RefinedLagrangeCubeLocalFiniteElement<double,double,3,1,2> reflagrangecube312lfem;
+  TEST_FE4(reflagrangecube312lfem, DisableNone, 0, [](const auto& x) { return onSubcubeBoundary(x, 4); });
+
+  // In one and two dimensions the subdivision coincides with the one of RefinedP1LocalFiniteElement
+  success &= testEqualBases(reflagrange111lfem.localBasis(), refp11dlfem.localBasis(), Dune::GeometryTypes::line, 2);
+  success &= testEqualBases(reflagrange211lfem.localBasis(), refp12dlfem.localBasis(), Dune::GeometryTypes::triangle, 2);
+
+  // Without refinement the elements are the Lagrange elements
+  success &= testEqualBases(Dune::Impl::RefinedLagrangeSimplexLocalBasis<double,double,3,3,0>(),
+                            Dune::Impl::LagrangeSimplexLocalBasis<double,double,3,3>(), Dune::GeometryTypes::tetrahedron);
+  success &= testEqualBases(Dune::Impl::RefinedLagrangeCubeLocalBasis<double,double,2,3,0>(),
+                            Dune::Impl::LagrangeCubeLocalBasis<double,double,2,3>(), Dune::GeometryTypes::quadrilateral);
+
+  success &= TestRefinedSimplexChildren<1>::test();
+  success &= TestRefinedSimplexChildren<2>::test();
+  success &= TestRefinedSimplexChildren<3>::test();
+
+  Dune::Hybrid::forEach(std::make_index_sequence<4>{}, [&](auto k) {
+    success &= testRefinementTransfer(Dune::LagrangeLocalFiniteElementCache<double,double,1,k>(), Dune::GeometryTypes::line);
+    success &= testRefinementTransfer(Dune::LagrangeLocalFiniteElementCache<double,double,2,k>(), Dune::GeometryTypes::triangle);
+    success &= testRefinementTransfer(Dune::LagrangeLocalFiniteElementCache<double,double,2,k>(), Dune::GeometryTypes::quadrilateral);
+    success &= testRefinementTransfer(Dune::LagrangeLocalFiniteElementCache<double,double,3,k>(), Dune::GeometryTypes::tetrahedron);
+    success &= testRefinementTransfer(Dune::LagrangeLocalFiniteElementCache<double,double,3,k>(), Dune::GeometryTypes::hexahedron);
+  });
+
   return success ? 0 : 1;
 }
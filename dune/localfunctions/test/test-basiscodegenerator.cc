@@ -0,0 +1,168 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localfiniteelementtraits.hh>
+#include <dune/localfunctions/lagrange.hh>
+#include <dune/localfunctions/lagrange/equidistantpoints.hh>
+#include <dune/localfunctions/lagrange/lagrangebasis.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex/raviartthomassimplexbasis.hh>
+
+#include "test-localfe.hh"
+
+// Written by generatebases.cc at build time
+#include "generatedbases.hh"
+
+// Compare the generated basis with the basis created by the factory at the points of a quadrature rule
+template<class BasisFactory, Dune::GeometryType::Id geometryId, class GeneratedBasis>
+bool testGeneratedBasis(unsigned int order, const GeneratedBasis& generated)
+{
+  using Traits = typename GeneratedBasis::Traits;
+  constexpr Dune::GeometryType geometry = geometryId;
+  const typename BasisFactory::Object& basis = *BasisFactory::template create<geometryId>(order);
+
+  bool success = (generated.size() == basis.size()) and (generated.order() == basis.order());
+  std::vector<typename Traits::RangeType> y, yGenerated;
+  std::vector<typename Traits::JacobianType> dy, dyGenerated;
+  for (const auto& qp : Dune::QuadratureRules<double,geometry.dim()>::rule(geometry, 4))
+  {
+    // Partial derivatives of total order at most 2, the highest one the polynomial basis implements,
+    // and the ones of order up to order+1 in each direction otherwise
+    std::array<unsigned int,geometry.dim()> alpha = {};
+    for (bool next = true; next; )
+    {
+      if (std::accumulate(alpha.begin(), alpha.end(), 0u) <= 2)
+      {
+        basis.partial(alpha, qp.position(), y);
+        generated.partial(alpha, qp.position(), yGenerated);
+        success &= (yGenerated.size() == y.size());
+        for (std::size_t i = 0; success and i < y.size(); ++i)
+          success &= (yGenerated[i] - y[i]).infinity_norm() < 1e-10;
+      }
+      // Derivatives of higher order than the polynomials in one direction vanish
+      else if (*std::max_element(alpha.begin(), alpha.end()) > basis.order())
+      {
+        generated.partial(alpha, qp.position(), yGenerated);
+        for (const auto& value : yGenerated)
+          success &= (value.infinity_norm() == 0);
+      }
+
+      next = false;
+      for (std::size_t j = 0; not next and j < alpha.size(); ++j)
+        if (alpha[j] <= order)
+          ++alpha[j], next = true;
+        else
+          alpha[j] = 0;
+    }
+
+    basis.evaluateFunction(qp.position(), y);
+    basis.evaluateJacobian(qp.position(), dy);
+    generated.evaluateFunction(qp.position(), yGenerated);
+    generated.evaluateJacobian(qp.position(), dyGenerated);
+    success &= (yGenerated.size() == y.size()) and (dyGenerated.size() == dy.size());
+    for (std::size_t i = 0; success and i < y.size(); ++i)
+    {
+      success &= (yGenerated[i] - y[i]).infinity_norm() < 1e-10;
+      success &= (dyGenerated[i] - dy[i]).infinity_norm() < 1e-10;
+    }
+  }
+  if (not success)
+    std::cout << "Generated basis " << Dune::className(generated) << " differs from the polynomial basis" << std::endl;
+
+  BasisFactory::release(&basis);
+  return success;
+}
+
+// A finite element with the generated basis and the coefficients and interpolation of another one
+template<class GeneratedBasis, class FE>
+class GeneratedFiniteElement
+{
+public:
+  using Traits = Dune::LocalFiniteElementTraits<GeneratedBasis,
+      typename FE::Traits::LocalCoefficientsType, typename FE::Traits::LocalInterpolationType>;
+
+  explicit GeneratedFiniteElement (const FE& fe)
+    : fe_(fe)
+  {}
+
+  const typename Traits::LocalBasisType& localBasis () const
+  {
+    return basis_;
+  }
+
+  const typename Traits::LocalCoefficientsType& localCoefficients () const
+  {
+    return fe_.localCoefficients();
+  }
+
+  const typename Traits::LocalInterpolationType& localInterpolation () const
+  {
+    return fe_.localInterpolation();
+  }
+
+  unsigned int size () const
+  {
+    return basis_.size();
+  }
+
+  Dune::GeometryType type () const
+  {
+    return fe_.type();
+  }
+
+private:
+  GeneratedBasis basis_;
+  FE fe_;
+};
+
+template<class GeneratedBasis, class FE>
+GeneratedFiniteElement<GeneratedBasis,FE> generatedFiniteElement(const FE& fe)
+{
+  return GeneratedFiniteElement<GeneratedBasis,FE>(fe);
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  constexpr auto triangle = Dune::GeometryTypes::triangle;
+  constexpr auto tetrahedron = Dune::GeometryTypes::tetrahedron;
+  constexpr auto prism = Dune::GeometryTypes::prism;
+  success &= testGeneratedBasis<Dune::RaviartThomasBasisFactory<2,double,double>,triangle>(
+    0, Dune::GeneratedRaviartThomasSimplex2DOrder0<double,double>());
+  success &= testGeneratedBasis<Dune::RaviartThomasBasisFactory<2,double,double>,triangle>(
+    2, Dune::GeneratedRaviartThomasSimplex2DOrder2<double,double>());
+  success &= testGeneratedBasis<Dune::RaviartThomasBasisFactory<3,double,double>,tetrahedron>(
+    1, Dune::GeneratedRaviartThomasSimplex3DOrder1<double,double>());
+  success &= testGeneratedBasis<Dune::LagrangeBasisFactory<Dune::EquidistantPointSet,3,double,double>,prism>(
+    2, Dune::GeneratedLagrangePrismOrder2<double,double>());
+
+  // The generated bases as part of finite elements, including their higher derivatives
+  using RT2D = Dune::RaviartThomasSimplexLocalFiniteElement<2,double,double>;
+  using RT3D = Dune::RaviartThomasSimplexLocalFiniteElement<3,double,double>;
+  using LagrangePrism = Dune::LagrangeLocalFiniteElement<Dune::EquidistantPointSet,3,double,double>;
+  const auto rt2dOrder0 = generatedFiniteElement<Dune::GeneratedRaviartThomasSimplex2DOrder0<double,double> >(RT2D(triangle, 0));
+  const auto rt2dOrder2 = generatedFiniteElement<Dune::GeneratedRaviartThomasSimplex2DOrder2<double,double> >(RT2D(triangle, 2));
+  const auto rt3dOrder1 = generatedFiniteElement<Dune::GeneratedRaviartThomasSimplex3DOrder1<double,double> >(RT3D(tetrahedron, 1));
+  const auto lagrangePrismOrder2 = generatedFiniteElement<Dune::GeneratedLagrangePrismOrder2<double,double> >(LagrangePrism(prism, 2));
+  TEST_FE3(rt2dOrder0, DisableNone, 2);
+  TEST_FE3(rt2dOrder2, DisableNone, 2);
+  TEST_FE3(rt3dOrder1, DisableNone, 2);
+  TEST_FE3(lagrangePrismOrder2, DisableNone, 2);
+
+  return success ? 0 : 1;
+}
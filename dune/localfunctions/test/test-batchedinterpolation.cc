@@ -0,0 +1,95 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/brezzidouglasmarini/brezzidouglasmarini1simplex2d.hh>
+#include <dune/localfunctions/lagrange/lagrangelfecache.hh>
+#include <dune/localfunctions/nedelec/nedelec1stkindsimplex.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomascube.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex.hh>
+#include <dune/localfunctions/utility/batchedinterpolation.hh>
+
+// Check that the batched interpolation of a smooth function coincides with the interpolation of the local finite element
+template<class FE>
+bool testBatchedInterpolation (const FE& fe, const Dune::BatchedLocalInterpolation<FE>& batched, const char* name)
+{
+  using RangeType = typename FE::Traits::LocalBasisType::Traits::RangeType;
+  using DomainType = typename FE::Traits::LocalBasisType::Traits::DomainType;
+  auto f = [](const DomainType& x) {
+    RangeType y;
+    for (std::size_t c = 0; c < y.size(); ++c)
+      y[c] = std::sin(1.0 + c + x[0]) * std::exp(x[x.size()-1] - 0.5*c);
+    return y;
+  };
+
+  std::vector<RangeType> values;
+  for (const auto& x : batched.points())
+    values.push_back(f(x));
+
+  std::vector<double> expected, coefficients;
+  fe.localInterpolation().interpolate(f, expected);
+  batched.interpolate(values, coefficients);
+
+  bool success = (coefficients.size() == fe.size() and batched.size() == fe.size());
+  for (std::size_t i = 0; success and i < fe.size(); ++i)
+    success = std::abs(coefficients[i] - expected[i]) < 1e-10;
+  if (not success)
+    std::cout << "Batched interpolation of " << name << " does not coincide with the local interpolation" << std::endl;
+  return success;
+}
+
+template<class FE>
+bool testBatchedInterpolation (const FE& fe, const char* name)
+{
+  return testBatchedInterpolation(fe, Dune::BatchedLocalInterpolation<FE>(fe), name);
+}
+
+int main (int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<4>{}, [&](auto k) {
+    Dune::LagrangeLocalFiniteElementCache<double,double,2,k> cache2d;
+    Dune::BatchedLocalInterpolationCache<decltype(cache2d)> batchedCache2d(cache2d);
+    for (auto type : {Dune::GeometryTypes::triangle, Dune::GeometryTypes::quadrilateral})
+    {
+      success &= testBatchedInterpolation(cache2d.get(type), batchedCache2d.get(type), "Lagrange element");
+
+      // The Lagrange nodes are evaluated once and each coefficient is the value at one of them
+      const auto& batched = batchedCache2d.get(type);
+      if (batched.points().size() != cache2d.get(type).size() or &batched != &batchedCache2d.get(type))
+      {
+        std::cout << "Batched interpolation of the Lagrange element of order " << k << " on " << type << " has wrong points" << std::endl;
+        success = false;
+      }
+    }
+
+    Dune::LagrangeLocalFiniteElementCache<double,double,3,k> cache3d;
+    Dune::BatchedLocalInterpolationCache<decltype(cache3d)> batchedCache3d(cache3d);
+    for (auto type : {Dune::GeometryTypes::tetrahedron, Dune::GeometryTypes::hexahedron})
+      success &= testBatchedInterpolation(cache3d.get(type), batchedCache3d.get(type), "Lagrange element");
+  });
+
+  for (unsigned int order : {0, 1, 2})
+  {
+    success &= testBatchedInterpolation(Dune::RaviartThomasSimplexLocalFiniteElement<2,double,double>(Dune::GeometryTypes::triangle, order),
+                                        "Raviart-Thomas simplex element in 2d");
+    success &= testBatchedInterpolation(Dune::RaviartThomasSimplexLocalFiniteElement<3,double,double>(Dune::GeometryTypes::tetrahedron, order),
+                                        "Raviart-Thomas simplex element in 3d");
+  }
+
+  success &= testBatchedInterpolation(Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,1>(), "Raviart-Thomas cube element");
+  success &= testBatchedInterpolation(Dune::BDM1Simplex2DLocalFiniteElement<double,double>(0), "Brezzi-Douglas-Marini element");
+  success &= testBatchedInterpolation(Dune::Nedelec1stKindSimplexLocalFiniteElement<double,double,3,1>(), "Nedelec element");
+
+  return success ? 0 : 1;
+}
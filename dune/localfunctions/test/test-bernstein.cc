@@ -0,0 +1,142 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/localfunctions/bernstein.hh>
+
+#include <dune/localfunctions/test/test-localfe.hh>
+
+// Compare the sum-factorized algorithms to straight-forward implementations
+// based on the shape function evaluation of the local basis.
+template<int dim, int k>
+bool testAlgorithms()
+{
+  bool success = true;
+  const double eps = 1e-10;
+
+  using FE = Dune::BernsteinSimplexLocalFiniteElement<double,double,dim,k>;
+  using Range = typename FE::Traits::LocalBasisType::Traits::RangeType;
+  using Jacobian = typename FE::Traits::LocalBasisType::Traits::JacobianType;
+  FE fe;
+  Dune::BernsteinSimplexAlgorithms<double,double,dim> algorithms(k);
+
+  auto check = [&](double a, double b, const char* what) {
+    if (std::abs(a-b) > eps*std::max(1.0, std::abs(b)))
+    {
+      std::cerr << "Bernstein algorithm '" << what << "' failed for dim=" << dim << ", k=" << k
+                << ": " << a << " != " << b << std::endl;
+      success = false;
+    }
+  };
+
+  std::vector<double> c(fe.size());
+  for (std::size_t i=0; i<c.size(); ++i)
+    c[i] = std::sin(1.0+i);
+
+  // The collapsed quadrature integrates constants exactly
+  double volume = 0;
+  for (auto w : algorithms.quadratureWeights())
+    volume += w;
+  check(volume, 1.0/Dune::factorial(dim), "quadrature weights");
+
+  // de Casteljau and sum-factorized evaluation
+  auto points = algorithms.quadraturePoints();
+  std::vector<double> values;
+  algorithms.evaluate(c, values);
+  std::vector<Range> shapeValues;
+  for (std::size_t q=0; q<points.size(); ++q)
+  {
+    fe.localBasis().evaluateFunction(points[q], shapeValues);
+    double u = 0;
+    for (std::size_t i=0; i<c.size(); ++i)
+      u += c[i]*shapeValues[i];
+    check(values[q], u, "evaluate");
+    check(Dune::BernsteinSimplexAlgorithms<double,double,dim>::evaluate(c, points[q]), u, "de Casteljau");
+  }
+
+  // Mass and stiffness matrix application
+  Dune::FieldMatrix<double,dim,dim> G(0);
+  for (int i=0; i<dim; ++i)
+    for (int j=0; j<dim; ++j)
+      G[i][j] = (i==j) ? 2.0 : 0.5;
+
+  std::vector<double> mass(fe.size(), 0), stiffness(fe.size(), 0);
+  std::vector<Jacobian> shapeJacobians;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(fe.type(), 2*k))
+  {
+    fe.localBasis().evaluateFunction(qp.position(), shapeValues);
+    fe.localBasis().evaluateJacobian(qp.position(), shapeJacobians);
+    double u = 0;
+    Dune::FieldVector<double,dim> gradient(0), flux(0);
+    for (std::size_t j=0; j<c.size(); ++j)
+    {
+      u += c[j]*shapeValues[j];
+      gradient.axpy(c[j], shapeJacobians[j][0]);
+    }
+    G.mv(gradient, flux);
+    for (std::size_t i=0; i<c.size(); ++i)
+    {
+      mass[i] += qp.weight()*u*shapeValues[i];
+      stiffness[i] += qp.weight()*(flux*shapeJacobians[i][0]);
+    }
+  }
+
+  std::vector<double> result;
+  algorithms.applyMass(c, result);
+  for (std::size_t i=0; i<c.size(); ++i)
+    check(result[i], mass[i], "applyMass");
+
+  algorithms.applyStiffness(G, c, result);
+  for (std::size_t i=0; i<c.size(); ++i)
+    check(result[i], stiffness[i], "applyStiffness");
+
+  // Degree raising and lowering
+  std::vector<double> raised, lowered;
+  Dune::BernsteinSimplexAlgorithms<double,double,dim>::raiseDegree(c, raised);
+  Dune::BernsteinSimplexAlgorithms<double,double,dim>::lowerDegree(raised, lowered);
+  for (std::size_t i=0; i<c.size(); ++i)
+    check(lowered[i], c[i], "lowerDegree");
+  for (std::size_t q=0; q<points.size(); ++q)
+    check(Dune::BernsteinSimplexAlgorithms<double,double,dim>::evaluate(raised, points[q]), values[q], "raiseDegree");
+
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto k) {
+    Dune::BernsteinSimplexLocalFiniteElement<double,double,1,k> bernsteinSimplex1d;
+    TEST_FE3(bernsteinSimplex1d, DisableNone, 2);
+
+    Dune::BernsteinSimplexLocalFiniteElement<double,double,2,k> bernsteinSimplex2d;
+    TEST_FE3(bernsteinSimplex2d, DisableNone, 2);
+
+    Dune::BernsteinSimplexLocalFiniteElement<double,double,3,k> bernsteinSimplex3d;
+    TEST_FE3(bernsteinSimplex3d, DisableNone, 2);
+
+    success &= testAlgorithms<1,k>();
+    success &= testAlgorithms<2,k>();
+    success &= testAlgorithms<3,k>();
+  });
+
+  Dune::BernsteinSimplexLocalFiniteElement<double,double,2,3> bernsteinSimplexPermuted(std::array<unsigned int,3>{0,2,1});
+  TEST_FE(bernsteinSimplexPermuted);
+
+  success &= testAlgorithms<2,10>();
+  success &= testAlgorithms<3,8>();
+
+  return success ? 0 : 1;
+}
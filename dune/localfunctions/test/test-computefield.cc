@@ -0,0 +1,84 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/gmpfield.hh>
+#include <dune/common/quadmath.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex/raviartthomassimplexbasis.hh>
+#include <dune/localfunctions/utility/field.hh>
+
+/**
+ * \file
+ * \brief Checks the extended precision compute fields for the construction
+ *        of the generic Raviart-Thomas basis on simplices.
+ *
+ * The interpolation matrix of a basis constructed with Float128 or GMPField
+ * as compute field must be the identity up to almost double precision. The
+ * default compute field of the builtin types must be the type itself.
+ */
+
+static_assert(std::is_same< Dune::ComputeField< double, 512 >::Type, double >::value,
+              "The default compute field of double must be double");
+
+// Construct the basis and return the maximal deviation of the interpolation
+// matrix from the identity
+template< Dune::GeometryType::Id geometryId, class CF >
+double constructAndCheck (unsigned int order)
+{
+  constexpr Dune::GeometryType geometry = geometryId;
+  typedef Dune::RaviartThomasBasisFactory< geometry.dim(), double, CF > BasisFactory;
+  typedef Dune::RaviartThomasL2InterpolationFactory< geometry.dim(), double > InterpolationFactory;
+
+  const typename BasisFactory::Object &basis = *BasisFactory::template create< geometry >( order );
+  const typename InterpolationFactory::Object &interpolation = *InterpolationFactory::template create< geometry >( order );
+  Dune::DynamicMatrix< double > matrix;
+  interpolation.interpolate( basis, matrix );
+  double error = 0;
+  for( unsigned int i = 0; i < matrix.rows(); ++i )
+    for( unsigned int j = 0; j < matrix.cols(); ++j )
+      error = std::max( error, std::abs( matrix[ i ][ j ] - (i == j ? 1.0 : 0.0) ) );
+
+  InterpolationFactory::release( &interpolation );
+  BasisFactory::release( &basis );
+  return error;
+}
+
+template< Dune::GeometryType::Id geometryId, class CF >
+bool test (unsigned int order, const char* name)
+{
+  const double error = constructAndCheck< geometryId, CF >( order );
+  if( error > 1e-10 )
+  {
+    std::cout << "Interpolation error " << error << " of Raviart-Thomas basis of order " << order
+              << " on " << Dune::GeometryType( geometryId ) << " with compute field " << name
+              << " too large" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main ( int argc, char **argv )
+{
+  using namespace Dune;
+
+  bool success = true;
+#if HAVE_QUADMATH
+  success &= test< GeometryTypes::simplex(2), Float128 >( 6, "Float128" );
+  success &= test< GeometryTypes::simplex(3), Float128 >( 4, "Float128" );
+#endif
+#if HAVE_GMP
+  success &= test< GeometryTypes::simplex(2), GMPField< 256 > >( 6, "GMPField<256>" );
+  success &= test< GeometryTypes::simplex(3), GMPField< 256 > >( 4, "GMPField<256>" );
+#endif
+  return (success ? 0 : 1);
+}
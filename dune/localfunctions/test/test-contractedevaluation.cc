@@ -0,0 +1,246 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/localfunctions/crouzeixraviart.hh>
+#include <dune/localfunctions/lagrange.hh>
+#include <dune/localfunctions/lagrange/equidistantpoints.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex.hh>
+#include <dune/localfunctions/utility/contractedevaluation.hh>
+#include <dune/localfunctions/utility/derivativetable.hh>
+
+// Compare the contracted evaluation with the linear combination of the values and Jacobians of the shape functions
+template<class FE>
+bool testContractedEvaluation (const FE& fe)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Traits = typename LocalBasis::Traits;
+  const auto& basis = fe.localBasis();
+
+  std::vector<double> coefficients(basis.size());
+  for (std::size_t i = 0; i < coefficients.size(); ++i)
+    coefficients[i] = std::sin(1.0 + 3*i);
+
+  std::vector<typename Traits::DomainType> points;
+  for (const auto& qp : Dune::QuadratureRules<double,Traits::dimDomain>::rule(fe.type(), 4))
+    points.push_back(qp.position());
+
+  std::vector<typename Traits::RangeType> values, contractedValues;
+  std::vector<typename Traits::JacobianType> jacobians, contractedJacobians;
+  Dune::contractFunction(basis, coefficients, points, contractedValues);
+  Dune::contractJacobian(basis, coefficients, points, contractedJacobians);
+
+  bool success = (contractedValues.size() == points.size() and contractedJacobians.size() == points.size());
+  for (std::size_t q = 0; success and q < points.size(); ++q)
+  {
+    typename Traits::RangeType value(0), contractedValue;
+    typename Traits::JacobianType jacobian(0), contractedJacobian;
+    basis.evaluateFunction(points[q], values);
+    basis.evaluateJacobian(points[q], jacobians);
+    for (std::size_t i = 0; i < basis.size(); ++i)
+    {
+      value.axpy(coefficients[i], values[i]);
+      jacobian.axpy(coefficients[i], jacobians[i]);
+    }
+    Dune::contractFunction(basis, coefficients, points[q], contractedValue);
+    Dune::contractJacobian(basis, coefficients, points[q], contractedJacobian);
+
+    success &= (value - contractedValue).two_norm() < 1e-10;
+    success &= (value - contractedValues[q]).two_norm() < 1e-10;
+    success &= (jacobian - contractedJacobian).frobenius_norm() < 1e-10;
+    success &= (jacobian - contractedJacobians[q]).frobenius_norm() < 1e-10;
+  }
+  if (not success)
+    std::cout << "Contracted evaluation does not match the shape functions of " << Dune::className(basis) << std::endl;
+  return success;
+}
+
+// Compare the integrals of the shape functions against values and fluxes with a loop over the shape functions
+template<class FE>
+bool testIntegrateShapeFunctions (const FE& fe)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Traits = typename LocalBasis::Traits;
+  constexpr int dim = Traits::dimDomain;
+  constexpr int dimRange = Traits::dimRange;
+  const auto& basis = fe.localBasis();
+
+  std::vector<typename Traits::DomainType> points;
+  std::vector<double> weights;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(fe.type(), 4))
+  {
+    points.push_back(qp.position());
+    weights.push_back(qp.weight());
+  }
+
+  std::vector<typename Traits::RangeType> values(points.size());
+  std::vector<typename Traits::JacobianType> fluxes(points.size());
+  for (std::size_t q = 0; q < points.size(); ++q)
+    for (int r = 0; r < dimRange; ++r)
+    {
+      values[q][r] = std::cos(1.0 + q + 2*r);
+      for (int j = 0; j < dim; ++j)
+        fluxes[q][r][j] = std::sin(2.0 + q + 3*r + j);
+    }
+
+  // The expected integrals of the values only and of the values and fluxes
+  std::vector<double> expectedValues(basis.size(), 0), expected(basis.size(), 0);
+  std::vector<typename Traits::RangeType> shapeValues;
+  std::vector<typename Traits::JacobianType> jacobians;
+  for (std::size_t q = 0; q < points.size(); ++q)
+  {
+    basis.evaluateFunction(points[q], shapeValues);
+    basis.evaluateJacobian(points[q], jacobians);
+    for (std::size_t i = 0; i < basis.size(); ++i)
+    {
+      double value = values[q] * shapeValues[i];
+      double flux = 0;
+      for (int r = 0; r < dimRange; ++r)
+        for (int j = 0; j < dim; ++j)
+          flux += fluxes[q][r][j] * jacobians[i][r][j];
+      expectedValues[i] += weights[q] * value;
+      expected[i] += weights[q] * (value + flux);
+    }
+  }
+
+  auto compare = [](const std::vector<double>& a, const std::vector<double>& b) {
+    bool equal = (a.size() == b.size());
+    for (std::size_t i = 0; equal and i < a.size(); ++i)
+      equal = std::abs(a[i] - b[i]) < 1e-10;
+    return equal;
+  };
+
+  std::vector<double> integrals;
+  Dune::integrateShapeFunctions(basis, points, weights, values, fluxes, integrals);
+  bool success = compare(integrals, expected);
+  Dune::integrateShapeFunctions(basis, points, weights, values, {}, integrals);
+  success &= compare(integrals, expectedValues);
+
+  using Table = Dune::DerivativeTable<double>;
+  for (auto layout : {Table::Layout::functionsContiguous, Table::Layout::pointsContiguous})
+  {
+    Table valueTable, jacobianTable;
+    Dune::evaluateFunctionTable(basis, points, valueTable, layout);
+    Dune::evaluateJacobianTable(basis, points, jacobianTable, layout);
+    Dune::integrateShapeFunctions(valueTable, jacobianTable, weights, values, fluxes, integrals);
+    success &= compare(integrals, expected);
+  }
+
+  if (not success)
+    std::cout << "Integration against the shape functions fails for " << Dune::className(basis) << std::endl;
+  return success;
+}
+
+// Compare the integration on a tensor-product rule with the integration point by point
+template<class FE>
+bool testTensorProductIntegration (const FE& fe)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Traits = typename LocalBasis::Traits;
+  constexpr int dim = Traits::dimDomain;
+  const auto& basis = fe.localBasis();
+
+  // One-dimensional Gauss rules with a different number of points in each direction
+  std::array<std::vector<double>,dim> points1d, weights1d;
+  std::size_t numPoints = 1;
+  for (int l = 0; l < dim; ++l)
+  {
+    for (const auto& qp : Dune::QuadratureRules<double,1>::rule(Dune::GeometryTypes::line, 3 + 2*l))
+    {
+      points1d[l].push_back(qp.position()[0]);
+      weights1d[l].push_back(qp.weight());
+    }
+    numPoints *= points1d[l].size();
+  }
+
+  // The tensor-product points, direction 0 running fastest
+  std::vector<typename Traits::DomainType> points(numPoints);
+  std::vector<double> weights(numPoints, 1);
+  std::vector<typename Traits::RangeType> values(numPoints);
+  std::vector<typename Traits::JacobianType> fluxes(numPoints);
+  for (std::size_t q = 0; q < numPoints; ++q)
+  {
+    std::size_t m = q;
+    for (int l = 0; l < dim; ++l)
+    {
+      points[q][l] = points1d[l][m % points1d[l].size()];
+      weights[q] *= weights1d[l][m % points1d[l].size()];
+      m /= points1d[l].size();
+    }
+    values[q] = std::cos(1.0 + q);
+    for (int j = 0; j < dim; ++j)
+      fluxes[q][0][j] = std::sin(2.0 + q + j);
+  }
+
+  auto compare = [](const std::vector<double>& a, const std::vector<double>& b) {
+    bool equal = (a.size() == b.size());
+    for (std::size_t i = 0; equal and i < a.size(); ++i)
+      equal = std::abs(a[i] - b[i]) < 1e-10;
+    return equal;
+  };
+
+  std::vector<double> expected, integrals;
+  Dune::integrateShapeFunctions(basis, points, weights, values, fluxes, expected);
+  Dune::integrateShapeFunctions(basis, points1d, weights1d, values, fluxes, integrals);
+  bool success = compare(integrals, expected);
+  Dune::integrateShapeFunctions(basis, points, weights, values, {}, expected);
+  Dune::integrateShapeFunctions(basis, points1d, weights1d, values, {}, integrals);
+  success &= compare(integrals, expected);
+  Dune::integrateShapeFunctions(basis, points, weights, {}, fluxes, expected);
+  Dune::integrateShapeFunctions(basis, points1d, weights1d, {}, fluxes, integrals);
+  success &= compare(integrals, expected);
+
+  if (not success)
+    std::cout << "Integration on a tensor-product rule fails for " << Dune::className(basis) << std::endl;
+  return success;
+}
+
+int main (int argc, char** argv)
+{
+  bool success = true;
+
+  auto test = [&](const auto& fe) {
+    success &= testContractedEvaluation(fe);
+    success &= testIntegrateShapeFunctions(fe);
+  };
+
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto k) {
+    test(Dune::LagrangeSimplexLocalFiniteElement<double,double,1,k>());
+    test(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>());
+    test(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>());
+    test(Dune::LagrangeCubeLocalFiniteElement<double,double,1,k>());
+    test(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>());
+    test(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>());
+    success &= testTensorProductIntegration(Dune::LagrangeCubeLocalFiniteElement<double,double,1,k>());
+    success &= testTensorProductIntegration(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>());
+    success &= testTensorProductIntegration(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>());
+  });
+
+  // Elements based on PolynomialBasis
+  for (unsigned int order : {1, 2, 3})
+  {
+    using LagrangeFE = Dune::LagrangeLocalFiniteElement<Dune::EquidistantPointSet,2,double,double>;
+    test(LagrangeFE(Dune::GeometryTypes::triangle, order));
+    test(LagrangeFE(Dune::GeometryTypes::quadrilateral, order));
+    success &= testTensorProductIntegration(LagrangeFE(Dune::GeometryTypes::quadrilateral, order));
+  }
+  test(Dune::RaviartThomasSimplexLocalFiniteElement<2,double,double>(Dune::GeometryTypes::triangle, 1));
+
+  // Elements without an own contraction
+  test(Dune::CrouzeixRaviartLocalFiniteElement<double,double,2>());
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex.hh>
+#include <dune/localfunctions/utility/derivativetable.hh>
+
+// Check that the arrays of all components start at aligned addresses
+template<class R>
+bool checkAlignment (const Dune::DerivativeTable<R>& table)
+{
+  bool success = (table.leadingDimension() * sizeof(R)) % Dune::DerivativeTable<R>::alignment == 0;
+  for (std::size_t c = 0; c < table.components(); ++c)
+    success &= reinterpret_cast<std::uintptr_t>(table.data(c)) % Dune::DerivativeTable<R>::alignment == 0;
+  if (not success)
+    std::cout << "Arrays of the derivative table are not aligned" << std::endl;
+  return success;
+}
+
+// Central difference quotients of all shape functions in direction j
+template<class LocalBasis>
+auto differenceQuotients (const LocalBasis& basis, const typename LocalBasis::Traits::DomainType& x, int j)
+{
+  const double delta = 1e-5;
+  std::vector<typename LocalBasis::Traits::RangeType> upper, lower;
+  auto y = x;
+  y[j] += delta;
+  basis.evaluateFunction(y, upper);
+  y[j] = x[j] - delta;
+  basis.evaluateFunction(y, lower);
+  for (std::size_t i = 0; i < upper.size(); ++i)
+  {
+    upper[i] -= lower[i];
+    upper[i] /= 2*delta;
+  }
+  return upper;
+}
+
+// Compare the value tables with the values of the local basis and the tables of the
+// Jacobians and partial derivatives with difference quotients of these values
+template<class FE>
+bool testDerivativeTable (const FE& fe)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Table = Dune::DerivativeTable<double>;
+  constexpr int dim = LocalBasis::Traits::dimDomain;
+  constexpr int dimRange = LocalBasis::Traits::dimRange;
+  const auto& basis = fe.localBasis();
+
+  std::vector<typename LocalBasis::Traits::DomainType> points;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(fe.type(), 3))
+    points.push_back(qp.position());
+
+  bool success = true;
+  // tolerance for the comparison with difference quotients
+  const double eps = 1e-6;
+  std::vector<typename LocalBasis::Traits::RangeType> values;
+  for (auto layout : {Table::Layout::functionsContiguous, Table::Layout::pointsContiguous})
+  {
+    Table valueTable, jacobianTable, partialTable;
+    Dune::evaluateFunctionTable(basis, points, valueTable, layout);
+    Dune::evaluateJacobianTable(basis, points, jacobianTable, layout);
+    success &= checkAlignment(valueTable) and checkAlignment(jacobianTable);
+    success &= (valueTable.components() == dimRange and jacobianTable.components() == dimRange*dim);
+
+    for (std::size_t p = 0; p < points.size(); ++p)
+    {
+      basis.evaluateFunction(points[p], values);
+      for (std::size_t i = 0; i < basis.size(); ++i)
+        for (int r = 0; r < dimRange; ++r)
+          success &= std::abs(valueTable(r, i, p) - values[i][r]) < 1e-12;
+
+      for (int j = 0; j < dim; ++j)
+      {
+        const auto quotients = differenceQuotients(basis, points[p], j);
+        for (std::size_t i = 0; i < basis.size(); ++i)
+          for (int r = 0; r < dimRange; ++r)
+            success &= std::abs(jacobianTable(r*dim+j, i, p) - quotients[i][r]) < eps;
+      }
+    }
+
+    std::array<unsigned int,dim> order;
+    order.fill(0);
+    order[0] = 1;
+    Dune::partialTable(basis, order, points, partialTable, layout);
+    success &= checkAlignment(partialTable);
+    for (std::size_t p = 0; p < points.size(); ++p)
+    {
+      const auto quotients = differenceQuotients(basis, points[p], 0);
+      for (std::size_t i = 0; i < basis.size(); ++i)
+        for (int r = 0; r < dimRange; ++r)
+          success &= std::abs(partialTable(r, i, p) - quotients[i][r]) < eps;
+    }
+  }
+  if (not success)
+    std::cout << "Derivative table does not match the local basis " << Dune::className(basis) << std::endl;
+  return success;
+}
+
+int main (int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<4>{}, [&](auto k) {
+    success &= testDerivativeTable(Dune::LagrangeSimplexLocalFiniteElement<double,double,1,k>());
+    success &= testDerivativeTable(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>());
+    success &= testDerivativeTable(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>());
+    success &= testDerivativeTable(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>());
+    success &= testDerivativeTable(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>());
+  });
+
+  // Bases without a native structure-of-arrays evaluation
+  success &= testDerivativeTable(Dune::RaviartThomasSimplexLocalFiniteElement<2,double,double>(Dune::GeometryTypes::triangle, 1));
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/localfunctions/orthonormal/dubinersimplex.hh>
+
+#include <dune/localfunctions/test/test-localfe.hh>
+
+// Check the orthonormality of the Dubiner basis with an exact quadrature rule
+template<int dim, int k>
+bool testOrthonormality()
+{
+  bool success = true;
+
+  using FE = Dune::DubinerSimplexLocalFiniteElement<double,double,dim,k>;
+  using Range = typename FE::Traits::LocalBasisType::Traits::RangeType;
+  FE fe;
+
+  std::vector<double> mass(fe.size()*fe.size(), 0);
+  std::vector<Range> values;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(fe.type(), 2*k))
+  {
+    fe.localBasis().evaluateFunction(qp.position(), values);
+    for (std::size_t i=0; i<fe.size(); ++i)
+      for (std::size_t j=0; j<fe.size(); ++j)
+        mass[i*fe.size()+j] += qp.weight()*values[i]*values[j];
+  }
+
+  for (std::size_t i=0; i<fe.size(); ++i)
+    for (std::size_t j=0; j<fe.size(); ++j)
+      if (std::abs(mass[i*fe.size()+j] - double(i == j)) > 1e-10)
+      {
+        std::cerr << "Dubiner basis of dim=" << dim << ", k=" << k << " is not orthonormal: "
+                  << "(" << i << "," << j << ") entry of the mass matrix is " << mass[i*fe.size()+j] << std::endl;
+        success = false;
+      }
+
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto k) {
+    Dune::DubinerSimplexLocalFiniteElement<double,double,1,k> dubinerSimplex1d;
+    TEST_FE3(dubinerSimplex1d, DisableNone, 1);
+
+    Dune::DubinerSimplexLocalFiniteElement<double,double,2,k> dubinerSimplex2d;
+    TEST_FE3(dubinerSimplex2d, DisableNone, 1);
+
+    Dune::DubinerSimplexLocalFiniteElement<double,double,3,k> dubinerSimplex3d;
+    TEST_FE3(dubinerSimplex3d, DisableNone, 1);
+
+    success &= testOrthonormality<1,k>();
+    success &= testOrthonormality<2,k>();
+    success &= testOrthonormality<3,k>();
+  });
+
+  Dune::DubinerSimplexLocalFiniteElement<double,double,3,10> dubinerSimplex3dOrder10;
+  TEST_FE3(dubinerSimplex3dOrder10, DisableNone, 1);
+
+  success &= testOrthonormality<2,10>();
+  success &= testOrthonormality<3,10>();
+
+  return success ? 0 : 1;
+}
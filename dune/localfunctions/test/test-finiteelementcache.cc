@@ -3,12 +3,20 @@
 // SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
 // SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
 
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/hybridutilities.hh>
 
 #include <dune/geometry/type.hh>
 
+#include <dune/localfunctions/bernstein/bernsteinlfecache.hh>
 #include <dune/localfunctions/lagrange/pqkfactory.hh>
 #include <dune/localfunctions/dualmortarbasis/dualpq1factory.hh>
 #include <dune/localfunctions/raviartthomas/raviartthomaslfecache.hh>
@@ -28,7 +36,98 @@ static void test(Dune::GeometryType type)
   [[maybe_unused]] const FiniteElement& finiteElement = cache.get(type);
 }
 
+// Check that the elements of a cache of several orders have the requested order
+template<class FiniteElementCache>
+static bool testOrders(Dune::GeometryType type, std::size_t maxOrder)
+{
+  FiniteElementCache cache;
+  FiniteElementCache copy = cache;
+
+  bool success = true;
+  for (std::size_t order = 1; order <= maxOrder; ++order)
+  {
+    const auto& finiteElement = copy.get(type, order);
+    if (finiteElement.type() != type or finiteElement.localBasis().order() != order)
+    {
+      std::cout << "Element of order " << order << " on " << type << " has wrong type or order" << std::endl;
+      success = false;
+    }
+  }
+
+  for (std::size_t order : {std::size_t(0), maxOrder+1})
+  {
+    try {
+      cache.get(type, order);
+      std::cout << "No exception for element of order " << order << " on " << type << std::endl;
+      success = false;
+    }
+    catch (const Dune::RangeError&) {}
+  }
+  return success;
+}
+
+// Check that a lazy cache creates each element once and copies the created elements
+template<class FiniteElementCache>
+static bool testLazy(Dune::GeometryType type, Dune::GeometryType missingType)
+{
+  bool success = true;
+  FiniteElementCache cache;
+  cache.prefetch(type);
+  const auto* finiteElement = &cache.get(type);
+  if (finiteElement != &cache.get(type) or finiteElement->type() != type)
+  {
+    std::cout << "Lazy cache does not return the same element for " << type << std::endl;
+    success = false;
+  }
+
+  FiniteElementCache copy = cache;
+  if (copy.get(type).type() != type or copy.get(type).size() != finiteElement->size())
+  {
+    std::cout << "Copy of lazy cache does not contain the element for " << type << std::endl;
+    success = false;
+  }
+
+  try {
+    cache.get(missingType);
+    std::cout << "No exception for missing element on " << missingType << std::endl;
+    success = false;
+  }
+  catch (const Dune::RangeError&) {}
+  return success;
+}
+
+// Check that threads requesting elements concurrently from a lazy cache all receive the same elements
+template<class FiniteElementCache, class... Key>
+static bool testLazyConcurrent(const Key&... key)
+{
+  constexpr std::size_t numThreads = 8;
+  FiniteElementCache cache;
+  std::vector<const typename FiniteElementCache::FiniteElementType*> finiteElements(numThreads, nullptr);
+
+  // Start all threads at once to let them race for the creation of the element
+  std::atomic<bool> start = false;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < numThreads; ++t)
+    threads.emplace_back([&, t] {
+      while (not start)
+        std::this_thread::yield();
+      finiteElements[t] = &cache.get(key...);
+    });
+  start = true;
+  for (auto& thread : threads)
+    thread.join();
+
+  for (const auto* finiteElement : finiteElements)
+    if (finiteElement != &cache.get(key...))
+    {
+      std::cout << "Concurrent requests to lazy cache return different elements" << std::endl;
+      return false;
+    }
+  return true;
+}
+
 int main() {
+  bool success = true;
   static constexpr std::size_t max_k = 3;
   Dune::Hybrid::forEach(std::make_index_sequence<max_k+1>{},[&](auto k)
           {
@@ -37,6 +136,21 @@ int main() {
                 Dune::LagrangeLocalFiniteElementCache<double, double, dim, k>;
             test<FiniteElementCache>(Dune::GeometryTypes::simplex(dim));
             test<FiniteElementCache>(Dune::GeometryTypes::cube(dim));
+
+            // The elements share their local keys, hence copying them into the cache does not allocate
+            static_assert(std::is_trivially_copyable_v<Dune::LagrangeSimplexLocalFiniteElement<double,double,dim,k> >);
+            static_assert(std::is_trivially_copyable_v<Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k> >);
+            static_assert(std::is_trivially_copyable_v<Dune::LagrangeCubeLocalFiniteElement<double,double,dim,k> >);
+            static_assert(std::is_trivially_copyable_v<Dune::LagrangeCubeLocalFiniteElement<double,double,3,k> >);
+          });
+  static_assert(std::is_trivially_copyable_v<Dune::LagrangePrismLocalFiniteElement<double,double,2> >);
+  static_assert(std::is_trivially_copyable_v<Dune::LagrangePyramidLocalFiniteElement<double,double,2> >);
+  Dune::Hybrid::forEach(std::make_index_sequence<max_k+1>{},[&](auto k)
+          {
+            constexpr int dim = 3;
+            using FiniteElementCache = typename
+                Dune::BernsteinLocalFiniteElementCache<double, double, dim, k>;
+            test<FiniteElementCache>(Dune::GeometryTypes::simplex(dim));
           });
   {
     constexpr int dim = 2;
@@ -73,5 +187,42 @@ int main() {
     test<FiniteElementCache>(Dune::GeometryTypes::cube(dim));
   }
 
-  return 0;
+  {
+    using FiniteElementCache = Dune::HPLagrangeLocalFiniteElementCache<double, double, 2, max_k>;
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::triangle, max_k);
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::quadrilateral, max_k);
+  }
+
+  {
+    using FiniteElementCache = Dune::HPLagrangeLocalFiniteElementCache<double, double, 3, 2>;
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::tetrahedron, 2);
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::hexahedron, 2);
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::prism, 2);
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::pyramid, 2);
+  }
+
+  Dune::Hybrid::forEach(std::make_index_sequence<max_k+1>{},[&](auto k)
+          {
+            constexpr int dim = 3;
+            using FiniteElementCache = typename
+                Dune::LagrangeLocalFiniteElementCache<double, double, dim, k, true>;
+            test<FiniteElementCache>(Dune::GeometryTypes::hexahedron);
+            success &= testLazy<FiniteElementCache>(Dune::GeometryTypes::tetrahedron, Dune::GeometryTypes::none(dim));
+            success &= testLazyConcurrent<FiniteElementCache>(Dune::GeometryTypes::hexahedron);
+          });
+
+  {
+    using FiniteElementCache = Dune::RaviartThomasLocalFiniteElementCache<double, double, 2, 1, true>;
+    test<FiniteElementCache>(Dune::GeometryTypes::cube(2));
+    success &= testLazy<FiniteElementCache>(Dune::GeometryTypes::simplex(2), Dune::GeometryTypes::none(2));
+  }
+
+  {
+    using FiniteElementCache = Dune::HPLagrangeLocalFiniteElementCache<double, double, 2, max_k, true>;
+    success &= testOrders<FiniteElementCache>(Dune::GeometryTypes::triangle, max_k);
+    for (std::size_t order = 1; order <= max_k; ++order)
+      success &= testLazyConcurrent<FiniteElementCache>(Dune::GeometryTypes::quadrilateral, order);
+  }
+
+  return success ? 0 : 1;
 }
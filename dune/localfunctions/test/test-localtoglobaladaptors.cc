@@ -0,0 +1,95 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localtoglobaladaptors.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+
+#include "test-fe.hh"
+
+// tolerance for floating-point comparisons
+static const double eps = 1e-9;
+// stepsize for numerical differentiation
+static const double delta = 1e-5;
+
+// Compare the values and Jacobians of the cached and the uncached adaptor at
+// the points of a quadrature rule, evaluated one after the other
+template<class LocalFiniteElement, class Geometry>
+bool testCachedAdaptor(const LocalFiniteElement& lfe, const Geometry& geo)
+{
+  typedef Dune::ScalarLocalToGlobalFiniteElementAdaptor<LocalFiniteElement, Geometry> FE;
+  typedef Dune::ScalarLocalToGlobalFiniteElementAdaptor<LocalFiniteElement, Geometry,
+      Dune::CachedScalarLocalToGlobalBasisAdaptor> CachedFE;
+  const FE fe(lfe, geo);
+  const CachedFE cachedFE(lfe, geo);
+
+  bool success = true;
+  std::vector<typename FE::Traits::Basis::Traits::Range> values, cachedValues;
+  std::vector<typename FE::Traits::Basis::Traits::Jacobian> jacobians, cachedJacobians;
+  for(const auto& qp : Dune::QuadratureRules<double, Geometry::mydimension>::rule(geo.type(), 4))
+  {
+    fe.basis().evaluateFunction(qp.position(), values);
+    fe.basis().evaluateJacobian(qp.position(), jacobians);
+    cachedFE.basis().evaluateFunction(qp.position(), cachedValues);
+    cachedFE.basis().evaluateJacobian(qp.position(), cachedJacobians);
+
+    if(values.size() != cachedValues.size() || jacobians.size() != cachedJacobians.size())
+    {
+      std::cout << "Cached adaptor on " << geo.type() << " returns the wrong number of shape functions" << std::endl;
+      return false;
+    }
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+      // Written such that NaN values fail as well
+      if(!((values[i] - cachedValues[i]).two_norm() <= eps) ||
+         !((jacobians[i] - cachedJacobians[i]).frobenius_norm() <= eps))
+      {
+        std::cout << "Cached adaptor on " << geo.type() << " differs from the uncached one for shape function "
+                  << i << " at " << qp.position() << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  std::cout << "== Checking cached adaptor on " << geo.type() << std::endl;
+  if(geo.affine())
+    success &= testFE(geo, cachedFE, eps, delta);
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  typedef Dune::AffineGeometry<double, 2, 2> AffineGeometry;
+  typedef Dune::MultiLinearGeometry<double, 2, 2> BilinearGeometry;
+
+  const AffineGeometry triangle(Dune::GeometryTypes::triangle,
+                                {{0.1, 0.2}, {1.3, 0.4}, {0.5, 1.1}});
+  const BilinearGeometry parallelogram(Dune::GeometryTypes::quadrilateral,
+                                       {{0.1, 0.2}, {1.3, 0.4}, {0.5, 1.1}, {1.7, 1.3}});
+  const BilinearGeometry bilinear(Dune::GeometryTypes::quadrilateral,
+                                  {{0.1, 0.2}, {1.3, 0.4}, {0.5, 1.1}, {2.1, 1.9}});
+  if(!parallelogram.affine() || bilinear.affine())
+  {
+    std::cout << "The test geometries are not affine and non-affine as expected" << std::endl;
+    success = false;
+  }
+
+  success &= testCachedAdaptor(Dune::LagrangeSimplexLocalFiniteElement<double, double, 2, 2>(), triangle);
+  success &= testCachedAdaptor(Dune::LagrangeCubeLocalFiniteElement<double, double, 2, 2>(), parallelogram);
+  success &= testCachedAdaptor(Dune::LagrangeCubeLocalFiniteElement<double, double, 2, 2>(), bilinear);
+
+  return success ? 0 : 1;
+}
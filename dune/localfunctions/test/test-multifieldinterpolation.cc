@@ -0,0 +1,89 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/lagrange.hh>
+#include <dune/localfunctions/lagrange/equidistantpoints.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/monomial.hh>
+#include <dune/localfunctions/orthonormal.hh>
+#include <dune/localfunctions/utility/localfiniteelement.hh>
+
+// Check that interpolating several functions at once yields the coefficients of the separate interpolations
+template<class FE>
+bool testInterpolateFields (const FE& fe)
+{
+  using DomainType = typename FE::Traits::LocalBasisType::Traits::DomainType;
+  constexpr std::size_t fields = 3;
+
+  auto field = [](std::size_t j) {
+    return [j](const DomainType& x) {
+      double y = 1.0 + j;
+      for (std::size_t i = 0; i < x.size(); ++i)
+        y *= std::cos(0.5 + j + (i+1)*x[i]);
+      return y;
+    };
+  };
+  auto fieldsFunction = [&](const DomainType& x) {
+    std::array<double,fields> values;
+    for (std::size_t j = 0; j < fields; ++j)
+      values[j] = field(j)(x);
+    return values;
+  };
+
+  Dune::DynamicMatrix<double> coefficients;
+  fe.localInterpolation().interpolateFields(fieldsFunction, coefficients);
+
+  bool success = (coefficients.N() == fe.size() and coefficients.M() == fields);
+  std::vector<double> expected;
+  for (std::size_t j = 0; success and j < fields; ++j)
+  {
+    fe.localInterpolation().interpolate(field(j), expected);
+    for (std::size_t i = 0; success and i < fe.size(); ++i)
+      success = std::abs(coefficients[i][j] - expected[i]) < 1e-10;
+  }
+  if (not success)
+    std::cout << "Interpolation of several functions at once fails for " << Dune::className(fe) << " on " << fe.type() << std::endl;
+  return success;
+}
+
+int main (int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<4>{}, [&](auto k) {
+    success &= testInterpolateFields(Dune::LagrangeSimplexLocalFiniteElement<double,double,1,k>());
+    success &= testInterpolateFields(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>());
+    success &= testInterpolateFields(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>());
+    success &= testInterpolateFields(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>());
+    success &= testInterpolateFields(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>());
+  });
+
+  for (unsigned int order : {1, 2, 3})
+  {
+    using LagrangeFE = Dune::LagrangeLocalFiniteElement<Dune::EquidistantPointSet,2,double,double>;
+    success &= testInterpolateFields(LagrangeFE(Dune::GeometryTypes::triangle, order));
+    success &= testInterpolateFields(LagrangeFE(Dune::GeometryTypes::quadrilateral, order));
+
+    success &= testInterpolateFields(Dune::OrthonormalLocalFiniteElement<2,double,double>(Dune::GeometryTypes::triangle, order));
+    success &= testInterpolateFields(Dune::L2LocalFiniteElement<LagrangeFE>(Dune::GeometryTypes::triangle, order));
+  }
+
+  success &= testInterpolateFields(Dune::MonomialLocalFiniteElement<double,double,2,2>(Dune::GeometryTypes::triangle));
+  success &= testInterpolateFields(Dune::MonomialLocalFiniteElement<double,double,3,1>(Dune::GeometryTypes::hexahedron));
+
+  return success ? 0 : 1;
+}
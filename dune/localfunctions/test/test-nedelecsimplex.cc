@@ -29,6 +29,9 @@
 #if HAVE_GMP
 typedef Dune::GMPField< 128 > StorageField;
 typedef Dune::GMPField< 512 > ComputeField;
+#elif HAVE_QUADMATH
+typedef double StorageField;
+typedef Dune::Float128 ComputeField;
 #else
 typedef double StorageField;
 typedef double ComputeField;
@@ -0,0 +1,146 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/math.hh>
+
+#include <dune/localfunctions/common/partial.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/monomial.hh>
+
+// Compare all partial derivatives of total order at most k+1 with central
+// differences of the partial derivatives of one order less
+template<class FE>
+bool testHigherOrderPartial(const FE& fe, unsigned int maxOrder)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Range = typename LocalBasis::Traits::RangeType;
+  constexpr int dim = LocalBasis::Traits::dimDomain;
+  const double h = 1e-5;
+
+  typename LocalBasis::Traits::DomainType x;
+  for (int j = 0; j < dim; ++j)
+    x[j] = 0.13 + 0.1*j;
+
+  bool success = true;
+  std::vector<Range> y, yPlus, yMinus;
+  std::array<unsigned int,dim> order;
+  for (unsigned int l = 0; success and l < Dune::power(maxOrder+1, unsigned(dim)); ++l)
+  {
+    unsigned int totalOrder = 0;
+    for (unsigned int j = 0, rest = l; j < unsigned(dim); ++j, rest /= maxOrder+1)
+    {
+      order[j] = rest % (maxOrder+1);
+      totalOrder += order[j];
+    }
+    if (totalOrder == 0 or totalOrder > maxOrder)
+      continue;
+
+    unsigned int direction = 0;
+    while (order[direction] == 0)
+      ++direction;
+    auto lowerOrder = order;
+    --lowerOrder[direction];
+    auto xPlus = x, xMinus = x;
+    xPlus[direction] += h;
+    xMinus[direction] -= h;
+
+    fe.localBasis().partial(order, x, y);
+    fe.localBasis().partial(lowerOrder, xPlus, yPlus);
+    fe.localBasis().partial(lowerOrder, xMinus, yMinus);
+    for (std::size_t i = 0; i < y.size(); ++i)
+    {
+      const double finiteDiff = (yPlus[i][0] - yMinus[i][0]) / (2*h);
+      success &= std::abs(y[i][0] - finiteDiff) <= 1e-4 * (1 + std::abs(y[i][0]));
+    }
+  }
+  if (not success)
+    std::cout << "Partial derivatives of higher order are wrong for " << Dune::className(fe) << std::endl;
+  return success;
+}
+
+// Compare the partial derivatives with a static multi-index with those with a dynamic one
+template<unsigned int... orders, class FE>
+bool testStaticPartial(const FE& fe)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Range = typename LocalBasis::Traits::RangeType;
+  constexpr int dim = LocalBasis::Traits::dimDomain;
+
+  typename LocalBasis::Traits::DomainType x;
+  for (int j = 0; j < dim; ++j)
+    x[j] = 0.21 + 0.07*j;
+
+  std::vector<Range> y, yStatic;
+  fe.localBasis().partial(std::array<unsigned int,dim>{orders...}, x, y);
+  Dune::partial<orders...>(fe.localBasis(), x, yStatic);
+
+  bool success = (y.size() == yStatic.size());
+  for (std::size_t i = 0; success and i < y.size(); ++i)
+    success &= std::abs(y[i][0] - yStatic[i][0]) <= 1e-10 * (1 + std::abs(y[i][0]));
+  if (not success)
+    std::cout << "Static partial derivatives differ from the dynamic ones for " << Dune::className(fe) << std::endl;
+  return success;
+}
+
+template<class FE>
+bool testStaticPartial2d(const FE& fe)
+{
+  bool success = true;
+  success &= testStaticPartial<0,0>(fe);
+  success &= testStaticPartial<1,0>(fe);
+  success &= testStaticPartial<0,1>(fe);
+  success &= testStaticPartial<1,1>(fe);
+  success &= testStaticPartial<2,1>(fe);
+  success &= testStaticPartial<0,3>(fe);
+  success &= testStaticPartial<2,2>(fe);
+  success &= testStaticPartial<4,1>(fe);
+  return success;
+}
+
+template<class FE>
+bool testStaticPartial3d(const FE& fe)
+{
+  bool success = true;
+  success &= testStaticPartial<0,0,0>(fe);
+  success &= testStaticPartial<0,0,1>(fe);
+  success &= testStaticPartial<1,1,1>(fe);
+  success &= testStaticPartial<2,0,1>(fe);
+  success &= testStaticPartial<0,3,0>(fe);
+  success &= testStaticPartial<1,2,1>(fe);
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto k) {
+    success &= testHigherOrderPartial(Dune::LagrangeSimplexLocalFiniteElement<double,double,1,k>(), k+1);
+    success &= testHigherOrderPartial(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>(), k+1);
+    success &= testHigherOrderPartial(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>(), k+1);
+    success &= testHigherOrderPartial(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>(), k+2);
+    success &= testHigherOrderPartial(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>(), k+2);
+
+    success &= testStaticPartial2d(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>());
+    success &= testStaticPartial3d(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>());
+    success &= testStaticPartial2d(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>());
+    success &= testStaticPartial3d(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>());
+  });
+
+  // A local basis without partial derivatives with a static multi-index
+  success &= testStaticPartial2d(Dune::MonomialLocalFiniteElement<double,double,2,3>(Dune::GeometryTypes::triangle));
+
+  return success ? 0 : 1;
+}
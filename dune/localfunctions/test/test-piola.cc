@@ -0,0 +1,91 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cstddef>
+#include <iostream>
+#include <ostream>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localtoglobaladaptors.hh>
+#include <dune/localfunctions/nedelec.hh>
+#include <dune/localfunctions/raviartthomas.hh>
+
+#include "geometries.hh"
+#include "test-fe.hh"
+
+// tolerance for floating-point comparisons
+static const double eps = 1e-9;
+// stepsize for numerical differentiation
+static const double delta = 1e-5;
+
+// The Jacobians of the Piola-transformed shape functions are only exact for
+// affine geometries
+template<class LocalFiniteElement, class Geometry>
+bool testContravariant(const LocalFiniteElement& lfe, const Geometry& geo)
+{
+  Dune::ContravariantPiolaLocalToGlobalFiniteElementAdaptor<LocalFiniteElement, Geometry> fe(lfe, geo);
+  std::cout << "== Checking contravariant Piola transformation on " << geo.type() << std::endl;
+  if(geo.affine())
+    return testFE(geo, fe, eps, delta);
+  return testInterpolation(fe, eps);
+}
+
+template<class LocalFiniteElement, class Geometry>
+bool testCovariant(const LocalFiniteElement& lfe, const Geometry& geo)
+{
+  Dune::CovariantPiolaLocalToGlobalFiniteElementAdaptor<LocalFiniteElement, Geometry> fe(lfe, geo);
+  std::cout << "== Checking covariant Piola transformation on " << geo.type() << std::endl;
+  if(geo.affine())
+    return testFE(geo, fe, eps, delta);
+  return testInterpolation(fe, eps);
+}
+
+int main(int argc, char** argv) {
+  try {
+    bool success = true;
+
+    const TestGeometries<double, 2> testGeos2d;
+    const auto& triangle = testGeos2d.get(Dune::GeometryTypes::triangle);
+    const auto& quadrilateral = testGeos2d.get(Dune::GeometryTypes::quadrilateral);
+
+    const TestGeometries<double, 3> testGeos3d;
+    const auto& tetrahedron = testGeos3d.get(Dune::GeometryTypes::tetrahedron);
+    const auto& hexahedron = testGeos3d.get(Dune::GeometryTypes::hexahedron);
+
+    Dune::RaviartThomasSimplexLocalFiniteElement<2,double,double> rtTriangle(Dune::GeometryTypes::triangle, 2);
+    success = testContravariant(rtTriangle, triangle) and success;
+
+    Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,2> rtQuadrilateral;
+    success = testContravariant(rtQuadrilateral, quadrilateral) and success;
+
+    Dune::RaviartThomasSimplexLocalFiniteElement<3,double,double> rtTetrahedron(Dune::GeometryTypes::tetrahedron, 1);
+    success = testContravariant(rtTetrahedron, tetrahedron) and success;
+
+    Dune::RaviartThomasCubeLocalFiniteElement<double,double,3,1> rtHexahedron;
+    success = testContravariant(rtHexahedron, hexahedron) and success;
+
+    Dune::Nedelec1stKindSimplexLocalFiniteElement<double,double,2,1> nedelecTriangle;
+    success = testCovariant(nedelecTriangle, triangle) and success;
+
+    Dune::Nedelec1stKindCubeLocalFiniteElement<double,double,2,2> nedelecQuadrilateral;
+    success = testCovariant(nedelecQuadrilateral, quadrilateral) and success;
+
+    Dune::Nedelec1stKindSimplexLocalFiniteElement<double,double,3,1> nedelecTetrahedron;
+    success = testCovariant(nedelecTetrahedron, tetrahedron) and success;
+
+    Dune::Nedelec1stKindCubeLocalFiniteElement<double,double,3,1> nedelecHexahedron;
+    success = testCovariant(nedelecHexahedron, hexahedron) and success;
+
+    return success ? 0 : 1;
+  }
+  catch (const Dune::Exception& e) {
+    std::cerr << e << std::endl;
+    throw;
+  }
+}
@@ -0,0 +1,155 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/affinegeometry.hh>
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localtoglobaladaptors.hh>
+#include <dune/localfunctions/lagrange/lagrangelfecache.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/utility/referenceelementmatrices.hh>
+
+// Compare a matrix to a reference and print the first deviating entry
+template<class Matrix>
+bool compare (const Matrix& matrix, const Matrix& reference, const char* name)
+{
+  for (std::size_t i = 0; i < reference.N(); ++i)
+    for (std::size_t j = 0; j < reference.M(); ++j)
+      if (std::abs(matrix[i][j] - reference[i][j]) > 1e-12)
+      {
+        std::cout << "Wrong entry (" << i << "," << j << ") of " << name << ": "
+                  << matrix[i][j] << " instead of " << reference[i][j] << std::endl;
+        return false;
+      }
+  return true;
+}
+
+// The matrices of the linear Lagrange element on the reference triangle are known
+bool testP1Triangle ()
+{
+  using FE = Dune::LagrangeSimplexLocalFiniteElement<double,double,2,1>;
+  Dune::ReferenceElementMatrices<FE> matrices{FE()};
+
+  bool success = true;
+  Dune::DynamicMatrix<double> mass(3, 3, 1.0/24);
+  for (int i = 0; i < 3; ++i)
+    mass[i][i] = 1.0/12;
+  success &= compare(matrices.mass(), mass, "mass matrix");
+
+  Dune::DynamicMatrix<double> s00(3, 3, 0);
+  s00[0][0] = s00[1][1] = 0.5;
+  s00[0][1] = s00[1][0] = -0.5;
+  success &= compare(matrices.stiffness(0,0), s00, "stiffness matrix (0,0)");
+
+  // The facet 0 is the edge between the vertices 0 and 1 of length one
+  Dune::DynamicMatrix<double> f0(3, 3, 0);
+  f0[0][0] = f0[1][1] = 1.0/3;
+  f0[0][1] = f0[1][0] = 1.0/6;
+  success &= compare(matrices.facetMass(0), f0, "facet mass matrix");
+
+  // The shape functions sum up to one, hence all rows of the advection matrices vanish
+  for (int k = 0; k < 2; ++k)
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+    {
+      double sum = 0;
+      for (std::size_t j = 0; j < matrices.size(); ++j)
+        sum += matrices.advection(k)[i][j];
+      if (std::abs(sum) > 1e-12)
+      {
+        std::cout << "Row " << i << " of advection matrix " << k << " does not vanish" << std::endl;
+        success = false;
+      }
+    }
+  return success;
+}
+
+// Compare the affine element matrices to the direct assembly with a quadrature rule
+template<class Cache, class Geometry>
+bool testAffine (const Cache& cache, const Geometry& geometry)
+{
+  constexpr int dim = Geometry::mydimension;
+  Dune::ReferenceElementMatricesCache<Cache> matricesCache(cache);
+  const auto& fe = cache.get(geometry.type());
+  const auto& matrices = matricesCache.get(geometry.type());
+  if (&matrices != &matricesCache.get(geometry.type()))
+  {
+    std::cout << "Reference element matrices are not cached" << std::endl;
+    return false;
+  }
+
+  Dune::CachedScalarLocalToGlobalBasisAdaptor basis(fe.localBasis(), geometry);
+  const std::size_t n = basis.size();
+  Dune::DynamicMatrix<double> mass(n, n, 0), stiffness(n, n, 0);
+  std::vector<typename decltype(basis)::Traits::Range> values;
+  std::vector<typename decltype(basis)::Traits::Jacobian> jacobians;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(geometry.type(), 2*basis.order()))
+  {
+    const double weight = qp.weight() * geometry.integrationElement(qp.position());
+    basis.evaluateFunction(qp.position(), values);
+    basis.evaluateJacobian(qp.position(), jacobians);
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        mass[i][j] += weight * values[i] * values[j];
+        stiffness[i][j] += weight * (jacobians[i][0] * jacobians[j][0]);
+      }
+  }
+
+  Dune::DynamicMatrix<double> affineMass, affineStiffness;
+  matrices.affineMass(geometry, affineMass);
+  matrices.affineStiffness(geometry, affineStiffness);
+
+  bool success = true;
+  success &= compare(affineMass, mass, "affine mass matrix");
+  success &= compare(affineStiffness, stiffness, "affine stiffness matrix");
+
+  // The facet mass matrices of all facets sum up to the measure of the boundary
+  const auto& refElement = Dune::ReferenceElements<double,dim>::general(geometry.type());
+  double boundary = 0, facetMass = 0;
+  for (int f = 0; f < refElement.size(1); ++f)
+  {
+    boundary += refElement.template geometry<1>(f).volume();
+    for (std::size_t i = 0; i < n; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        facetMass += matrices.facetMass(f)[i][j];
+  }
+  if (std::abs(boundary - facetMass) > 1e-12)
+  {
+    std::cout << "Facet mass matrices sum up to " << facetMass << " instead of " << boundary << std::endl;
+    success = false;
+  }
+  return success;
+}
+
+int main (int argc, char** argv)
+{
+  bool success = true;
+
+  success &= testP1Triangle();
+
+  using Geometry2d = Dune::AffineGeometry<double,2,2>;
+  using Geometry3d = Dune::AffineGeometry<double,3,3>;
+  const Dune::LagrangeLocalFiniteElementCache<double,double,2,2> cache2d;
+  const Dune::LagrangeLocalFiniteElementCache<double,double,3,2> cache3d;
+
+  success &= testAffine(cache2d, Geometry2d(Dune::GeometryTypes::triangle,
+                                            {{0.1, 0.2}, {1.3, 0.4}, {0.5, 1.1}}));
+  success &= testAffine(cache2d, Geometry2d(Dune::GeometryTypes::quadrilateral,
+                                            {{0.1, 0.2}, {1.3, 0.4}, {0.5, 1.1}, {1.7, 1.3}}));
+  success &= testAffine(cache3d, Geometry3d(Dune::GeometryTypes::tetrahedron,
+                                            {{0.1, 0.2, 0.0}, {1.3, 0.4, 0.1}, {0.5, 1.1, 0.2}, {0.3, 0.2, 0.9}}));
+
+  return success ? 0 : 1;
+}
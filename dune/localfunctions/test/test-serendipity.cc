@@ -0,0 +1,119 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/serendipity.hh>
+
+#include <dune/localfunctions/test/test-localfe.hh>
+
+// Check that the element reproduces all monomials of superlinear degree at most k
+template<class FE>
+bool testPolynomialReproduction(const FE& fe)
+{
+  using Traits = typename FE::Traits::LocalBasisType::Traits;
+  constexpr int dim = Traits::dimDomain;
+  constexpr unsigned int k = FE::Traits::LocalBasisType::order();
+  using Space = Dune::Impl::SerendipityCubeSpace<dim,k>;
+
+  bool success = true;
+  std::vector<double> coefficients;
+  std::vector<typename Traits::RangeType> values;
+  for (const auto& alpha : Space::monomials())
+  {
+    auto monomial = [&](const typename Traits::DomainType& x) {
+      double y = 1;
+      for (int i = 0; i < dim; ++i)
+        y *= std::pow(x[i], alpha[i]);
+      return y;
+    };
+    fe.localInterpolation().interpolate(monomial, coefficients);
+
+    for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(fe.type(), 2*k))
+    {
+      fe.localBasis().evaluateFunction(qp.position(), values);
+      double y = 0;
+      for (std::size_t i = 0; i < values.size(); ++i)
+        y += coefficients[i] * values[i];
+      if (std::abs(y - monomial(qp.position())) > 1e-10)
+      {
+        std::cout << "Monomial of the serendipity space is not reproduced by " << Dune::className(fe) << std::endl;
+        return false;
+      }
+    }
+  }
+  return success;
+}
+
+// Check that the shape functions of order 1 are the ones of the Q1 element
+template<int dim>
+bool testQ1()
+{
+  Dune::SerendipityCubeLocalFiniteElement<double,double,dim,1> fe;
+  Dune::LagrangeCubeLocalFiniteElement<double,double,dim,1> q1;
+
+  bool success = true;
+  std::vector<Dune::FieldVector<double,1> > values, q1Values;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(fe.type(), 2))
+  {
+    fe.localBasis().evaluateFunction(qp.position(), values);
+    q1.localBasis().evaluateFunction(qp.position(), q1Values);
+    for (std::size_t i = 0; i < q1.size(); ++i)
+      success &= std::abs(values[i] - q1Values[i]) < 1e-10;
+  }
+  for (std::size_t i = 0; i < q1.size(); ++i)
+  {
+    const auto& key = fe.localCoefficients().localKey(i);
+    const auto& q1Key = q1.localCoefficients().localKey(i);
+    success &= not (key < q1Key) and not (q1Key < key);
+  }
+  if (not success)
+    std::cout << "Serendipity element of order 1 in " << dim << "d differs from Q1" << std::endl;
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  // The number of degrees of freedom for the orders 1,...,4
+  constexpr std::size_t sizes2d[] = {4, 8, 12, 17};
+  constexpr std::size_t sizes3d[] = {8, 20, 32, 50};
+
+  Dune::Hybrid::forEach(std::make_index_sequence<4>{}, [&](auto i) {
+    constexpr int k = i+1;
+
+    Dune::SerendipityCubeLocalFiniteElement<double,double,2,k> fe2d;
+    TEST_FE3(fe2d, DisableNone, 2);
+    success &= testPolynomialReproduction(fe2d);
+    success &= (fe2d.size() == sizes2d[i]);
+
+    Dune::SerendipityCubeLocalFiniteElement<double,double,3,k> fe3d;
+    TEST_FE3(fe3d, DisableNone, 2);
+    success &= testPolynomialReproduction(fe3d);
+    success &= (fe3d.size() == sizes3d[i]);
+
+    Dune::SerendipityLocalFiniteElementCache<double,double,3,k> cache;
+    const auto& fe = cache.get(Dune::GeometryTypes::hexahedron);
+    success &= (fe.size() == sizes3d[i]);
+    TEST_FE(fe);
+  });
+
+  success &= testQ1<2>();
+  success &= testQ1<3>();
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+#include <dune/common/classname.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/localfunctions/enriched/simplexp1bubble.hh>
+#include <dune/localfunctions/hierarchical/hierarchicalp2withelementbubble.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/monomial.hh>
+#include <dune/localfunctions/utility/referenceelementmatrices.hh>
+#include <dune/localfunctions/utility/staticcondensation.hh>
+
+// Check the partition of the degrees of freedom against the local keys
+template<class FE>
+bool testPartition(const FE& fe, const Dune::LocalDofPartition& partition)
+{
+  const auto& coefficients = fe.localCoefficients();
+  bool success = (partition.size() == coefficients.size());
+  for (std::size_t i = 0; success and i < coefficients.size(); ++i)
+  {
+    const bool interior = (coefficients.localKey(i).codim() == 0);
+    success &= (partition.isInterior(i) == interior);
+    success &= (partition.permutation()[partition.inversePermutation()[i]] == i);
+    success &= (partition.partitionedIndex(i) < partition.interfaceSize()) != interior;
+  }
+  for (std::size_t j = 0; success and j < partition.interfaceSize(); ++j)
+    success &= not partition.isInterior(partition.interfaceIndex(j));
+  for (std::size_t j = 0; success and j < partition.interiorSize(); ++j)
+    success &= partition.isInterior(partition.interiorIndex(j));
+  if (not success)
+    std::cout << "Wrong partition of the degrees of freedom of " << Dune::className(fe) << std::endl;
+  return success;
+}
+
+// Compare the solution of the condensed system with the solution of the full element system
+template<class FE>
+bool testStaticCondensation(const FE& fe)
+{
+  const Dune::LocalDofPartition partition(fe.localCoefficients());
+  bool success = testPartition(fe, partition);
+
+  // A symmetric positive definite element matrix and some right hand side
+  const Dune::ReferenceElementMatrices<FE> matrices(fe);
+  constexpr int dim = FE::Traits::LocalBasisType::Traits::dimDomain;
+  auto A = matrices.mass();
+  for (int k = 0; k < dim; ++k)
+    A += matrices.stiffness(k, k);
+  const std::size_t n = A.N();
+  Dune::DynamicVector<double> b(n), x(n);
+  for (std::size_t i = 0; i < n; ++i)
+    b[i] = std::sin(1.0 + 2*i);
+  A.solve(x, b);
+
+  // A second element with another matrix and right hand side
+  auto A2 = A;
+  A2 += matrices.mass();
+  A2 *= 3.0;
+  Dune::DynamicVector<double> b2(n), x2(n);
+  for (std::size_t i = 0; i < n; ++i)
+    b2[i] = std::cos(2.0 + i);
+  A2.solve(x2, b2);
+
+  // Condense both elements with the same object before recovering any of them
+  const Dune::StaticCondensation<double> condensation(partition);
+  const auto element = condensation.condense(A, b);
+  const auto element2 = condensation.condense(A2, b2);
+
+  auto solve = [&](const auto& condensed, const auto& expected) {
+    bool ok = (condensed.matrix().N() == partition.interfaceSize());
+    ok &= (condensed.rhs().size() == partition.interfaceSize());
+
+    Dune::DynamicVector<double> xInterface(partition.interfaceSize()), xRecovered;
+    if (partition.interfaceSize() > 0)
+      condensed.matrix().solve(xInterface, condensed.rhs());
+    condensation.recover(condensed, xInterface, xRecovered);
+
+    ok &= (xRecovered.size() == n);
+    for (std::size_t i = 0; ok and i < n; ++i)
+      ok &= std::abs(expected[i] - xRecovered[i]) < 1e-8;
+    return ok;
+  };
+  success &= solve(element, x);
+  success &= solve(element2, x2);
+  if (not success)
+    std::cout << "Static condensation does not reproduce the solution for " << Dune::className(fe) << std::endl;
+  return success;
+}
+
+// Check whether the partition of an element is the identity and, if not, the
+// index of its first interior degree of freedom
+template<class FE>
+bool testPermutation(const FE& fe, bool identity, std::size_t firstInterior)
+{
+  const Dune::LocalDofPartition partition(fe.localCoefficients());
+  bool success = (partition.isIdentity() == identity);
+  if (not identity)
+    success &= (partition.interiorIndex(0) == firstInterior);
+  if (not success)
+    std::cout << "Unexpected permutation of the degrees of freedom of " << Dune::className(fe) << std::endl;
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  // The interior degree of freedom of P3 on a triangle is numbered lexicographically
+  // between the nodes on the edges, the bubble of P1 is the last one
+  success &= testPermutation(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,3>(), false, 5);
+  success &= testPermutation(Dune::SimplexP1BubbleLocalFiniteElement<double,double,2>(), true, 0);
+
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto k) {
+    success &= testStaticCondensation(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>());
+    success &= testStaticCondensation(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>());
+    success &= testStaticCondensation(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>());
+    success &= testStaticCondensation(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>());
+  });
+
+  success &= testStaticCondensation(Dune::SimplexP1BubbleLocalFiniteElement<double,double,2>());
+  success &= testStaticCondensation(Dune::SimplexP1BubbleLocalFiniteElement<double,double,3>());
+  success &= testStaticCondensation(Dune::HierarchicalP2WithElementBubbleLocalFiniteElement<double,double,2>());
+
+  // Only interior degrees of freedom
+  success &= testStaticCondensation(Dune::MonomialLocalFiniteElement<double,double,2,2>(Dune::GeometryTypes::triangle));
+
+  return success ? 0 : 1;
+}
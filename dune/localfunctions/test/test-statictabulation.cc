@@ -0,0 +1,120 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/lagrange/p0.hh>
+#include <dune/localfunctions/lagrange/statictabulation.hh>
+
+// The tabulated values must sum to one at each point, also in a constant expression
+constexpr bool partitionOfUnity ()
+{
+  using Basis = Dune::Impl::LagrangeSimplexLocalBasis<double,double,2,2>;
+  constexpr auto rule = Dune::staticSimplexQuadratureRule<double,2,2>();
+  constexpr auto values = Dune::tabulateFunction<Basis>(rule);
+  for (const auto& v : values)
+  {
+    double sum = 0;
+    for (double vi : v)
+      sum += vi;
+    if (sum < 1 - 1e-12 or sum > 1 + 1e-12)
+      return false;
+  }
+  return true;
+}
+static_assert(partitionOfUnity());
+
+// Check that the weights of a rule sum up to the volume of the reference element and that it integrates x_0^order exactly
+template<class Rule>
+bool testRule(const Rule& rule, double volume, int order, double moment)
+{
+  double sum = 0, integral = 0;
+  for (std::size_t q = 0; q < rule.size(); ++q)
+  {
+    sum += rule.weights[q];
+    integral += rule.weights[q] * std::pow(rule.points[q][0], order);
+  }
+  const bool success = std::abs(sum - volume) < 1e-12 and std::abs(integral - moment) < 1e-12;
+  if (not success)
+    std::cout << "Static quadrature rule of order " << order << " is not exact" << std::endl;
+  return success;
+}
+
+// Compare the tables computed at compile time with the values and gradients of the local basis
+template<class FE, class Rule>
+bool testTabulation(const FE& fe, const Rule& rule)
+{
+  using LocalBasis = typename FE::Traits::LocalBasisType;
+  using Range = typename LocalBasis::Traits::RangeType;
+  using Jacobian = typename LocalBasis::Traits::JacobianType;
+  constexpr int dim = LocalBasis::Traits::dimDomain;
+
+  const auto values = Dune::tabulateFunction<LocalBasis>(rule);
+  const auto jacobians = Dune::tabulateJacobian<LocalBasis>(rule);
+
+  bool success = (values[0].size() == fe.localBasis().size());
+  std::vector<Range> y;
+  std::vector<Jacobian> dy;
+  for (std::size_t q = 0; success and q < rule.size(); ++q)
+  {
+    Dune::FieldVector<double,dim> x;
+    for (int j = 0; j < dim; ++j)
+      x[j] = rule.points[q][j];
+    fe.localBasis().evaluateFunction(x, y);
+    fe.localBasis().evaluateJacobian(x, dy);
+
+    const auto point = Dune::evaluateFunctionStatic<LocalBasis>(rule.points[q]);
+    for (std::size_t i = 0; i < y.size(); ++i)
+    {
+      success &= std::abs(values[q][i] - y[i]) < 1e-12;
+      success &= (point[i] == values[q][i]);
+      for (int j = 0; j < dim; ++j)
+        success &= std::abs(jacobians[q][i][j] - dy[i][0][j]) < 1e-10;
+    }
+  }
+  if (not success)
+    std::cout << "Static tabulation differs from the local basis of " << Dune::className(fe) << std::endl;
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  success &= testRule(Dune::staticSimplexQuadratureRule<double,2,1>(), 0.5, 1, 1.0/6);
+  success &= testRule(Dune::staticSimplexQuadratureRule<double,2,2>(), 0.5, 2, 1.0/12);
+  success &= testRule(Dune::staticSimplexQuadratureRule<double,3,2>(), 1.0/6, 2, 1.0/60);
+  success &= testRule(Dune::staticCubeQuadratureRule<double,2,5>(), 1.0, 5, 1.0/6);
+  success &= testRule(Dune::staticCubeQuadratureRule<double,3,3>(), 1.0, 3, 1.0/4);
+
+  success &= testTabulation(Dune::P0LocalFiniteElement<double,double,2>(Dune::GeometryTypes::triangle),
+                            Dune::staticSimplexQuadratureRule<double,2,1>());
+  success &= testTabulation(Dune::P0LocalFiniteElement<double,double,3>(Dune::GeometryTypes::hexahedron),
+                            Dune::staticCubeQuadratureRule<double,3,1>());
+
+  Dune::Hybrid::forEach(std::make_index_sequence<4>{}, [&](auto k) {
+    success &= testTabulation(Dune::LagrangeSimplexLocalFiniteElement<double,double,1,k>(),
+                              Dune::staticSimplexQuadratureRule<double,1,2>());
+    success &= testTabulation(Dune::LagrangeSimplexLocalFiniteElement<double,double,2,k>(),
+                              Dune::staticSimplexQuadratureRule<double,2,2>());
+    success &= testTabulation(Dune::LagrangeSimplexLocalFiniteElement<double,double,3,k>(),
+                              Dune::staticSimplexQuadratureRule<double,3,2>());
+    success &= testTabulation(Dune::LagrangeCubeLocalFiniteElement<double,double,2,k>(),
+                              Dune::staticCubeQuadratureRule<double,2,3>());
+    success &= testTabulation(Dune::LagrangeCubeLocalFiniteElement<double,double,3,k>(),
+                              Dune::staticCubeQuadratureRule<double,3,5>());
+  });
+
+  return success ? 0 : 1;
+}
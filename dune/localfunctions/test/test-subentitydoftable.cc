@@ -0,0 +1,120 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <type_traits>
+
+#include <dune/common/classname.hh>
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/localfunctions/common/subentitydoftable.hh>
+#include <dune/localfunctions/lagrange/lagrangecube.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/mimetic.hh>
+#include <dune/localfunctions/nedelec/nedelec1stkindcube.hh>
+#include <dune/localfunctions/nedelec/nedelec1stkindsimplex.hh>
+#include <dune/localfunctions/raviartthomas.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomassimplex.hh>
+#include <dune/localfunctions/serendipity/serendipitycube.hh>
+
+// Compare the table with the local keys of the coefficients
+template<class LocalCoefficients>
+bool testSubEntityDofTable(const LocalCoefficients& coefficients)
+{
+  const auto& table = Dune::subEntityDofTable(coefficients);
+  bool success = (table.size() == coefficients.size());
+
+  for (std::size_t i = 0; i < coefficients.size(); ++i)
+  {
+    const auto& key = coefficients.localKey(i);
+    std::size_t subEntitySize = 0, codimSize = 0;
+    std::size_t first = coefficients.size();
+    for (std::size_t j = 0; j < coefficients.size(); ++j)
+    {
+      const auto& other = coefficients.localKey(j);
+      if (other.codim() != key.codim())
+        continue;
+      ++codimSize;
+      if (other.subEntity() == key.subEntity())
+      {
+        ++subEntitySize;
+        if (other.index() == 0)
+          first = j;
+      }
+    }
+    success &= (table.size(key.codim()) == codimSize);
+    success &= (table.size(key.subEntity(), key.codim()) == subEntitySize);
+    success &= (key.index() < subEntitySize) and (table.index(key.subEntity(), key.codim(), key.index()) == i);
+    if (table.isContiguous(key.subEntity(), key.codim()))
+      success &= (i == first + key.index());
+  }
+
+  // Subentities without degrees of freedom
+  success &= (table.size(100, 0) == 0) and (table.size(0, 4) == 0) and table.isContiguous(100, 0);
+
+  if (not success)
+    std::cout << "Subentity table does not match the local keys of " << Dune::className(coefficients) << std::endl;
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  Dune::Hybrid::forEach(std::make_index_sequence<5>{}, [&](auto k) {
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<1,k>());
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<2,k>());
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<3,k>());
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeCubeLocalCoefficients<1,k>());
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeCubeLocalCoefficients<2,k>());
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeCubeLocalCoefficients<3,k>());
+
+    // The shared tables of the simplex depend on the order of the vertices
+    std::array<unsigned int,3> vertexMap2d;
+    std::iota(vertexMap2d.begin(), vertexMap2d.end(), 0);
+    do
+      success &= testSubEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<2,k>(vertexMap2d));
+    while (std::next_permutation(vertexMap2d.begin(), vertexMap2d.end()));
+    success &= testSubEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<2,k>(std::array<unsigned int,3>{17, 3, 8}));
+
+    std::array<unsigned int,4> vertexMap3d;
+    std::iota(vertexMap3d.begin(), vertexMap3d.end(), 0);
+    do
+      success &= testSubEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<3,k>(vertexMap3d));
+    while (std::next_permutation(vertexMap3d.begin(), vertexMap3d.end()));
+  });
+
+  // The Lagrange and serendipity coefficients share one table per type
+  static_assert(std::is_reference_v<decltype(Dune::subEntityDofTable(Dune::Impl::LagrangeCubeLocalCoefficients<2,2>()))>);
+  static_assert(std::is_reference_v<decltype(Dune::subEntityDofTable(Dune::Impl::LagrangeSimplexLocalCoefficients<2,2>()))>);
+  success &= testSubEntityDofTable(Dune::Impl::SerendipityCubeLocalCoefficients<2,4>());
+  success &= testSubEntityDofTable(Dune::Impl::SerendipityCubeLocalCoefficients<3,3>());
+
+  // The Raviart-Thomas and Nedelec coefficients of fixed order share one table per type
+  static_assert(std::is_reference_v<decltype(Dune::subEntityDofTable(Dune::RT02DLocalCoefficients()))>);
+  static_assert(std::is_reference_v<decltype(Dune::subEntityDofTable(Dune::Impl::Nedelec1stKindCubeLocalCoefficients<3,1>()))>);
+  success &= testSubEntityDofTable(Dune::RT02DLocalCoefficients());
+  success &= testSubEntityDofTable(Dune::RT1Cube3DLocalCoefficients());
+  success &= testSubEntityDofTable(Dune::RT4Cube2DLocalCoefficients());
+  success &= testSubEntityDofTable(Dune::RT0PyramidLocalCoefficients());
+  success &= testSubEntityDofTable(Dune::Impl::Nedelec1stKindCubeLocalCoefficients<3,1>());
+  success &= testSubEntityDofTable(Dune::Impl::Nedelec1stKindSimplexLocalCoefficients<3,1>());
+
+  // Coefficients without state share one table per type
+  static_assert(std::is_reference_v<decltype(Dune::subEntityDofTable(Dune::Impl::TensorProductVectorCubeLocalCoefficients<3,2,true>()))>);
+  success &= testSubEntityDofTable(Dune::Impl::TensorProductVectorCubeLocalCoefficients<2,3,true>());
+  success &= testSubEntityDofTable(Dune::Impl::TensorProductVectorCubeLocalCoefficients<3,2,false>());
+
+  // Generic fallback
+  static_assert(not std::is_reference_v<decltype(Dune::subEntityDofTable(Dune::MimeticLocalCoefficients(5)))>);
+  success &= testSubEntityDofTable(Dune::RaviartThomasSimplexLocalFiniteElement<2,double,double>(Dune::GeometryTypes::triangle, 2).localCoefficients());
+  success &= testSubEntityDofTable(Dune::MimeticLocalCoefficients(5));
+
+  return success ? 0 : 1;
+}
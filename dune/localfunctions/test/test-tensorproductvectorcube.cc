@@ -0,0 +1,187 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <bitset>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/classname.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/localfunctions/nedelec/nedelec1stkindcube.hh>
+#include <dune/localfunctions/raviartthomas/raviartthomascube.hh>
+
+// An element given by the map x = J*xi + b with a rotation J. For rotations
+// both the contravariant and the covariant Piola transformation are u = J*u_ref.
+template<int dim>
+struct Placement
+{
+  Dune::FieldMatrix<double,dim,dim> J;
+  Dune::FieldVector<double,dim> b;
+
+  Dune::FieldVector<double,dim> global (const Dune::FieldVector<double,dim>& xi) const
+  {
+    auto x = b;
+    J.umv(xi, x);
+    return x;
+  }
+
+  Dune::FieldVector<double,dim> local (const Dune::FieldVector<double,dim>& x) const
+  {
+    Dune::FieldVector<double,dim> xi;
+    J.mtv(x - b, xi);
+    return xi;
+  }
+};
+
+// Check that the normal (normal=true) or tangential traces of a global function
+// coincide on the facet shared by two elements. The orientations of the subentities
+// of the second element are flipped where they differ from the first element.
+template<class FE, int dim, bool normal>
+bool testTraceContinuity(const Placement<dim>& p0, const Placement<dim>& p1)
+{
+  const auto& refElement = Dune::ReferenceElements<double,dim>::cube();
+  const int orientedCodim = normal ? 1 : dim-1;
+
+  auto globalCenter = [&](const auto& p, int subEntity, int codim) {
+    return p.global(refElement.position(subEntity, codim));
+  };
+
+  // Find the subentity of the second element with the same center as a subentity of the first one
+  auto match = [&](int subEntity, int codim) {
+    const auto x = globalCenter(p0, subEntity, codim);
+    for (int s=0; s<refElement.size(codim); ++s)
+      if ((globalCenter(p1, s, codim) - x).two_norm() < 1e-10)
+        return s;
+    return -1;
+  };
+
+  // The shared facet and its normal
+  int facet0 = 0;
+  while (match(facet0, 1) < 0)
+    ++facet0;
+  Dune::FieldVector<double,dim> n;
+  p0.J.mv(refElement.integrationOuterNormal(facet0), n);
+
+  // Flip the orientation of the subentities of the second element where necessary
+  std::bitset<Dune::Impl::TensorProductVectorCubeStructure<dim,1,normal>::numOrientedSubentities> orientation;
+  for (int s0=0; s0<refElement.size(orientedCodim); ++s0)
+  {
+    const int s1 = match(s0, orientedCodim);
+    if (s1 < 0)
+      continue;
+    if (normal)
+      orientation[s1] = true;
+    else
+    {
+      // Compare the edge tangents
+      auto tangent = [&](const auto& p, int s) {
+        auto t = refElement.position(refElement.subEntity(s, dim-1, 1, dim), dim);
+        t -= refElement.position(refElement.subEntity(s, dim-1, 0, dim), dim);
+        Dune::FieldVector<double,dim> result;
+        p.J.mv(t, result);
+        return result;
+      };
+      orientation[s1] = (tangent(p0, s0) * tangent(p1, s1) < 0);
+    }
+  }
+
+  const FE fe0;
+  const FE fe1(orientation);
+
+  // Coefficients of a global function, shared degrees of freedom get the same value
+  std::vector<double> c0(fe0.size()), c1(fe1.size());
+  for (std::size_t i=0; i<c0.size(); ++i)
+    c0[i] = std::sin(1.0 + i);
+  for (std::size_t j=0; j<c1.size(); ++j)
+  {
+    c1[j] = std::cos(2.0 + j);
+    const auto& key1 = fe1.localCoefficients().localKey(j);
+    for (std::size_t i=0; i<c0.size(); ++i)
+    {
+      const auto& key0 = fe0.localCoefficients().localKey(i);
+      if (key0.codim() == key1.codim() and key0.index() == key1.index()
+          and match(key0.subEntity(), key0.codim()) == int(key1.subEntity()))
+        c1[j] = c0[i];
+    }
+  }
+
+  auto evaluate = [&](const FE& fe, const std::vector<double>& c, const Placement<dim>& p,
+                      const Dune::FieldVector<double,dim>& x) {
+    std::vector<typename FE::Traits::LocalBasisType::Traits::RangeType> values;
+    fe.localBasis().evaluateFunction(p.local(x), values);
+    Dune::FieldVector<double,dim> uRef(0), u;
+    for (std::size_t i=0; i<values.size(); ++i)
+      uRef.axpy(c[i], values[i]);
+    p.J.mv(uRef, u);
+    return u;
+  };
+
+  // Compare the traces at points on the shared facet
+  bool success = true;
+  for (int sample=0; sample<5; ++sample)
+  {
+    auto xi = refElement.position(facet0, 1);
+    for (int j=0; j<dim; ++j)
+      if (std::abs(refElement.integrationOuterNormal(facet0)[j]) < 0.5)
+        xi[j] = 0.5 + 0.45*std::sin(1.0 + 3*sample + 7*j);
+    const auto x = p0.global(xi);
+    auto u0 = evaluate(fe0, c0, p0, x);
+    auto u1 = evaluate(fe1, c1, p1, x);
+    if constexpr (normal)
+      success &= std::abs(u0*n - u1*n) < 1e-8;
+    else
+    {
+      u0.axpy(-(u0*n), n);
+      u1.axpy(-(u1*n), n);
+      success &= (u0 - u1).two_norm() < 1e-8;
+    }
+  }
+
+  if (not success)
+    std::cerr << "Traces of " << Dune::className<FE>() << " do not coincide on the facet shared with an element"
+              << " with offset " << p1.b << std::endl;
+  return success;
+}
+
+int main(int argc, char** argv)
+{
+  bool success = true;
+
+  // The reference square and its right neighbor: translated, rotated by 90 and by 180 degrees
+  const Placement<2> square{{{1,0},{0,1}}, {0,0}};
+  const std::vector<Placement<2>> squareNeighbors = {
+    {{{1,0},{0,1}}, {1,0}},
+    {{{0,-1},{1,0}}, {2,0}},
+    {{{-1,0},{0,-1}}, {2,1}}
+  };
+  for (const auto& neighbor : squareNeighbors)
+  {
+    success &= testTraceContinuity<Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,1>,2,true>(square, neighbor);
+    success &= testTraceContinuity<Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,5>,2,true>(square, neighbor);
+    success &= testTraceContinuity<Dune::RaviartThomasCubeLocalFiniteElement<double,double,2,6>,2,true>(square, neighbor);
+    success &= testTraceContinuity<Dune::Nedelec1stKindCubeLocalFiniteElement<double,double,2,2>,2,false>(square, neighbor);
+    success &= testTraceContinuity<Dune::Nedelec1stKindCubeLocalFiniteElement<double,double,2,3>,2,false>(square, neighbor);
+  }
+
+  // The reference cube and neighbors translated in all directions and rotated about the z-axis
+  const Placement<3> cube{{{1,0,0},{0,1,0},{0,0,1}}, {0,0,0}};
+  const std::vector<Placement<3>> cubeNeighbors = {
+    {{{1,0,0},{0,1,0},{0,0,1}}, {1,0,0}},
+    {{{1,0,0},{0,1,0},{0,0,1}}, {0,1,0}},
+    {{{1,0,0},{0,1,0},{0,0,1}}, {0,0,1}},
+    {{{-1,0,0},{0,-1,0},{0,0,1}}, {2,1,0}}
+  };
+  for (const auto& neighbor : cubeNeighbors)
+    success &= testTraceContinuity<Dune::RaviartThomasCubeLocalFiniteElement<double,double,3,2>,3,true>(cube, neighbor);
+  for (std::size_t i=0; i<3; ++i)
+    success &= testTraceContinuity<Dune::Nedelec1stKindCubeLocalFiniteElement<double,double,3,3>,3,false>(cube, cubeNeighbors[i]);
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/hierarchical/hierarchicalsimplex.hh>
+#include <dune/localfunctions/lagrange/lagrangelfecache.hh>
+#include <dune/localfunctions/lagrange/lagrangesimplex.hh>
+#include <dune/localfunctions/utility/transfermatrix.hh>
+
+// Check that the product of two transfer matrices is the identity
+template<class Matrix>
+bool checkIdentity (const Matrix& restriction, const Matrix& prolongation, const char* name)
+{
+  for (std::size_t i = 0; i < restriction.N(); ++i)
+    for (std::size_t j = 0; j < prolongation.M(); ++j)
+    {
+      double product = 0;
+      for (std::size_t k = 0; k < prolongation.N(); ++k)
+        product += restriction[i][k] * prolongation[k][j];
+      if (std::abs(product - (i == j)) > 1e-12)
+      {
+        std::cout << "Transfer matrices " << name << " are not inverse: entry ("
+                  << i << "," << j << ") is " << product << std::endl;
+        return false;
+      }
+    }
+  return true;
+}
+
+// Check that the transferred coefficients represent the same function
+template<class FromFE, class ToFE, class Matrix>
+bool checkProlongation (const FromFE& from, const ToFE& to, const Matrix& prolongation)
+{
+  constexpr int dim = FromFE::Traits::LocalBasisType::Traits::dimDomain;
+  Dune::DynamicVector<double> fromCoefficients(from.size()), toCoefficients(to.size());
+  for (std::size_t i = 0; i < from.size(); ++i)
+    fromCoefficients[i] = std::sin(1.0 + i);
+  prolongation.mv(fromCoefficients, toCoefficients);
+
+  std::vector<typename FromFE::Traits::LocalBasisType::Traits::RangeType> fromValues;
+  std::vector<typename ToFE::Traits::LocalBasisType::Traits::RangeType> toValues;
+  for (const auto& qp : Dune::QuadratureRules<double,dim>::rule(from.type(), 4))
+  {
+    from.localBasis().evaluateFunction(qp.position(), fromValues);
+    to.localBasis().evaluateFunction(qp.position(), toValues);
+    double fromValue = 0, toValue = 0;
+    for (std::size_t i = 0; i < from.size(); ++i)
+      fromValue += fromCoefficients[i] * fromValues[i][0];
+    for (std::size_t i = 0; i < to.size(); ++i)
+      toValue += toCoefficients[i] * toValues[i][0];
+    if (std::abs(fromValue - toValue) > 1e-12)
+    {
+      std::cout << "Prolongated function differs at " << qp.position() << ": "
+                << toValue << " instead of " << fromValue << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int main (int argc, char** argv)
+{
+  bool success = true;
+
+  // Prolongation from order one to order three and back
+  Dune::LagrangeSimplexLocalFiniteElement<double,double,2,1> p1;
+  Dune::LagrangeSimplexLocalFiniteElement<double,double,2,3> p3;
+  auto p1ToP3 = Dune::transferMatrix(p1, p3);
+  auto p3ToP1 = Dune::transferMatrix(p3, p1);
+  success &= checkProlongation(p1, p3, p1ToP3);
+  success &= checkIdentity(p3ToP1, p1ToP3, "P3 to P1 and P1 to P3");
+
+  // Change of basis between nodal and hierarchical basis of the same space
+  Dune::LagrangeSimplexLocalFiniteElement<double,double,3,3> nodal;
+  Dune::HierarchicalSimplexLocalFiniteElement<double,double,3,3> hierarchical;
+  auto nodalToHierarchical = Dune::transferMatrix(nodal, hierarchical);
+  auto hierarchicalToNodal = Dune::transferMatrix(hierarchical, nodal);
+  success &= checkProlongation(nodal, hierarchical, nodalToHierarchical);
+  success &= checkIdentity(hierarchicalToNodal, nodalToHierarchical, "hierarchical to nodal and nodal to hierarchical");
+  success &= checkIdentity(nodalToHierarchical, hierarchicalToNodal, "nodal to hierarchical and hierarchical to nodal");
+
+  // Cached prolongation between the elements of two caches
+  using Cache1 = Dune::LagrangeLocalFiniteElementCache<double,double,2,1>;
+  using Cache2 = Dune::LagrangeLocalFiniteElementCache<double,double,2,2>;
+  const Cache1 cache1;
+  const Cache2 cache2;
+  Dune::TransferMatrixCache<Cache1,Cache2> prolongations(cache1, cache2);
+  Dune::TransferMatrixCache<Cache2,Cache1> restrictions(cache2, cache1);
+  for (auto type : {Dune::GeometryTypes::triangle, Dune::GeometryTypes::quadrilateral})
+  {
+    const auto& prolongation = prolongations.get(type);
+    if (&prolongation != &prolongations.get(type))
+    {
+      std::cout << "Transfer matrix for " << type << " is not cached" << std::endl;
+      success = false;
+    }
+    success &= checkProlongation(cache1.get(type), cache2.get(type), prolongation);
+    success &= checkIdentity(restrictions.get(type), prolongation, "of the caches");
+  }
+
+  return success ? 0 : 1;
+}
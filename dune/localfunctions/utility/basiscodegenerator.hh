@@ -0,0 +1,341 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_BASISCODEGENERATOR_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_BASISCODEGENERATOR_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/utility/field.hh>
+#include <dune/localfunctions/utility/monomialbasis.hh>
+#include <dune/localfunctions/utility/multiindex.hh>
+
+namespace Dune
+{
+
+  namespace Impl
+  {
+
+    // A polynomial as map from the exponents of the monomials to their coefficients
+    using GeneratorPolynomial = std::map<std::vector<int>,double>;
+
+    inline GeneratorPolynomial derivative (const GeneratorPolynomial& p, std::size_t j)
+    {
+      GeneratorPolynomial dp;
+      for (const auto& [exponents, coefficient] : p)
+        if (exponents[j] > 0)
+        {
+          auto e = exponents;
+          --e[j];
+          dp[e] += exponents[j] * coefficient;
+        }
+      return dp;
+    }
+
+    // Writes a polynomial in nested Horner form as a sequence of assignments to
+    // temporaries. Equal subexpressions, e.g. powers of the coordinates or inner
+    // Horner polynomials shared by several shape functions, are computed once.
+    class StraightLineCodeWriter
+    {
+    public:
+      explicit StraightLineCodeWriter (std::size_t dim)
+        : used_(dim, false)
+      {}
+
+      // The expression of the polynomial, a temporary or a constant
+      std::string horner (const GeneratorPolynomial& p)
+      {
+        return p.empty() ? "0" : horner(p, 0);
+      }
+
+      // Declarations of the used coordinates and of all temporaries
+      void write (std::ostream& out, const std::string& indent) const
+      {
+        for (std::size_t j = 0; j < used_.size(); ++j)
+          if (used_[j])
+            out << indent << "const R x" << j << " = x[" << j << "];\n";
+        for (const auto& declaration : declarations_)
+          out << indent << declaration << "\n";
+      }
+
+    private:
+      // Horner scheme in the coordinate v, the coefficients are polynomials in the coordinates after v
+      std::string horner (const GeneratorPolynomial& p, std::size_t v)
+      {
+        if (v == used_.size())
+          return constant(p.begin()->second);
+
+        std::map<int,GeneratorPolynomial> coefficients;
+        for (const auto& [exponents, coefficient] : p)
+          coefficients[exponents[v]].emplace(exponents, coefficient);
+
+        std::string result;
+        int last = 0;
+        for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it)
+        {
+          const std::string q = horner(it->second, v+1);
+          result = result.empty() ? q : add(multiply(result, power(v, last - it->first)), q);
+          last = it->first;
+        }
+        return (last > 0) ? multiply(result, power(v, last)) : result;
+      }
+
+      std::string constant (double c) const
+      {
+        std::ostringstream s;
+        s.precision(std::numeric_limits<double>::max_digits10);
+        s << c;
+        return s.str();
+      }
+
+      std::string power (std::size_t v, int k)
+      {
+        used_[v] = true;
+        const std::string x = "x" + std::to_string(v);
+        return (k == 1) ? x : temporary(power(v, k-1) + "*" + x);
+      }
+
+      std::string multiply (const std::string& a, const std::string& b)
+      {
+        if (a == "1")
+          return b;
+        if (a == "-1")
+          return temporary("-" + b);
+        return temporary(a + "*" + b);
+      }
+
+      std::string add (const std::string& a, const std::string& b)
+      {
+        if (b[0] == '-')
+          return temporary(a + " - " + b.substr(1));
+        return temporary(a + " + " + b);
+      }
+
+      std::string temporary (const std::string& expression)
+      {
+        auto [it, inserted] = temporaries_.emplace(expression, "t" + std::to_string(temporaries_.size()));
+        if (inserted)
+          declarations_.push_back("const R " + it->second + " = " + expression + ";");
+        return it->second;
+      }
+
+      std::vector<bool> used_;
+      std::map<std::string,std::string> temporaries_;
+      std::vector<std::string> declarations_;
+    };
+
+    // Call f(alpha) for all multi-indices alpha with |alpha| = totalOrder, varying the entries from j on
+    template<class F>
+    void forEachMultiIndex (std::vector<int>& alpha, std::size_t j, int totalOrder, F&& f)
+    {
+      if (j+1 == alpha.size())
+      {
+        alpha[j] = totalOrder;
+        f(alpha);
+        return;
+      }
+      for (int a = totalOrder; a >= 0; --a)
+      {
+        alpha[j] = a;
+        forEachMultiIndex(alpha, j+1, totalOrder-a, f);
+      }
+    }
+
+  } // namespace Impl
+
+
+  /** \brief Write specialized C++ code evaluating a PolynomialBasis
+   *
+   * The shape functions of bases created by a DefaultBasisFactory, e.g.
+   * RaviartThomasBasisFactory, NedelecBasisFactory or LagrangeBasisFactory,
+   * are evaluated by computing all monomials and multiplying them with the
+   * coefficient matrix. For a fixed element and order this function writes
+   * the definition of a class
+   * \code
+   * template<class D, class R> class className;
+   * \endcode
+   * in the namespace Dune, which implements the LocalBasis interface, i.e.
+   * evaluateFunction(), evaluateJacobian(), partial(), size() and order().
+   * The components of the shape functions and of their derivatives are expanded
+   * into nested Horner schemes and evaluated by straight-line code, in which
+   * common subexpressions of all shape functions are computed only once.
+   *
+   * Coefficients whose absolute value is at most threshold are considered as
+   * round-off errors of the construction of the coefficient matrix and are
+   * dropped. The generated code needs the headers dune/common/fvector.hh,
+   * dune/common/fmatrix.hh, dune/localfunctions/common/localbasis.hh,
+   * &lt;array&gt; and &lt;vector&gt;.
+   *
+   * Usually, the code is written by a small program at build time, see the
+   * CMake function dune_localfunctions_generate_basis().
+   *
+   * \tparam geometryId The reference element the basis was created for
+   * \param out The stream to write the code to
+   * \param basis The basis, e.g. the Object of a DefaultBasisFactory
+   * \param className The name of the generated class template
+   * \param threshold Coefficients of at most this absolute value are dropped
+   */
+  template<GeometryType::Id geometryId, class Basis>
+  void generateBasisCode (std::ostream& out, const Basis& basis, const std::string& className,
+                          double threshold = 1e-12)
+  {
+    constexpr std::size_t dim = Basis::dimension;
+    constexpr std::size_t dimRange = Basis::dimRange;
+    const std::size_t size = basis.size();
+
+    // The exponents of the monomials in the order of the columns of the coefficient matrix
+    using Monomial = MultiIndex<dim,double>;
+    MonomialBasis<geometryId,Monomial> monomialBasis(basis.basis().order());
+    std::vector<Monomial> monomials(monomialBasis.size());
+    FieldVector<Monomial,dim> x;
+    for (std::size_t j = 0; j < dim; ++j)
+      x[j].set(j, 1);
+    monomialBasis.evaluate(x, monomials);
+
+    // The components of the shape functions as polynomials
+    std::vector<Impl::GeneratorPolynomial> polynomials(size*dimRange);
+    for (std::size_t row = 0; row < polynomials.size(); ++row)
+    {
+      std::vector<double> coefficients(basis.matrix().baseSize(), 0.0);
+      basis.matrix().addRow(row, Unity<typename Basis::StorageField>(), coefficients);
+      for (std::size_t m = 0; m < coefficients.size(); ++m)
+      {
+        const double c = coefficients[m] * monomials[m].factor();
+        if (std::abs(c) <= threshold)
+          continue;
+        std::vector<int> exponents(dim);
+        for (std::size_t j = 0; j < dim; ++j)
+          exponents[j] = monomials[m].z(j);
+        polynomials[row][exponents] += c;
+      }
+      for (auto it = polynomials[row].begin(); it != polynomials[row].end(); )
+        it = (std::abs(it->second) <= threshold) ? polynomials[row].erase(it) : std::next(it);
+    }
+
+    out << "namespace Dune\n"
+        << "{\n\n"
+        << "  template<class D, class R>\n"
+        << "  class " << className << "\n"
+        << "  {\n"
+        << "  public:\n"
+        << "    using Traits = LocalBasisTraits<D," << dim << ",FieldVector<D," << dim << ">,"
+        << "R," << dimRange << ",FieldVector<R," << dimRange << ">,"
+        << "FieldMatrix<R," << dimRange << "," << dim << "> >;\n\n"
+        << "    //! \\brief Number of shape functions\n"
+        << "    static constexpr unsigned int size ()\n"
+        << "    {\n"
+        << "      return " << size << ";\n"
+        << "    }\n\n";
+
+    {
+      Impl::StraightLineCodeWriter writer(dim);
+      std::vector<std::string> values;
+      for (const auto& p : polynomials)
+        values.push_back(writer.horner(p));
+
+      out << "    //! \\brief Evaluate all shape functions\n"
+          << "    void evaluateFunction (const typename Traits::DomainType& x,\n"
+          << "                           std::vector<typename Traits::RangeType>& out) const\n"
+          << "    {\n"
+          << "      out.resize(size());\n";
+      writer.write(out, "      ");
+      for (std::size_t i = 0; i < size; ++i)
+        for (std::size_t r = 0; r < dimRange; ++r)
+          out << "      out[" << i << "][" << r << "] = " << values[i*dimRange+r] << ";\n";
+      out << "    }\n\n";
+    }
+
+    {
+      Impl::StraightLineCodeWriter writer(dim);
+      std::vector<std::string> values;
+      for (const auto& p : polynomials)
+        for (std::size_t j = 0; j < dim; ++j)
+          values.push_back(writer.horner(Impl::derivative(p, j)));
+
+      out << "    //! \\brief Evaluate Jacobian of all shape functions\n"
+          << "    void evaluateJacobian (const typename Traits::DomainType& x,\n"
+          << "                           std::vector<typename Traits::JacobianType>& out) const\n"
+          << "    {\n"
+          << "      out.resize(size());\n";
+      writer.write(out, "      ");
+      for (std::size_t i = 0; i < size; ++i)
+        for (std::size_t r = 0; r < dimRange; ++r)
+          for (std::size_t j = 0; j < dim; ++j)
+            out << "      out[" << i << "][" << r << "][" << j << "] = " << values[(i*dimRange+r)*dim+j] << ";\n";
+      out << "    }\n\n";
+    }
+
+    {
+      // All partial derivatives of positive order up to the maximal degree, all higher ones vanish
+      int degree = 0;
+      for (const auto& p : polynomials)
+        for (const auto& term : p)
+          degree = std::max(degree, std::accumulate(term.first.begin(), term.first.end(), 0));
+
+      out << "    //! \\brief Evaluate partial derivatives of any order of all shape functions\n"
+          << "    void partial (const std::array<unsigned int," << dim << ">& order,\n"
+          << "                  const typename Traits::DomainType& x,\n"
+          << "                  std::vector<typename Traits::RangeType>& out) const\n"
+          << "    {\n"
+          << "      out.resize(size());\n";
+
+      std::vector<int> order(dim, 0);
+      for (int totalOrder = 1; totalOrder <= degree; ++totalOrder)
+        Impl::forEachMultiIndex(order, 0, totalOrder, [&](const std::vector<int>& alpha) {
+          Impl::StraightLineCodeWriter writer(dim);
+          std::vector<std::string> values;
+          for (auto p : polynomials)
+          {
+            for (std::size_t j = 0; j < dim; ++j)
+              for (int l = 0; l < alpha[j]; ++l)
+                p = Impl::derivative(p, j);
+            values.push_back(writer.horner(p));
+          }
+
+          out << "      if (order == std::array<unsigned int," << dim << ">{";
+          for (std::size_t j = 0; j < dim; ++j)
+            out << (j > 0 ? ", " : "") << alpha[j];
+          out << "})\n"
+              << "      {\n";
+          writer.write(out, "        ");
+          for (std::size_t i = 0; i < size; ++i)
+            for (std::size_t r = 0; r < dimRange; ++r)
+              out << "        out[" << i << "][" << r << "] = " << values[i*dimRange+r] << ";\n";
+          out << "        return;\n"
+              << "      }\n";
+        });
+
+      out << "      if (order == std::array<unsigned int," << dim << ">{})\n"
+          << "        evaluateFunction(x, out);\n"
+          << "      else\n"
+          << "        for (auto& y : out)\n"
+          << "          y = 0;\n"
+          << "    }\n\n";
+    }
+
+    out << "    //! \\brief Polynomial order of the shape functions\n"
+        << "    unsigned int order () const\n"
+        << "    {\n"
+        << "      return " << basis.order() << ";\n"
+        << "    }\n"
+        << "  };\n\n"
+        << "} // namespace Dune\n";
+  }
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_BASISCODEGENERATOR_HH
@@ -0,0 +1,208 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_BATCHEDINTERPOLATION_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_BATCHEDINTERPOLATION_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/exceptions.hh>
+
+#include <dune/localfunctions/utility/lazycache.hh>
+
+namespace Dune
+{
+
+  /** \brief The interpolation of a local finite element as a set of evaluation points and a matrix
+   *
+   * All local interpolations evaluate the given function at a fixed set of
+   * points, e.g. the Lagrange nodes or the quadrature points on the facets
+   * and in the interior used for the moments of the Raviart-Thomas and
+   * Nedelec elements, and combine the values linearly. This class extracts
+   * these points and the matrix of the functionals once by probing the
+   * interpolation of the local finite element. The entry (i, q*m+c) of
+   * the matrix is the weight of the component c of the value at the point q
+   * in the coefficient i, where m is the dimension of the range. The weights
+   * include the normals and tangents of the moments.
+   *
+   * Hence the function can be evaluated at all points at once, e.g. by a
+   * vectorized implementation or by reusing the values at points shared by
+   * several elements, and the interpolation reduces to a sparse matrix-vector
+   * product by interpolate(). Points which are requested more than once by
+   * the interpolation are only contained once.
+   *
+   * \note The local interpolation must request the same points in the same
+   *       order for all functions, and must be linear. This holds for all
+   *       interpolations of this module.
+   *
+   * \tparam LocalFiniteElement Type of the local finite element
+   */
+  template<class LocalFiniteElement>
+  class BatchedLocalInterpolation
+  {
+    using LocalBasisTraits = typename LocalFiniteElement::Traits::LocalBasisType::Traits;
+    using R = typename LocalBasisTraits::RangeFieldType;
+    static constexpr int dimRange = LocalBasisTraits::dimRange;
+
+  public:
+    //! Type of the evaluation points
+    using DomainType = typename LocalBasisTraits::DomainType;
+
+    //! Type of the function values at the evaluation points
+    using RangeType = typename LocalBasisTraits::RangeType;
+
+    //! Type of the dense matrix of the functionals
+    using Matrix = DynamicMatrix<R>;
+
+    //! Extract the evaluation points and the functionals of the interpolation of a local finite element
+    explicit BatchedLocalInterpolation (const LocalFiniteElement& fe)
+    {
+      const auto& interpolation = fe.localInterpolation();
+      std::vector<R> coefficients;
+
+      // Record the requested points, the call n evaluates the function at points_[pointOfCall[n]]
+      std::vector<std::size_t> pointOfCall;
+      std::map<DomainType, std::size_t, LexicographicLess> pointIndex;
+      interpolation.interpolate([&](const DomainType& x) {
+        auto [it, inserted] = pointIndex.try_emplace(x, points_.size());
+        if (inserted)
+          points_.push_back(x);
+        pointOfCall.push_back(it->second);
+        return RangeType(0);
+      }, coefficients);
+
+      // Interpolate the functions which are a unit vector at one point and zero at all others
+      matrix_ = Matrix(fe.size(), points_.size()*dimRange, 0);
+      for (std::size_t q = 0; q < points_.size(); ++q)
+        for (int c = 0; c < dimRange; ++c)
+        {
+          std::size_t call = 0;
+          interpolation.interpolate([&](const DomainType& x) {
+            if (call >= pointOfCall.size() or points_[pointOfCall[call]] != x)
+              DUNE_THROW(NotImplemented, "BatchedLocalInterpolation requires an interpolation evaluating the same points for all functions");
+            RangeType y(0);
+            if (pointOfCall[call++] == q)
+              y[c] = 1;
+            return y;
+          }, coefficients);
+          for (std::size_t i = 0; i < fe.size(); ++i)
+            matrix_[i][q*dimRange+c] = coefficients[i];
+        }
+
+      // Compress the rows of the matrix
+      rowStart_.push_back(0);
+      for (std::size_t i = 0; i < matrix_.N(); ++i)
+      {
+        for (std::size_t j = 0; j < matrix_.M(); ++j)
+          if (matrix_[i][j] != R(0))
+          {
+            columns_.push_back(j);
+            weights_.push_back(matrix_[i][j]);
+          }
+        rowStart_.push_back(columns_.size());
+      }
+    }
+
+    //! Number of coefficients
+    std::size_t size () const
+    {
+      return matrix_.N();
+    }
+
+    //! The points at which the function has to be evaluated
+    const std::vector<DomainType>& points () const
+    {
+      return points_;
+    }
+
+    //! The dense matrix of the functionals mapping the components of the values at the points to the coefficients
+    const Matrix& matrix () const
+    {
+      return matrix_;
+    }
+
+    /** \brief Compute the coefficients from the values of a function at the points
+     *
+     * \param values The values of the function at points()
+     * \param[out] out The coefficients of the interpolation
+     */
+    template<class Values, class C>
+    void interpolate (const Values& values, std::vector<C>& out) const
+    {
+      assert(values.size() == points_.size());
+      out.resize(size());
+      for (std::size_t i = 0; i < size(); ++i)
+      {
+        C y = 0;
+        for (std::size_t n = rowStart_[i]; n < rowStart_[i+1]; ++n)
+          y += weights_[n] * values[columns_[n] / dimRange][columns_[n] % dimRange];
+        out[i] = y;
+      }
+    }
+
+  private:
+    struct LexicographicLess
+    {
+      bool operator() (const DomainType& a, const DomainType& b) const
+      {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+      }
+    };
+
+    std::vector<DomainType> points_;
+    Matrix matrix_;
+    std::vector<std::size_t> rowStart_;
+    std::vector<std::size_t> columns_;
+    std::vector<R> weights_;
+  };
+
+
+  /** \brief A cache storing the batched interpolations of the elements of a local finite element cache
+   *
+   * The points and functionals are extracted on first request for the local
+   * finite element returned by the underlying cache. get() is thread safe if
+   * the get() of the underlying cache is, see Impl::PointerKeyedLazyCache.
+   *
+   * \tparam LocalFiniteElementCache Type of the underlying cache of local finite elements
+   */
+  template<class LocalFiniteElementCache>
+  class BatchedLocalInterpolationCache
+  {
+  public:
+    //! Type of the local finite elements of the underlying cache
+    using FiniteElementType = typename LocalFiniteElementCache::FiniteElementType;
+
+    //! Type of the stored batched interpolations
+    using InterpolationType = BatchedLocalInterpolation<FiniteElementType>;
+
+    /** \brief Construct an empty cache
+     *
+     * \note This class stores the reference to the cache passed here, which
+     *       must outlive this object. The underlying cache must return
+     *       references to local finite elements that stay valid.
+     */
+    explicit BatchedLocalInterpolationCache (const LocalFiniteElementCache& localFiniteElementCache)
+      : localFiniteElementCache_(localFiniteElementCache)
+    {}
+
+    //! Get the batched interpolation of the local finite element for the given key data
+    template<class... Key>
+    const InterpolationType& get (const Key&... key) const
+    {
+      return data_.get(&localFiniteElementCache_.get(key...));
+    }
+
+  private:
+    const LocalFiniteElementCache& localFiniteElementCache_;
+    Impl::PointerKeyedLazyCache<const FiniteElementType*, InterpolationType> data_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_BATCHEDINTERPOLATION_HH
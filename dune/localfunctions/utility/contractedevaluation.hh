@@ -0,0 +1,387 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_CONTRACTEDEVALUATION_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_CONTRACTEDEVALUATION_HH
+
+/** \file
+    \brief Evaluation of a finite element function given by the coefficients of a local basis and the transposed operation
+ */
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/typeutilities.hh>
+
+namespace Dune
+{
+
+  namespace Impl
+  {
+
+    // Use the contraction of the local basis if it provides one
+    template<class LocalBasis, class Coefficients>
+    auto contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                           const typename LocalBasis::Traits::DomainType& x,
+                           typename LocalBasis::Traits::RangeType& y, PriorityTag<1>)
+      -> decltype(basis.contractFunction(x, coefficients, y))
+    {
+      basis.contractFunction(x, coefficients, y);
+    }
+
+    template<class LocalBasis, class Coefficients>
+    void contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                           const typename LocalBasis::Traits::DomainType& x,
+                           typename LocalBasis::Traits::RangeType& y, PriorityTag<0>)
+    {
+      std::vector<typename LocalBasis::Traits::RangeType> values;
+      basis.evaluateFunction(x, values);
+      y = 0;
+      for (std::size_t i = 0; i < values.size(); ++i)
+        y.axpy(coefficients[i], values[i]);
+    }
+
+    template<class LocalBasis, class Coefficients>
+    auto contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                           const typename LocalBasis::Traits::DomainType& x,
+                           typename LocalBasis::Traits::JacobianType& y, PriorityTag<1>)
+      -> decltype(basis.contractJacobian(x, coefficients, y))
+    {
+      basis.contractJacobian(x, coefficients, y);
+    }
+
+    template<class LocalBasis, class Coefficients>
+    void contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                           const typename LocalBasis::Traits::DomainType& x,
+                           typename LocalBasis::Traits::JacobianType& y, PriorityTag<0>)
+    {
+      std::vector<typename LocalBasis::Traits::JacobianType> jacobians;
+      basis.evaluateJacobian(x, jacobians);
+      y = 0;
+      for (std::size_t i = 0; i < jacobians.size(); ++i)
+        y.axpy(coefficients[i], jacobians[i]);
+    }
+
+    // Use the contraction at several points of the local basis if it provides one
+    template<class LocalBasis, class Coefficients>
+    auto contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                           const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                           std::vector<typename LocalBasis::Traits::RangeType>& out, PriorityTag<2>)
+      -> decltype(basis.contractFunction(points, coefficients, out))
+    {
+      basis.contractFunction(points, coefficients, out);
+    }
+
+    // Use the contraction at a single point of the local basis at each point
+    template<class LocalBasis, class Coefficients>
+    auto contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                           const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                           std::vector<typename LocalBasis::Traits::RangeType>& out, PriorityTag<1>)
+      -> decltype(basis.contractFunction(points[0], coefficients, out[0]))
+    {
+      out.resize(points.size());
+      for (std::size_t q = 0; q < points.size(); ++q)
+        basis.contractFunction(points[q], coefficients, out[q]);
+    }
+
+    template<class LocalBasis, class Coefficients>
+    void contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                           const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                           std::vector<typename LocalBasis::Traits::RangeType>& out, PriorityTag<0>)
+    {
+      std::vector<typename LocalBasis::Traits::RangeType> values;
+      out.resize(points.size());
+      for (std::size_t q = 0; q < points.size(); ++q)
+      {
+        basis.evaluateFunction(points[q], values);
+        out[q] = 0;
+        for (std::size_t i = 0; i < values.size(); ++i)
+          out[q].axpy(coefficients[i], values[i]);
+      }
+    }
+
+    template<class LocalBasis, class Coefficients>
+    auto contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                           const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                           std::vector<typename LocalBasis::Traits::JacobianType>& out, PriorityTag<2>)
+      -> decltype(basis.contractJacobian(points, coefficients, out))
+    {
+      basis.contractJacobian(points, coefficients, out);
+    }
+
+    // Use the contraction at a single point of the local basis at each point
+    template<class LocalBasis, class Coefficients>
+    auto contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                           const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                           std::vector<typename LocalBasis::Traits::JacobianType>& out, PriorityTag<1>)
+      -> decltype(basis.contractJacobian(points[0], coefficients, out[0]))
+    {
+      out.resize(points.size());
+      for (std::size_t q = 0; q < points.size(); ++q)
+        basis.contractJacobian(points[q], coefficients, out[q]);
+    }
+
+    template<class LocalBasis, class Coefficients>
+    void contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                           const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                           std::vector<typename LocalBasis::Traits::JacobianType>& out, PriorityTag<0>)
+    {
+      std::vector<typename LocalBasis::Traits::JacobianType> jacobians;
+      out.resize(points.size());
+      for (std::size_t q = 0; q < points.size(); ++q)
+      {
+        basis.evaluateJacobian(points[q], jacobians);
+        out[q] = 0;
+        for (std::size_t i = 0; i < jacobians.size(); ++i)
+          out[q].axpy(coefficients[i], jacobians[i]);
+      }
+    }
+
+    // Use the integration of the local basis if it provides one
+    template<class LocalBasis, class Weights, class Out>
+    auto integrateShapeFunctions (const LocalBasis& basis,
+                                  const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                                  const Weights& weights,
+                                  const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                  const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                  Out& out, PriorityTag<2>)
+      -> decltype(basis.integrateShapeFunctions(points, weights, values, fluxes, out))
+    {
+      basis.integrateShapeFunctions(points, weights, values, fluxes, out);
+    }
+
+    // Accumulate point by point if the local basis tests a value and a flux directly
+    template<class LocalBasis, class Weights, class Out>
+    auto integrateShapeFunctions (const LocalBasis& basis,
+                                  const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                                  const Weights& weights,
+                                  const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                  const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                  Out& out, PriorityTag<1>)
+      -> decltype(basis.addTransposedContraction(points[0], values[0], fluxes[0], out))
+    {
+      out.assign(basis.size(), 0);
+      for (std::size_t q = 0; q < points.size(); ++q)
+      {
+        typename LocalBasis::Traits::RangeType value(0);
+        typename LocalBasis::Traits::JacobianType flux(0);
+        if (not values.empty())
+          value.axpy(weights[q], values[q]);
+        if (not fluxes.empty())
+          flux.axpy(weights[q], fluxes[q]);
+        basis.addTransposedContraction(points[q], value, flux, out);
+      }
+    }
+
+    template<class LocalBasis, class Weights, class Out>
+    void integrateShapeFunctions (const LocalBasis& basis,
+                                  const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                                  const Weights& weights,
+                                  const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                  const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                  Out& out, PriorityTag<0>)
+    {
+      constexpr int dim = LocalBasis::Traits::dimDomain;
+      constexpr int dimRange = LocalBasis::Traits::dimRange;
+      std::vector<typename LocalBasis::Traits::RangeType> shapeValues;
+      std::vector<typename LocalBasis::Traits::JacobianType> jacobians;
+      out.assign(basis.size(), 0);
+      for (std::size_t q = 0; q < points.size(); ++q)
+      {
+        if (not values.empty())
+        {
+          basis.evaluateFunction(points[q], shapeValues);
+          for (std::size_t i = 0; i < basis.size(); ++i)
+            out[i] += weights[q] * (values[q] * shapeValues[i]);
+        }
+        if (not fluxes.empty())
+        {
+          basis.evaluateJacobian(points[q], jacobians);
+          for (std::size_t i = 0; i < basis.size(); ++i)
+            for (int r = 0; r < dimRange; ++r)
+              for (int j = 0; j < dim; ++j)
+                out[i] += weights[q] * fluxes[q][r][j] * jacobians[i][r][j];
+        }
+      }
+    }
+
+    // Use the sum factorization of the local basis if it provides one
+    template<class LocalBasis, class Weights, class Out>
+    auto integrateShapeFunctions (const LocalBasis& basis,
+                                  const std::array<std::vector<typename LocalBasis::Traits::DomainFieldType>,LocalBasis::Traits::dimDomain>& points,
+                                  const std::array<Weights,LocalBasis::Traits::dimDomain>& weights,
+                                  const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                  const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                  Out& out, PriorityTag<1>)
+      -> decltype(basis.integrateShapeFunctions(points, weights, values, fluxes, out))
+    {
+      basis.integrateShapeFunctions(points, weights, values, fluxes, out);
+    }
+
+    // Integrate over the tensor-product points one by one
+    template<class LocalBasis, class Weights, class Out>
+    void integrateShapeFunctions (const LocalBasis& basis,
+                                  const std::array<std::vector<typename LocalBasis::Traits::DomainFieldType>,LocalBasis::Traits::dimDomain>& points,
+                                  const std::array<Weights,LocalBasis::Traits::dimDomain>& weights,
+                                  const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                  const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                  Out& out, PriorityTag<0>)
+    {
+      constexpr int dim = LocalBasis::Traits::dimDomain;
+      std::size_t numPoints = 1;
+      for (int l = 0; l < dim; ++l)
+        numPoints *= points[l].size();
+
+      std::vector<typename LocalBasis::Traits::DomainType> tensorPoints(numPoints);
+      std::vector<typename LocalBasis::Traits::DomainFieldType> tensorWeights(numPoints, 1);
+      for (std::size_t q = 0; q < numPoints; ++q)
+      {
+        std::size_t m = q;
+        for (int l = 0; l < dim; ++l)
+        {
+          tensorPoints[q][l] = points[l][m % points[l].size()];
+          tensorWeights[q] *= weights[l][m % points[l].size()];
+          m /= points[l].size();
+        }
+      }
+      integrateShapeFunctions(basis, tensorPoints, tensorWeights, values, fluxes, out, PriorityTag<2>());
+    }
+
+  } // namespace Impl
+
+
+  /** \brief Evaluate the linear combination of the shape functions of a local basis with the given coefficients
+   *
+   * Local bases which provide a method contractFunction() combine the shape
+   * functions while evaluating them: the Lagrange basis on cubes by sum
+   * factorization, the Lagrange basis on simplices by accumulating the
+   * products of the barycentric polynomials and the PolynomialBasis by
+   * combining the rows of its coefficient matrix. All other bases are
+   * evaluated by evaluateFunction() first.
+   *
+   * \param basis The local basis
+   * \param coefficients The coefficients of all shape functions
+   * \param x The point where to evaluate the linear combination
+   * \param[out] y The value of the linear combination
+   */
+  template<class LocalBasis, class Coefficients>
+  void contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                         const typename LocalBasis::Traits::DomainType& x,
+                         typename LocalBasis::Traits::RangeType& y)
+  {
+    Impl::contractFunction(basis, coefficients, x, y, PriorityTag<1>());
+  }
+
+  /** \brief Evaluate the linear combination of the shape functions at several points
+   *
+   * \param basis The local basis
+   * \param coefficients The coefficients of all shape functions
+   * \param points The points where to evaluate the linear combination
+   * \param[out] out The values of the linear combination at the points
+   */
+  template<class LocalBasis, class Coefficients>
+  void contractFunction (const LocalBasis& basis, const Coefficients& coefficients,
+                         const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                         std::vector<typename LocalBasis::Traits::RangeType>& out)
+  {
+    Impl::contractFunction(basis, coefficients, points, out, PriorityTag<2>());
+  }
+
+  /** \brief Evaluate the Jacobian of the linear combination of the shape functions with the given coefficients
+   *
+   * See contractFunction() for the bases which provide an own implementation.
+   *
+   * \param basis The local basis
+   * \param coefficients The coefficients of all shape functions
+   * \param x The point where to evaluate the Jacobian
+   * \param[out] y The Jacobian of the linear combination
+   */
+  template<class LocalBasis, class Coefficients>
+  void contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                         const typename LocalBasis::Traits::DomainType& x,
+                         typename LocalBasis::Traits::JacobianType& y)
+  {
+    Impl::contractJacobian(basis, coefficients, x, y, PriorityTag<1>());
+  }
+
+  /** \brief Evaluate the Jacobian of the linear combination of the shape functions at several points
+   *
+   * \param basis The local basis
+   * \param coefficients The coefficients of all shape functions
+   * \param points The points where to evaluate the Jacobian
+   * \param[out] out The Jacobians of the linear combination at the points
+   */
+  template<class LocalBasis, class Coefficients>
+  void contractJacobian (const LocalBasis& basis, const Coefficients& coefficients,
+                         const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                         std::vector<typename LocalBasis::Traits::JacobianType>& out)
+  {
+    Impl::contractJacobian(basis, coefficients, points, out, PriorityTag<2>());
+  }
+
+  /** \brief Integrate all shape functions against values and fluxes given at quadrature points
+   *
+   * This computes \f$r_i = \sum_p w_p(q_p\cdot\phi_i(x_p) + F_p:\nabla\phi_i(x_p))\f$,
+   * the transposed operation of contractFunction() and contractJacobian().
+   * The Lagrange bases on cubes and simplices test the value and the flux at
+   * each point by a fused kernel, which computes the values and gradients of
+   * all shape functions in one traversal without storing them. For
+   * tensor-product rules on cubes the overload taking one-dimensional rules
+   * uses sum factorization. The
+   * PolynomialBasis tests against the underlying basis and applies its
+   * coefficient matrix once. All other bases are evaluated by
+   * evaluateFunction() and evaluateJacobian().
+   *
+   * \param basis The local basis
+   * \param points The quadrature points \f$x_p\f$
+   * \param weights The quadrature weights \f$w_p\f$
+   * \param values The values \f$q_p\f$ at the points, or an empty vector
+   * \param fluxes The fluxes \f$F_p\f$ at the points, or an empty vector
+   * \param[out] out The integrals \f$r_i\f$ of all shape functions
+   */
+  template<class LocalBasis, class Weights, class R>
+  void integrateShapeFunctions (const LocalBasis& basis,
+                                const std::vector<typename LocalBasis::Traits::DomainType>& points,
+                                const Weights& weights,
+                                const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                std::vector<R>& out)
+  {
+    Impl::integrateShapeFunctions(basis, points, weights, values, fluxes, out, PriorityTag<2>());
+  }
+
+  /** \brief Integrate all shape functions against values and fluxes given on a tensor-product quadrature rule
+   *
+   * The quadrature points are the tensor products of the one-dimensional
+   * points of all directions, numbered lexicographically with direction 0
+   * running fastest, and their weights are the products of the
+   * one-dimensional weights. The Lagrange basis on cubes contracts the
+   * weighted values and fluxes with the one-dimensional polynomials one
+   * direction after the other (sum factorization). All other bases are
+   * integrated point by point as by the overload taking the quadrature
+   * points.
+   *
+   * \param basis The local basis
+   * \param points The one-dimensional quadrature points of each direction
+   * \param weights The one-dimensional quadrature weights of each direction
+   * \param values The values \f$q_p\f$ at the tensor-product points, or an empty vector
+   * \param fluxes The fluxes \f$F_p\f$ at the tensor-product points, or an empty vector
+   * \param[out] out The integrals \f$r_i\f$ of all shape functions
+   */
+  template<class LocalBasis, class Weights, class R>
+  void integrateShapeFunctions (const LocalBasis& basis,
+                                const std::array<std::vector<typename LocalBasis::Traits::DomainFieldType>,LocalBasis::Traits::dimDomain>& points,
+                                const std::array<Weights,LocalBasis::Traits::dimDomain>& weights,
+                                const std::vector<typename LocalBasis::Traits::RangeType>& values,
+                                const std::vector<typename LocalBasis::Traits::JacobianType>& fluxes,
+                                std::vector<R>& out)
+  {
+    Impl::integrateShapeFunctions(basis, points, weights, values, fluxes, out, PriorityTag<1>());
+  }
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_CONTRACTEDEVALUATION_HH
@@ -0,0 +1,321 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_DERIVATIVETABLE_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_DERIVATIVETABLE_HH
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/alignedallocator.hh>
+#include <dune/common/typeutilities.hh>
+
+namespace Dune
+{
+
+  /** \brief Values or derivatives of all shape functions at a set of points in structure-of-arrays layout
+   *
+   * The table stores one contiguous array per component, e.g. per range
+   * component and direction of the Jacobians. Each array contains the
+   * entries of all shape functions at all points, either with the shape
+   * functions or with the points contiguous. The leading dimension is padded
+   * such that each array and each contiguous row starts at an address that is
+   * a multiple of #alignment bytes, hence the rows can be processed by
+   * aligned vector loads.
+   *
+   * The tables are filled by evaluateFunctionTable(), evaluateJacobianTable()
+   * and partialTable(), and integrateShapeFunctions() tests data at the points
+   * against the tabulated shape functions.
+   *
+   * \tparam R Type of the stored entries
+   */
+  template<class R>
+  class DerivativeTable
+  {
+  public:
+    //! The order of the entries within the array of a component
+    enum class Layout
+    {
+      //! The entries of all shape functions at a point are contiguous
+      functionsContiguous,
+      //! The entries of a shape function at all points are contiguous
+      pointsContiguous
+    };
+
+    //! Alignment in bytes of the arrays of the components and their rows
+    static constexpr std::size_t alignment = 64;
+
+    DerivativeTable () = default;
+
+    //! Construct a table of the given sizes
+    DerivativeTable (std::size_t components, std::size_t functions, std::size_t points,
+                     Layout layout = Layout::functionsContiguous)
+    {
+      resize(components, functions, points, layout);
+    }
+
+    //! Change the sizes of the table, the entries are left unspecified
+    void resize (std::size_t components, std::size_t functions, std::size_t points,
+                 Layout layout = Layout::functionsContiguous)
+    {
+      components_ = components;
+      functions_ = functions;
+      points_ = points;
+      layout_ = layout;
+      const std::size_t rowLength = (layout == Layout::functionsContiguous) ? functions : points;
+      const std::size_t rows = (layout == Layout::functionsContiguous) ? points : functions;
+      leadingDimension_ = (rowLength + padding - 1) / padding * padding;
+      data_.resize(components * rows * leadingDimension_);
+    }
+
+    //! Number of components
+    std::size_t components () const
+    {
+      return components_;
+    }
+
+    //! Number of shape functions
+    std::size_t functions () const
+    {
+      return functions_;
+    }
+
+    //! Number of points
+    std::size_t points () const
+    {
+      return points_;
+    }
+
+    //! The order of the entries within the arrays
+    Layout layout () const
+    {
+      return layout_;
+    }
+
+    //! Distance between the starts of two consecutive rows of an array
+    std::size_t leadingDimension () const
+    {
+      return leadingDimension_;
+    }
+
+    //! Distance between the entries of two consecutive shape functions at a point
+    std::size_t functionStride () const
+    {
+      return (layout_ == Layout::functionsContiguous) ? 1 : leadingDimension_;
+    }
+
+    //! Distance between the entries of a shape function at two consecutive points
+    std::size_t pointStride () const
+    {
+      return (layout_ == Layout::functionsContiguous) ? leadingDimension_ : 1;
+    }
+
+    //! The array of the component c
+    R* data (std::size_t c)
+    {
+      assert(c < components_);
+      return data_.data() + c * blockSize();
+    }
+
+    //! The array of the component c
+    const R* data (std::size_t c) const
+    {
+      assert(c < components_);
+      return data_.data() + c * blockSize();
+    }
+
+    //! The entry of the component c of the shape function i at the point p
+    R& operator() (std::size_t c, std::size_t i, std::size_t p)
+    {
+      assert(i < functions_ && p < points_);
+      return data(c)[i*functionStride() + p*pointStride()];
+    }
+
+    //! The entry of the component c of the shape function i at the point p
+    const R& operator() (std::size_t c, std::size_t i, std::size_t p) const
+    {
+      assert(i < functions_ && p < points_);
+      return data(c)[i*functionStride() + p*pointStride()];
+    }
+
+  private:
+    // Pad the rows to a multiple of this number of entries
+    static constexpr std::size_t padding = (sizeof(R) <= alignment and alignment % sizeof(R) == 0)
+      ? alignment / sizeof(R) : alignment;
+
+    std::size_t blockSize () const
+    {
+      return data_.size() / (components_ > 0 ? components_ : 1);
+    }
+
+    std::size_t components_ = 0;
+    std::size_t functions_ = 0;
+    std::size_t points_ = 0;
+    std::size_t leadingDimension_ = 0;
+    Layout layout_ = Layout::functionsContiguous;
+    std::vector<R, AlignedAllocator<R, (alignment < alignof(R)) ? alignof(R) : alignment> > data_;
+  };
+
+
+  namespace Impl
+  {
+
+    // Use the native evaluation into one array per direction if the basis provides it
+    template<class LocalBasis, class Points, class R>
+    auto evaluateJacobianTable (const LocalBasis& basis, const Points& points, DerivativeTable<R>& table, PriorityTag<1>)
+      -> decltype(basis.evaluateJacobianSoA(points[0], std::declval<std::array<R*,LocalBasis::Traits::dimDomain> >(), std::size_t()))
+    {
+      constexpr int dim = LocalBasis::Traits::dimDomain;
+      std::array<R*,dim> out;
+      for (std::size_t p = 0; p < points.size(); ++p)
+      {
+        for (int j = 0; j < dim; ++j)
+          out[j] = table.data(j) + p*table.pointStride();
+        basis.evaluateJacobianSoA(points[p], out, table.functionStride());
+      }
+    }
+
+    template<class LocalBasis, class Points, class R>
+    void evaluateJacobianTable (const LocalBasis& basis, const Points& points, DerivativeTable<R>& table, PriorityTag<0>)
+    {
+      constexpr int dim = LocalBasis::Traits::dimDomain;
+      constexpr int dimRange = LocalBasis::Traits::dimRange;
+      std::vector<typename LocalBasis::Traits::JacobianType> jacobians;
+      for (std::size_t p = 0; p < points.size(); ++p)
+      {
+        basis.evaluateJacobian(points[p], jacobians);
+        for (std::size_t i = 0; i < jacobians.size(); ++i)
+          for (int r = 0; r < dimRange; ++r)
+            for (int j = 0; j < dim; ++j)
+              table(r*dim+j, i, p) = jacobians[i][r][j];
+      }
+    }
+
+  } // namespace Impl
+
+
+  /** \brief Evaluate all shape functions at a set of points into a table
+   *
+   * The component r of the table contains the component r of the values.
+   *
+   * \param basis The local basis
+   * \param points The points, e.g. a std::vector of the domain type of the basis
+   * \param[out] table The table of the values
+   * \param layout The order of the entries within the arrays of the table
+   */
+  template<class LocalBasis, class Points, class R>
+  void evaluateFunctionTable (const LocalBasis& basis, const Points& points, DerivativeTable<R>& table,
+                              typename DerivativeTable<R>::Layout layout = DerivativeTable<R>::Layout::functionsContiguous)
+  {
+    constexpr int dimRange = LocalBasis::Traits::dimRange;
+    table.resize(dimRange, basis.size(), points.size(), layout);
+    std::vector<typename LocalBasis::Traits::RangeType> values;
+    for (std::size_t p = 0; p < points.size(); ++p)
+    {
+      basis.evaluateFunction(points[p], values);
+      for (std::size_t i = 0; i < values.size(); ++i)
+        for (int r = 0; r < dimRange; ++r)
+          table(r, i, p) = values[i][r];
+    }
+  }
+
+  /** \brief Evaluate the Jacobians of all shape functions at a set of points into a table
+   *
+   * The component r*dim+j of the table contains the derivatives of the
+   * component r in direction j. Local bases which provide a method
+   * evaluateJacobianSoA(), like the Lagrange bases on simplices and cubes,
+   * write their derivatives directly into the table, all other bases are
+   * evaluated by evaluateJacobian().
+   *
+   * \param basis The local basis
+   * \param points The points, e.g. a std::vector of the domain type of the basis
+   * \param[out] table The table of the Jacobians
+   * \param layout The order of the entries within the arrays of the table
+   */
+  template<class LocalBasis, class Points, class R>
+  void evaluateJacobianTable (const LocalBasis& basis, const Points& points, DerivativeTable<R>& table,
+                              typename DerivativeTable<R>::Layout layout = DerivativeTable<R>::Layout::functionsContiguous)
+  {
+    constexpr int dim = LocalBasis::Traits::dimDomain;
+    constexpr int dimRange = LocalBasis::Traits::dimRange;
+    table.resize(dimRange*dim, basis.size(), points.size(), layout);
+    Impl::evaluateJacobianTable(basis, points, table, PriorityTag<1>());
+  }
+
+  /** \brief Evaluate a partial derivative of all shape functions at a set of points into a table
+   *
+   * The component r of the table contains the derivatives of the component r.
+   *
+   * \param basis The local basis
+   * \param order The order of the partial derivative in each direction
+   * \param points The points, e.g. a std::vector of the domain type of the basis
+   * \param[out] table The table of the partial derivatives
+   * \param layout The order of the entries within the arrays of the table
+   */
+  template<class LocalBasis, class Points, class R>
+  void partialTable (const LocalBasis& basis, const std::array<unsigned int,LocalBasis::Traits::dimDomain>& order,
+                     const Points& points, DerivativeTable<R>& table,
+                     typename DerivativeTable<R>::Layout layout = DerivativeTable<R>::Layout::functionsContiguous)
+  {
+    constexpr int dimRange = LocalBasis::Traits::dimRange;
+    table.resize(dimRange, basis.size(), points.size(), layout);
+    std::vector<typename LocalBasis::Traits::RangeType> values;
+    for (std::size_t p = 0; p < points.size(); ++p)
+    {
+      basis.partial(order, points[p], values);
+      for (std::size_t i = 0; i < values.size(); ++i)
+        for (int r = 0; r < dimRange; ++r)
+          table(r, i, p) = values[i][r];
+    }
+  }
+
+  /** \brief Integrate all shape functions against values and fluxes using tables of their values and Jacobians
+   *
+   * This computes \f$r_i = \sum_p w_p(q_p\cdot\phi_i(x_p) + F_p:\nabla\phi_i(x_p))\f$
+   * from tables filled by evaluateFunctionTable() and evaluateJacobianTable()
+   * at the points \f$x_p\f$.
+   *
+   * \param valueTable The values of the shape functions, not used if values is empty
+   * \param jacobianTable The Jacobians of the shape functions, not used if fluxes is empty
+   * \param weights The quadrature weights \f$w_p\f$
+   * \param values The values \f$q_p\f$ at the points, or an empty vector
+   * \param fluxes The fluxes \f$F_p\f$ at the points, or an empty vector
+   * \param[out] out The integrals \f$r_i\f$ of all shape functions
+   */
+  template<class R, class Weights, class Range, class Jacobian>
+  void integrateShapeFunctions (const DerivativeTable<R>& valueTable, const DerivativeTable<R>& jacobianTable,
+                                const Weights& weights, const std::vector<Range>& values,
+                                const std::vector<Jacobian>& fluxes, std::vector<R>& out)
+  {
+    constexpr int dimRange = Jacobian::rows;
+    constexpr int dim = Jacobian::cols;
+    const std::size_t functions = values.empty() ? jacobianTable.functions() : valueTable.functions();
+    out.assign(functions, 0);
+
+    for (std::size_t p = 0; p < values.size(); ++p)
+      for (int r = 0; r < dimRange; ++r)
+      {
+        const R value = weights[p] * values[p][r];
+        const R* row = valueTable.data(r) + p*valueTable.pointStride();
+        for (std::size_t i = 0; i < functions; ++i)
+          out[i] += value * row[i*valueTable.functionStride()];
+      }
+
+    for (std::size_t p = 0; p < fluxes.size(); ++p)
+      for (int r = 0; r < dimRange; ++r)
+        for (int j = 0; j < dim; ++j)
+        {
+          const R flux = weights[p] * fluxes[p][r][j];
+          const R* row = jacobianTable.data(r*dim+j) + p*jacobianTable.pointStride();
+          for (std::size_t i = 0; i < functions; ++i)
+            out[i] += flux * row[i*jacobianTable.functionStride()];
+        }
+  }
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_DERIVATIVETABLE_HH
@@ -9,6 +9,7 @@
 #include <dune/common/gmpfield.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
+#include <dune/common/quadmath.hh>
 
 namespace Dune
 {
@@ -104,6 +105,22 @@ namespace Dune
   };
 #endif
 
+#if HAVE_QUADMATH
+  template<>
+  struct Zero< Float128 >
+  {
+    typedef Float128 Field;
+    operator Field () const
+    {
+      return Field( 0 );
+    }
+    static const Field epsilon()
+    {
+      return Field(1e-24);
+    }
+  };
+#endif
+
   template< class Field >
   inline bool operator == ( const Zero< Field > &, const Field &f )
   {
@@ -176,6 +193,23 @@ namespace Dune
   }
 #endif
 
+#if HAVE_QUADMATH
+  inline void field_cast ( const Dune::Float128 &f1, float &f2 )
+  {
+    f2 = float( f1 );
+  }
+
+  inline void field_cast ( const Dune::Float128 &f1, double &f2 )
+  {
+    f2 = double( f1 );
+  }
+
+  inline void field_cast ( const Dune::Float128 &f1, long double &f2 )
+  {
+    f2 = (long double)( f1 );
+  }
+#endif
+
   template< class F2, class F1, int dim >
   inline void field_cast ( const Dune::FieldVector< F1, dim > &f1, Dune::FieldVector< F2, dim > &f2 )
   {
@@ -297,6 +331,17 @@ DUNE_NO_DEPRECATED_END
   // ComputeField
   // ------------
 
+  /**
+   * @brief the recommended field for the construction of generic
+   *        finite elements with a given storage field
+   *
+   * For GMPField the precision is increased by sum bits, all other
+   * fields are used as they are. The matrices inverted during the
+   * construction of the generic finite elements are ill-conditioned
+   * for higher orders. For double as storage field, the quadruple
+   * precision type Float128 can be passed explicitly as compute field
+   * CF of these elements.
+   **/
   template <class Field,unsigned int sum>
   struct ComputeField
   {
@@ -68,6 +68,39 @@ namespace Dune
       }
     }
 
+    /** \brief Interpolate several functions at once, given by a function returning a vector of their values
+     *
+     *  The basis is evaluated once per quadrature point for all functions. The
+     *  column j of the coefficient matrix contains the coefficients of the function j.
+     */
+    template< class Function, class DofField >
+    void interpolateFields ( const Function &function, DynamicMatrix< DofField > &coefficients ) const
+    {
+      typedef FieldVector< DofField, Basis::dimRange > RangeVector;
+
+      const unsigned int size = basis().size();
+      std::vector< RangeVector > basisValues( size );
+
+      bool first = true;
+      for (auto&& qp : quadrature())
+      {
+        basis().evaluate( qp.position(), basisValues );
+        const auto &values = function( qp.position() );
+        if( first )
+        {
+          coefficients.resize( size, values.size(), Zero< DofField >() );
+          first = false;
+        }
+        for( std::size_t j = 0; j < values.size(); ++j )
+        {
+          RangeVector factor = field_cast< DofField >( values[ j ] );
+          factor *= field_cast< DofField >( qp.weight() );
+          for( unsigned int i = 0; i < size; ++i )
+            coefficients[ i ][ j ] += factor * basisValues[ i ];
+        }
+      }
+    }
+
     const Basis &basis () const
     {
       return basis_;
@@ -126,6 +159,28 @@ namespace Dune
         }
       }
     }
+
+    /** \brief Interpolate several functions at once, given by a function returning a vector of their values
+     *
+     *  The moments of all functions are computed by the base class and multiplied
+     *  by the inverse mass matrix. The column j of the coefficient matrix contains
+     *  the coefficients of the function j.
+     */
+    template< class Function, class DofField >
+    void interpolateFields ( const Function &function, DynamicMatrix< DofField > &coefficients ) const
+    {
+      DynamicMatrix< DofField > moments;
+      Base::interpolateFields( function, moments );
+      coefficients.resize( moments.N(), moments.M(), Zero< DofField >() );
+      for (unsigned int i=0; i<moments.N(); ++i)
+        for (unsigned int k=0; k<moments.N(); ++k)
+        {
+          const DofField weight = field_cast<DofField>(massMatrix_[i][k]);
+          for (unsigned int j=0; j<moments.M(); ++j)
+            coefficients[i][j] += weight*moments[k][j];
+        }
+    }
+
   private:
     LocalL2Interpolation ( const typename Base::Basis &basis, const typename Base::Quadrature &quadrature )
       : Base(basis,quadrature),
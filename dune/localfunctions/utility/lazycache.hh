@@ -0,0 +1,71 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_LAZYCACHE_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_LAZYCACHE_HH
+
+#include <map>
+#include <mutex>
+
+namespace Dune
+{
+
+  namespace Impl
+  {
+
+    //! Factory constructing a value from the object a pointer key points to
+    template<class Value>
+    struct ConstructFromPointee
+    {
+      template<class T>
+      Value operator() (const T* key) const
+      {
+        return Value(*key);
+      }
+    };
+
+    /** \brief A map from pointers, e.g. to cached local finite elements, to values created on first request
+     *
+     * The value for a key is created by calling the factory with the key the
+     * first time get() is called for it. The references returned by get()
+     * stay valid for the lifetime of the cache.
+     *
+     * get() is thread safe: each value is created at most once, also if it
+     * is requested concurrently by several threads. The creation of values
+     * is serialized by a mutex, which is also locked when looking up values
+     * that already exist.
+     *
+     * \tparam Key     Type of the keys, a pointer or a pair of pointers
+     * \tparam Value   Type of the stored values
+     * \tparam Factory Type of the function object creating a value from a key
+     */
+    template<class Key, class Value, class Factory = ConstructFromPointee<Value>>
+    class PointerKeyedLazyCache
+    {
+    public:
+      explicit PointerKeyedLazyCache (const Factory& factory = Factory())
+        : factory_(factory)
+      {}
+
+      //! Get the value for the given key, creating it on first request
+      const Value& get (const Key& key) const
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = data_.find(key);
+        if (it == data_.end())
+          it = data_.emplace(key, factory_(key)).first;
+        return it->second;
+      }
+
+    private:
+      Factory factory_;
+      mutable std::mutex mutex_;
+      mutable std::map<Key, Value> data_;
+    };
+
+  } // namespace Impl
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_LAZYCACHE_HH
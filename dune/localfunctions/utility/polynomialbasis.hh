@@ -5,8 +5,10 @@
 #ifndef DUNE_POLYNOMIALBASIS_HH
 #define DUNE_POLYNOMIALBASIS_HH
 
+#include <cstddef>
 #include <fstream>
 #include <numeric>
+#include <vector>
 
 #include <dune/common/fmatrix.hh>
 
@@ -176,6 +178,142 @@ namespace Dune
       }
     }
 
+    /** \brief Evaluate a linear combination of the shape functions at several points
+     *
+     * The coefficients are contracted with the coefficient matrix once, then the
+     * underlying basis is combined directly at each point, without evaluating the
+     * shape functions.
+     *
+     * \param points The points where to evaluate the linear combination
+     * \param coefficients The coefficients of all shape functions
+     * \param[out] out The values of the linear combination at the points
+     */
+    template< class Coefficients >
+    void contractFunction ( const std::vector<typename Traits::DomainType>& points,
+                            const Coefficients& coefficients,
+                            std::vector<typename Traits::RangeType>& out ) const
+    {
+      SparseCoeffMatrix<StorageField,CoefficientMatrix::blockSize> combination;
+      combination.fill( combinedRows( coefficients ) );
+      out.resize( points.size() );
+      std::vector<typename Traits::RangeType> y( 1 );
+      for( std::size_t q = 0; q < points.size(); ++q )
+      {
+        combination.mult( eval_.template evaluate<0>( Convert<true,typename Traits::DomainType>::apply( points[q] ) ), y );
+        out[q] = y[0];
+      }
+    }
+
+    /** \brief Evaluate the Jacobian of a linear combination of the shape functions at several points
+     *
+     * \param points The points where to evaluate the Jacobian
+     * \param coefficients The coefficients of all shape functions
+     * \param[out] out The Jacobians of the linear combination at the points
+     */
+    template< class Coefficients >
+    void contractJacobian ( const std::vector<typename Traits::DomainType>& points,
+                            const Coefficients& coefficients,
+                            std::vector<typename Traits::JacobianType>& out ) const
+    {
+      SparseCoeffMatrix<StorageField,CoefficientMatrix::blockSize> combination;
+      combination.fill( combinedRows( coefficients ) );
+      out.resize( points.size() );
+      std::vector<FieldVector<R,dimRange*dimension> > y( 1 );
+      for( std::size_t q = 0; q < points.size(); ++q )
+      {
+        combination.template mult<1>( eval_.template evaluate<1>( Convert<true,typename Traits::DomainType>::apply( points[q] ) ), y );
+        for( unsigned int r = 0; r < dimRange; ++r )
+          for( unsigned int d = 0; d < dimension; ++d )
+            out[q][r][d] = y[0][r*dimension+d];
+      }
+    }
+
+    /** \brief Integrate the shape functions against values and fluxes given at quadrature points
+     *
+     * The values and fluxes are first tested against the underlying basis at all points,
+     * then the coefficient matrix is applied once, without evaluating the shape functions.
+     *
+     * \param points The quadrature points
+     * \param weights The quadrature weights
+     * \param values The values q at the points, or an empty vector
+     * \param fluxes The fluxes F at the points, or an empty vector
+     * \param[out] out The entry i is \f$\sum_p w_p(q_p\cdot\phi_i(x_p) + F_p:\nabla\phi_i(x_p))\f$
+     */
+    template< class Weights, class Out >
+    void integrateShapeFunctions ( const std::vector<typename Traits::DomainType>& points,
+                                   const Weights& weights,
+                                   const std::vector<typename Traits::RangeType>& values,
+                                   const std::vector<typename Traits::JacobianType>& fluxes,
+                                   Out& out ) const
+    {
+      static_assert( Evaluator::dimRange == 1, "integrateShapeFunctions requires a scalar underlying basis" );
+      typedef typename Evaluator::Field EvaluatorField;
+      const unsigned int blockSize = CoefficientMatrix::blockSize;
+
+      // moments[r][m] is the integral of the component r against the function m of the underlying basis
+      std::vector<std::vector<EvaluatorField> > moments( blockSize, std::vector<EvaluatorField>( coeffMatrix_->baseSize(), EvaluatorField( 0 ) ) );
+      for( std::size_t q = 0; q < points.size(); ++q )
+      {
+        auto it = eval_.template evaluate<1>( Convert<true,typename Traits::DomainType>::apply( points[q] ) );
+        for( unsigned int m = 0; m < coeffMatrix_->baseSize(); ++m, ++it )
+        {
+          // The block contains the value and the first derivatives of the function m
+          const auto &block = it->block();
+          for( unsigned int r = 0; r < blockSize; ++r )
+          {
+            R integrand = 0;
+            if( !values.empty() )
+              integrand += values[ q ][ r ] * field_cast<R>( block[ 0 ] );
+            if( !fluxes.empty() )
+              for( unsigned int d = 0; d < dimension; ++d )
+                integrand += fluxes[ q ][ r ][ d ] * field_cast<R>( block[ 1+d ] );
+            moments[ r ][ m ] += field_cast<EvaluatorField>( weights[ q ] * integrand );
+          }
+        }
+      }
+
+      out.resize( size() );
+      for( unsigned int i = 0; i < size(); ++i )
+        out[ i ] = 0;
+      std::vector<typename Traits::RangeType> y( size() );
+      for( unsigned int r = 0; r < blockSize; ++r )
+      {
+        coeffMatrix_->mult( typename Evaluator::template Iterator<0>::All( moments[ r ] ), y );
+        for( unsigned int i = 0; i < size(); ++i )
+          out[ i ] += y[ i ][ r ];
+      }
+    }
+
+    /** \brief Evaluate a linear combination of the shape functions
+     *
+     * At a single point contracting the coefficients with the coefficient matrix
+     * does not pay off, the shape functions are evaluated and combined directly.
+     */
+    template< class Coefficients >
+    void contractFunction ( const typename Traits::DomainType& x,
+                            const Coefficients& coefficients,
+                            typename Traits::RangeType& y ) const
+    {
+      std::vector<typename Traits::RangeType> values( size() );
+      evaluate( x, values );
+      y = 0;
+      for( unsigned int i = 0; i < size(); ++i )
+        y.axpy( coefficients[ i ], values[ i ] );
+    }
+
+    //! \brief Evaluate the Jacobian of a linear combination of the shape functions, see contractFunction()
+    template< class Coefficients >
+    void contractJacobian ( const typename Traits::DomainType& x,
+                            const Coefficients& coefficients,
+                            typename Traits::JacobianType& y ) const
+    {
+      std::vector<typename Traits::JacobianType> jacobians( size() );
+      jacobian( x, jacobians );
+      y = 0;
+      for( unsigned int i = 0; i < size(); ++i )
+        y.axpy( coefficients[ i ], jacobians[ i ] );
+    }
+
     template< unsigned int deriv, class F >
     void evaluate ( const DomainVector &x, F *values ) const
     {
@@ -319,6 +457,32 @@ namespace Dune
     }
 
   protected:
+    // The rows of the coefficient matrix combined with the given coefficients, one row per block component
+    struct CombinedRows
+    {
+      unsigned int rows () const { return data.size(); }
+      unsigned int cols () const { return data[0].size(); }
+      template< class Row >
+      void row ( unsigned int r, Row &row ) const
+      {
+        for( unsigned int c = 0; c < cols(); ++c )
+          row[ c ] = data[ r ][ c ];
+      }
+      std::vector<std::vector<StorageField> > data;
+    };
+
+    template< class Coefficients >
+    CombinedRows combinedRows ( const Coefficients& coefficients ) const
+    {
+      const unsigned int blockSize = CoefficientMatrix::blockSize;
+      CombinedRows combined;
+      combined.data.assign( blockSize, std::vector<StorageField>( coeffMatrix_->baseSize(), StorageField( 0 ) ) );
+      for( unsigned int i = 0; i < size(); ++i )
+        for( unsigned int r = 0; r < blockSize; ++r )
+          coeffMatrix_->addRow( i*blockSize+r, field_cast<StorageField>( coefficients[ i ] ), combined.data[ r ] );
+      return combined;
+    }
+
     PolynomialBasis(const PolynomialBasis &other)
       : basis_(other.basis_),
         coeffMatrix_(other.coeffMatrix_),
@@ -0,0 +1,233 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_REFERENCEELEMENTMATRICES_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_REFERENCEELEMENTMATRICES_HH
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/utility/lazycache.hh>
+
+namespace Dune
+{
+
+  /** \brief Element matrices of a local finite element on its reference element
+   *
+   * The matrices are computed once by quadrature in the constructor:
+   * - the mass matrix \f$M_{ij} = \int\hat\phi_i\cdot\hat\phi_j\,d\hat x\f$,
+   * - the matrices \f$S^{kl}_{ij} = \int\partial_k\hat\phi_i\cdot\partial_l\hat\phi_j\,d\hat x\f$
+   *   for all pairs of directions,
+   * - the advection matrices \f$A^k_{ij} = \int\hat\phi_i\cdot\partial_k\hat\phi_j\,d\hat x\f$
+   *   for all directions and
+   * - the facet mass matrices \f$F^f_{ij} = \int_{\hat f}\hat\phi_i\cdot\hat\phi_j\,d\hat s\f$
+   *   for all facets.
+   *
+   * The dot denotes the product of the range vectors. The quadrature order is
+   * twice the order of the local basis, hence the matrices are exact for
+   * polynomial shape functions.
+   *
+   * For an affine geometry with Jacobian inverse transposed B and integration
+   * element \f$\mu\f$ the element matrices of scalar shape functions are
+   * combinations of these matrices, e.g. the element stiffness matrix is
+   * \f$\mu\sum_{k,l}(B^TB)_{kl}S^{kl}\f$, see affineMass() and affineStiffness().
+   *
+   * \tparam LocalFiniteElement Type of the local finite element
+   */
+  template<class LocalFiniteElement>
+  class ReferenceElementMatrices
+  {
+    using LocalBasis = typename LocalFiniteElement::Traits::LocalBasisType;
+    using DomainField = typename LocalBasis::Traits::DomainFieldType;
+    using RangeField = typename LocalBasis::Traits::RangeFieldType;
+    static constexpr int dim = LocalBasis::Traits::dimDomain;
+    static constexpr int dimRange = LocalBasis::Traits::dimRange;
+
+  public:
+    //! Type of the stored matrices
+    using Matrix = DynamicMatrix<RangeField>;
+
+    //! Compute all reference element matrices of a local finite element
+    explicit ReferenceElementMatrices (const LocalFiniteElement& localFiniteElement)
+    {
+      const auto& localBasis = localFiniteElement.localBasis();
+      const std::size_t n = localBasis.size();
+      const GeometryType type = localFiniteElement.type();
+      const int quadOrder = 2*localBasis.order();
+
+      mass_ = Matrix(n, n, 0);
+      stiffness_.assign(dim*dim, Matrix(n, n, 0));
+      advection_.assign(dim, Matrix(n, n, 0));
+
+      std::vector<typename LocalBasis::Traits::RangeType> values;
+      std::vector<typename LocalBasis::Traits::JacobianType> jacobians;
+      for (const auto& qp : QuadratureRules<DomainField,dim>::rule(type, quadOrder))
+      {
+        localBasis.evaluateFunction(qp.position(), values);
+        localBasis.evaluateJacobian(qp.position(), jacobians);
+        for (std::size_t i = 0; i < n; ++i)
+          for (std::size_t j = 0; j < n; ++j)
+          {
+            for (int c = 0; c < dimRange; ++c)
+              mass_[i][j] += qp.weight() * values[i][c] * values[j][c];
+            for (int k = 0; k < dim; ++k)
+            {
+              for (int c = 0; c < dimRange; ++c)
+                advection_[k][i][j] += qp.weight() * values[i][c] * jacobians[j][c][k];
+              for (int l = 0; l < dim; ++l)
+                for (int c = 0; c < dimRange; ++c)
+                  stiffness_[k*dim+l][i][j] += qp.weight() * jacobians[i][c][k] * jacobians[j][c][l];
+            }
+          }
+      }
+
+      const auto& refElement = ReferenceElements<DomainField,dim>::general(type);
+      facetMass_.assign(refElement.size(1), Matrix(n, n, 0));
+      for (int f = 0; f < refElement.size(1); ++f)
+      {
+        const auto facetGeometry = refElement.template geometry<1>(f);
+        for (const auto& qp : QuadratureRules<DomainField,dim-1>::rule(refElement.type(f,1), quadOrder))
+        {
+          const DomainField weight = qp.weight() * facetGeometry.integrationElement(qp.position());
+          localBasis.evaluateFunction(facetGeometry.global(qp.position()), values);
+          for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+              for (int c = 0; c < dimRange; ++c)
+                facetMass_[f][i][j] += weight * values[i][c] * values[j][c];
+        }
+      }
+    }
+
+    //! Number of shape functions
+    std::size_t size () const
+    {
+      return mass_.N();
+    }
+
+    //! The mass matrix \f$M_{ij} = \int\hat\phi_i\cdot\hat\phi_j\,d\hat x\f$
+    const Matrix& mass () const
+    {
+      return mass_;
+    }
+
+    //! The matrix \f$S^{kl}_{ij} = \int\partial_k\hat\phi_i\cdot\partial_l\hat\phi_j\,d\hat x\f$
+    const Matrix& stiffness (int k, int l) const
+    {
+      assert(0 <= k && k < dim && 0 <= l && l < dim);
+      return stiffness_[k*dim+l];
+    }
+
+    //! The advection matrix \f$A^k_{ij} = \int\hat\phi_i\cdot\partial_k\hat\phi_j\,d\hat x\f$
+    const Matrix& advection (int k) const
+    {
+      assert(0 <= k && k < dim);
+      return advection_[k];
+    }
+
+    //! The mass matrix \f$F^f_{ij} = \int_{\hat f}\hat\phi_i\cdot\hat\phi_j\,d\hat s\f$ of the facet f
+    const Matrix& facetMass (int f) const
+    {
+      assert(0 <= f && std::size_t(f) < facetMass_.size());
+      return facetMass_[f];
+    }
+
+    /** \brief The mass matrix on an affine element
+     *
+     * \param geometry An affine geometry of the element
+     * \param[out] matrix The scaled reference mass matrix
+     */
+    template<class Geometry>
+    void affineMass (const Geometry& geometry, Matrix& matrix) const
+    {
+      assert(geometry.affine());
+      matrix = mass_;
+      matrix *= geometry.integrationElement(FieldVector<DomainField,dim>(0));
+    }
+
+    /** \brief The stiffness matrix \f$\int\nabla\phi_i\cdot\nabla\phi_j\,dx\f$ on an affine element
+     *
+     * \param geometry An affine geometry of the element
+     * \param[out] matrix The sum of the reference matrices weighted by the geometry
+     */
+    template<class Geometry>
+    void affineStiffness (const Geometry& geometry, Matrix& matrix) const
+    {
+      assert(geometry.affine());
+      const FieldVector<DomainField,dim> origin(0);
+      const FieldMatrix<DomainField,Geometry::coorddimension,dim> jacobianInverseTransposed
+        = geometry.jacobianInverseTransposed(origin);
+      const DomainField integrationElement = geometry.integrationElement(origin);
+
+      matrix = Matrix(size(), size(), 0);
+      for (int k = 0; k < dim; ++k)
+        for (int l = 0; l < dim; ++l)
+        {
+          DomainField weight = 0;
+          for (int r = 0; r < Geometry::coorddimension; ++r)
+            weight += jacobianInverseTransposed[r][k] * jacobianInverseTransposed[r][l];
+          matrix.axpy(weight * integrationElement, stiffness_[k*dim+l]);
+        }
+    }
+
+  private:
+    Matrix mass_;
+    std::vector<Matrix> stiffness_;
+    std::vector<Matrix> advection_;
+    std::vector<Matrix> facetMass_;
+  };
+
+
+  /** \brief A cache storing the reference element matrices of the elements of a local finite element cache
+   *
+   * The matrices are computed on first request for the local finite element
+   * returned by the underlying cache, e.g. LagrangeLocalFiniteElementCache or
+   * any other LocalFiniteElementVariantCache. get() is thread safe if the
+   * get() of the underlying cache is, see Impl::PointerKeyedLazyCache.
+   *
+   * \tparam LocalFiniteElementCache Type of the underlying cache of local finite elements
+   */
+  template<class LocalFiniteElementCache>
+  class ReferenceElementMatricesCache
+  {
+  public:
+    //! Type of the local finite elements of the underlying cache
+    using FiniteElementType = typename LocalFiniteElementCache::FiniteElementType;
+
+    //! Type of the stored reference element matrices
+    using MatricesType = ReferenceElementMatrices<FiniteElementType>;
+
+    /** \brief Construct an empty cache
+     *
+     * \note This class stores the reference to the cache passed here, which
+     *       must outlive this object. The underlying cache must return
+     *       references to local finite elements that stay valid.
+     */
+    explicit ReferenceElementMatricesCache (const LocalFiniteElementCache& localFiniteElementCache)
+      : localFiniteElementCache_(localFiniteElementCache)
+    {}
+
+    //! Get the reference element matrices of the local finite element for the given key data
+    template<class... Key>
+    const MatricesType& get (const Key&... key) const
+    {
+      return data_.get(&localFiniteElementCache_.get(key...));
+    }
+
+  private:
+    const LocalFiniteElementCache& localFiniteElementCache_;
+    Impl::PointerKeyedLazyCache<const FiniteElementType*, MatricesType> data_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_REFERENCEELEMENTMATRICES_HH
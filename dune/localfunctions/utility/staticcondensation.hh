@@ -0,0 +1,294 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_STATICCONDENSATION_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_STATICCONDENSATION_HH
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+namespace Dune
+{
+
+  /** \brief Partition of the degrees of freedom of a local finite element into interior and interface ones
+   *
+   * A degree of freedom is interior if its LocalKey is associated to the
+   * element itself, i.e., has codimension 0, and interface otherwise. Interior
+   * degrees of freedom are not shared with any neighbor and can be eliminated
+   * element by element, see StaticCondensation.
+   *
+   * The partition defines a local numbering in which the interface degrees
+   * of freedom come first, in the order of the local finite element, followed
+   * by the interior ones. In this numbering both groups are contiguous index
+   * ranges, [0,interfaceSize()) and [interfaceSize(),size()).
+   *
+   * The partition only depends on the local coefficients, hence it can be
+   * computed once per type of element and be shared by all elements.
+   */
+  class LocalDofPartition
+  {
+  public:
+    LocalDofPartition () = default;
+
+    //! Compute the partition of the degrees of freedom described by the given local coefficients
+    template<class LocalCoefficients>
+    explicit LocalDofPartition (const LocalCoefficients& localCoefficients)
+    {
+      const std::size_t n = localCoefficients.size();
+      interior_.assign(n, false);
+      for (std::size_t i = 0; i < n; ++i)
+        interior_[i] = (localCoefficients.localKey(i).codim() == 0);
+
+      permutation_.clear();
+      permutation_.reserve(n);
+      for (std::size_t i = 0; i < n; ++i)
+        if (not interior_[i])
+          permutation_.push_back(i);
+      interfaceSize_ = permutation_.size();
+      for (std::size_t i = 0; i < n; ++i)
+        if (interior_[i])
+          permutation_.push_back(i);
+
+      inversePermutation_.resize(n);
+      for (std::size_t j = 0; j < n; ++j)
+        inversePermutation_[permutation_[j]] = j;
+    }
+
+    //! Total number of degrees of freedom
+    std::size_t size () const
+    {
+      return permutation_.size();
+    }
+
+    //! Number of interface degrees of freedom
+    std::size_t interfaceSize () const
+    {
+      return interfaceSize_;
+    }
+
+    //! Number of interior degrees of freedom
+    std::size_t interiorSize () const
+    {
+      return size() - interfaceSize_;
+    }
+
+    //! Whether the degree of freedom i of the local finite element is interior
+    bool isInterior (std::size_t i) const
+    {
+      return interior_[i];
+    }
+
+    //! The index in the partitioned numbering of the degree of freedom i of the local finite element
+    std::size_t partitionedIndex (std::size_t i) const
+    {
+      return inversePermutation_[i];
+    }
+
+    //! The indices of the interface and then of the interior degrees of freedom in the local finite element
+    const std::vector<std::size_t>& permutation () const
+    {
+      return permutation_;
+    }
+
+    //! The inverse of permutation()
+    const std::vector<std::size_t>& inversePermutation () const
+    {
+      return inversePermutation_;
+    }
+
+    //! The local index of the interface degree of freedom j, 0 <= j < interfaceSize()
+    std::size_t interfaceIndex (std::size_t j) const
+    {
+      assert(j < interfaceSize_);
+      return permutation_[j];
+    }
+
+    //! The local index of the interior degree of freedom j, 0 <= j < interiorSize()
+    std::size_t interiorIndex (std::size_t j) const
+    {
+      assert(j < interiorSize());
+      return permutation_[interfaceSize_ + j];
+    }
+
+    /** \brief Whether the interior degrees of freedom are the last ones of the local finite element
+     *
+     * Then the permutation is the identity and element matrices can be
+     * condensed without any reordering. This is the case e.g. for elements
+     * enriched by an element bubble as last shape function. The Lagrange
+     * elements number their degrees of freedom lexicographically by the
+     * position of the nodes instead, hence they usually need a reordering,
+     * e.g., the only interior degree of freedom of P3 on a triangle has the
+     * index 5 of 10.
+     */
+    bool isIdentity () const
+    {
+      for (std::size_t j = 0; j < size(); ++j)
+        if (permutation_[j] != j)
+          return false;
+      return true;
+    }
+
+  private:
+    std::vector<bool> interior_;
+    std::vector<std::size_t> permutation_;
+    std::vector<std::size_t> inversePermutation_;
+    std::size_t interfaceSize_ = 0;
+  };
+
+
+  /** \brief Elimination of the interior degrees of freedom from element matrices
+   *
+   * For an element matrix A and right hand side b, split into interface (B)
+   * and interior (I) degrees of freedom by a LocalDofPartition,
+   * \f[ \begin{pmatrix}A_{BB}&A_{BI}\\A_{IB}&A_{II}\end{pmatrix}
+   *     \begin{pmatrix}x_B\\x_I\end{pmatrix} = \begin{pmatrix}b_B\\b_I\end{pmatrix}, \f]
+   * condense() computes the Schur complement \f$S = A_{BB}-A_{BI}A_{II}^{-1}A_{IB}\f$
+   * and the condensed right hand side \f$g = b_B-A_{BI}A_{II}^{-1}b_I\f$.
+   * Only S and g have to be assembled into the global system. After solving
+   * it, recover() computes the interior degrees of freedom
+   * \f$x_I = A_{II}^{-1}(b_I-A_{IB}x_B)\f$ of the element from the interface
+   * degrees of freedom.
+   *
+   * condense() returns a CondensedElement owning S, g and the interior data
+   * of this element, hence one StaticCondensation can be used for all
+   * elements with the same partition, also concurrently, and the interior
+   * degrees of freedom of each element are recovered from its own
+   * CondensedElement.
+   *
+   * The rows and columns of S and the entries of g are the interface degrees
+   * of freedom in the order of LocalDofPartition::interfaceIndex().
+   *
+   * \tparam K Field type of the matrices
+   */
+  template<class K>
+  class StaticCondensation
+  {
+  public:
+    //! Type of the condensed matrix
+    using Matrix = DynamicMatrix<K>;
+
+    //! Type of the condensed right hand side
+    using Vector = DynamicVector<K>;
+
+    //! The condensed system of one element and the data to recover its interior degrees of freedom
+    class CondensedElement
+    {
+      friend class StaticCondensation;
+
+    public:
+      //! The Schur complement S
+      const Matrix& matrix () const
+      {
+        return matrix_;
+      }
+
+      //! The condensed right hand side g
+      const Vector& rhs () const
+      {
+        return rhs_;
+      }
+
+    private:
+      Matrix matrix_;
+      Vector rhs_;
+      // A_II^{-1} A_IB and A_II^{-1} b_I
+      Matrix interiorCoupling_;
+      Vector interiorSolution_;
+    };
+
+    //! Create a static condensation for the given partition
+    explicit StaticCondensation (const LocalDofPartition& partition)
+      : partition_(partition)
+    {}
+
+    /** \brief Eliminate the interior degrees of freedom from an element matrix and right hand side
+     *
+     * \param A Element matrix in the numbering of the local finite element, e.g. a DynamicMatrix
+     * \param b Element right hand side in the numbering of the local finite element
+     * \returns The condensed system of the element, to be passed to recover() for this element
+     *
+     * \throws FMatrixError if the interior block \f$A_{II}\f$ is singular
+     */
+    template<class LocalMatrix, class LocalVector>
+    CondensedElement condense (const LocalMatrix& A, const LocalVector& b) const
+    {
+      const std::size_t nB = partition_.interfaceSize();
+      const std::size_t nI = partition_.interiorSize();
+      CondensedElement element;
+
+      // The interior block and its products with the coupling block and the right hand side
+      element.interiorSolution_ = Vector(nI, 0);
+      element.interiorCoupling_ = Matrix(nI, nB, 0);
+      if (nI > 0)
+      {
+        Matrix inverse(nI, nI, 0);
+        for (std::size_t i = 0; i < nI; ++i)
+          for (std::size_t j = 0; j < nI; ++j)
+            inverse[i][j] = A[partition_.interiorIndex(i)][partition_.interiorIndex(j)];
+        inverse.invert();
+
+        for (std::size_t i = 0; i < nI; ++i)
+          for (std::size_t l = 0; l < nI; ++l)
+          {
+            const std::size_t il = partition_.interiorIndex(l);
+            element.interiorSolution_[i] += inverse[i][l] * b[il];
+            for (std::size_t j = 0; j < nB; ++j)
+              element.interiorCoupling_[i][j] += inverse[i][l] * A[il][partition_.interfaceIndex(j)];
+          }
+      }
+
+      element.matrix_ = Matrix(nB, nB, 0);
+      element.rhs_ = Vector(nB, 0);
+      for (std::size_t i = 0; i < nB; ++i)
+      {
+        const std::size_t ib = partition_.interfaceIndex(i);
+        element.rhs_[i] = b[ib];
+        for (std::size_t j = 0; j < nB; ++j)
+          element.matrix_[i][j] = A[ib][partition_.interfaceIndex(j)];
+        for (std::size_t l = 0; l < nI; ++l)
+        {
+          const K& coupling = A[ib][partition_.interiorIndex(l)];
+          element.rhs_[i] -= coupling * element.interiorSolution_[l];
+          for (std::size_t j = 0; j < nB; ++j)
+            element.matrix_[i][j] -= coupling * element.interiorCoupling_[l][j];
+        }
+      }
+      return element;
+    }
+
+    /** \brief Compute all degrees of freedom of an element from the interface ones
+     *
+     * \param element The result of condense() for this element
+     * \param interfaceValues The interface degrees of freedom in the order of LocalDofPartition::interfaceIndex()
+     * \param[out] x All degrees of freedom in the numbering of the local finite element
+     */
+    template<class InterfaceVector, class LocalVector>
+    void recover (const CondensedElement& element, const InterfaceVector& interfaceValues, LocalVector& x) const
+    {
+      const std::size_t nB = partition_.interfaceSize();
+      const std::size_t nI = partition_.interiorSize();
+      assert(element.interiorCoupling_.N() == nI and element.interiorCoupling_.M() == nB);
+      x.resize(partition_.size());
+      for (std::size_t j = 0; j < nB; ++j)
+        x[partition_.interfaceIndex(j)] = interfaceValues[j];
+      for (std::size_t i = 0; i < nI; ++i)
+      {
+        K y = element.interiorSolution_[i];
+        for (std::size_t j = 0; j < nB; ++j)
+          y -= element.interiorCoupling_[i][j] * interfaceValues[j];
+        x[partition_.interiorIndex(i)] = y;
+      }
+    }
+
+  private:
+    LocalDofPartition partition_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_STATICCONDENSATION_HH
@@ -0,0 +1,561 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_TENSORPRODUCTVECTORCUBE_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_TENSORPRODUCTVECTORCUBE_HH
+
+/** \file
+    \brief Vector-valued tensor-product bases on cubes used by the H(div) and H(curl) elements of arbitrary order
+ */
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/math.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+#include <dune/geometry/referenceelements.hh>
+#include <dune/geometry/type.hh>
+
+#include <dune/localfunctions/common/localbasis.hh>
+#include <dune/localfunctions/common/localkey.hh>
+#include <dune/localfunctions/hierarchical/integratedlegendre.hh>
+
+namespace Dune { namespace Impl
+{
+
+  /** \brief Structure of a vector-valued tensor-product basis on the reference cube
+   *
+   * Each shape function has a single nonzero component i, which is a product of
+   * univariate polynomials \f$\phi_{n_j}(x_j)\f$. In some directions the factors are
+   * taken from the basis \f$\beta_0,\dots,\beta_m\f$ of polynomials of degree m dual
+   * to the end point values and the moments against the shifted Legendre polynomials
+   * of degree at most m-2, in the other directions from the basis \f$\mu_0,\dots,\mu_{m-1}\f$
+   * dual to the Legendre moments, see evaluateLegendreBoundaryDual1d() and
+   * evaluateLegendreMomentDual1d().
+   *
+   * - If \a normal is true, the end point dual factors are used in direction i only.
+   *   This yields the Raviart-Thomas space \f$Q_{m,m-1,\dots}\times\dots\f$ with continuous
+   *   normal components.
+   * - If \a normal is false, the end point dual factors are used in all directions but i.
+   *   This yields the Nédélec space of the first kind \f$Q_{m-1,m,\dots}\times\dots\f$ with
+   *   continuous tangential components.
+   *
+   * Directions where the end point factors \f$\beta_0\f$ or \f$\beta_1\f$ are used determine
+   * the subentity the shape function is attached to. The dual degrees of freedom are the
+   * moments of the i-th component against products of Legendre polynomials on that subentity.
+   * For the normal case the i-th component is replaced by the outer normal component on faces.
+   *
+   * The orientation of the faces (normal case) or edges (tangential case) can be flipped, see
+   * TensorProductVectorCubeLocalBasis. The Legendre polynomials are taken with respect to the
+   * local coordinates, except for the first tangential direction of the faces with outer normal
+   * \f$\pm e_i\f$ where \f$i\f$ plus the position of the face is odd: there the coordinate is
+   * reversed, as in RT1Cube2DLocalInterpolation. Then two elements with positive orientation
+   * sharing an edge in 2d parametrize it in opposite directions, like the edges of a tangential
+   * element whose orientations differ, and the moments of order c change by \f$(-1)^{c+1}\f$
+   * when the orientation is flipped.
+   *
+   * \tparam dim Dimension of the reference cube
+   * \tparam m Degree of the end point dual factors, must be positive
+   * \tparam normal Use the end point dual factors in the direction of the nonzero component
+   */
+  template<unsigned int dim, unsigned int m, bool normal>
+  class TensorProductVectorCubeStructure
+  {
+  public:
+
+    //! \brief Description of a single shape function
+    struct Function
+    {
+      //! The nonzero component
+      unsigned int component;
+      //! Index of the univariate factor in each direction
+      std::array<unsigned int,dim> index;
+      //! Index of the Legendre polynomial of the dual moment in each free direction
+      std::array<unsigned int,dim> moment;
+      //! Sign of the shape function with respect to the reference cube orientation
+      int sign;
+      //! Change of the sign if the orientation of the subentity is flipped
+      int flip;
+    };
+
+    //! \brief Description of a subentity carrying degrees of freedom
+    struct Subentity
+    {
+      //! Codimension of the subentity
+      unsigned int codim;
+      //! Index of the subentity in the reference cube
+      unsigned int index;
+      //! Coordinates of the subentity, the free directions are zero
+      std::array<unsigned int,dim> position;
+      //! Directions tangential to the subentity
+      std::vector<unsigned int> free;
+      //! Range of the shape functions attached to the subentity
+      std::size_t begin, end;
+    };
+
+    //! \brief Codimension of the subentities with an orientation, faces or edges
+    static constexpr unsigned int orientedCodim = normal ? 1 : dim-1;
+
+    //! \brief Number of the subentities with an orientation
+    static constexpr std::size_t numOrientedSubentities = normal ? 2*dim : dim*power(2u, dim-1);
+
+    //! \brief Return whether the end point dual factors are used for component i in direction j
+    static constexpr bool boundaryDirection (unsigned int i, unsigned int j)
+    {
+      return normal ? (i == j) : (i != j);
+    }
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return normal ? dim*(m+1)*power(m, dim-1)
+                    : dim*m*power(m+1, dim-1);
+    }
+
+    //! \brief Polynomial order of the shape functions
+    static constexpr unsigned int order ()
+    {
+      return normal ? m + (dim-1)*(m-1)
+                    : (m-1) + (dim-1)*m;
+    }
+
+    //! \brief Get the shared instance
+    static const TensorProductVectorCubeStructure& instance ()
+    {
+      static const TensorProductVectorCubeStructure structure;
+      return structure;
+    }
+
+    const std::vector<Function>& functions () const
+    {
+      return functions_;
+    }
+
+    const std::vector<Subentity>& subentities () const
+    {
+      return subentities_;
+    }
+
+    const std::vector<LocalKey>& localKeys () const
+    {
+      return localKeys_;
+    }
+
+  private:
+
+    // Enumerate the shape functions grouped by subentities of decreasing codimension
+    TensorProductVectorCubeStructure ()
+    {
+      auto refElement = Dune::referenceElement<double,dim>(GeometryTypes::cube(dim));
+
+      for (int codim=dim; codim>=0; --codim)
+      {
+        for (auto s : Dune::range(refElement.size(codim)))
+        {
+          // Determine the fixed and free coordinates of the subentity
+          Subentity subentity;
+          subentity.codim = codim;
+          subentity.index = s;
+          auto first = refElement.position(*refElement.subEntities(s,codim,dim).begin(), dim);
+          std::array<bool,dim> fixed;
+          fixed.fill(true);
+          for (auto v : refElement.subEntities(s,codim,dim))
+            for (auto j : Dune::range(dim))
+              if (refElement.position(v,dim)[j] != first[j])
+                fixed[j] = false;
+          for (auto j : Dune::range(dim))
+          {
+            subentity.position[j] = fixed[j] ? (first[j] > 0.5) : 0;
+            if (not fixed[j])
+              subentity.free.push_back(j);
+          }
+          subentity.begin = functions_.size();
+
+          for (auto i : Dune::range(dim))
+          {
+            // The univariate factors of the end point family are attached to the fixed directions,
+            // the moment factors cannot be attached to a fixed direction.
+            bool compatible = true;
+            std::array<unsigned int,dim> lower, upper;
+            for (auto j : Dune::range(dim))
+            {
+              if (boundaryDirection(i,j))
+              {
+                lower[j] = fixed[j] ? subentity.position[j] : 2;
+                upper[j] = fixed[j] ? subentity.position[j]+1 : m+1;
+              }
+              else
+              {
+                compatible = compatible and not fixed[j];
+                lower[j] = 0;
+                upper[j] = m;
+              }
+              compatible = compatible and (lower[j] < upper[j]);
+            }
+            if (not compatible)
+              continue;
+
+            // Enumerate the multi-indices, the first direction running fastest
+            Function function;
+            function.component = i;
+            function.index = lower;
+            while (true)
+            {
+              for (auto j : Dune::range(dim))
+                function.moment[j] = not boundaryDirection(i,j) ? function.index[j]
+                                 : fixed[j] ? 0 : function.index[j]-2;
+              function.sign = (normal and function.index[i] == 0) ? -1 : 1;
+              function.flip = -1;
+              if (not subentity.free.empty())
+              {
+                // c is the order of the moment in the parametrized direction
+                const auto c = function.moment[subentity.free[0]];
+                if (normal and codim == 1 and (i + subentity.position[i]) % 2 == 1 and c % 2 == 1)
+                  function.sign *= -1;
+                if (c % 2 == 1)
+                  function.flip = 1;
+              }
+              localKeys_.emplace_back(s, codim, functions_.size() - subentity.begin);
+              functions_.push_back(function);
+
+              unsigned int j = 0;
+              for (; j<dim; ++j)
+              {
+                if (++function.index[j] < upper[j])
+                  break;
+                function.index[j] = lower[j];
+              }
+              if (j == dim)
+                break;
+            }
+          }
+
+          subentity.end = functions_.size();
+          if (subentity.end > subentity.begin)
+            subentities_.push_back(subentity);
+        }
+      }
+    }
+
+    std::vector<Function> functions_;
+    std::vector<Subentity> subentities_;
+    std::vector<LocalKey> localKeys_;
+  };
+
+
+
+  /** \brief Vector-valued tensor-product shape functions on the reference cube
+   *
+   * The univariate factors are evaluated once per direction and combined to the
+   * shape functions, see TensorProductVectorCubeStructure for the construction.
+   *
+   * \tparam D Type to represent the field in the domain
+   * \tparam R Type to represent the field in the range
+   * \tparam dim Dimension of the reference cube
+   * \tparam m Degree of the end point dual factors
+   * \tparam normal Construct an H(div) (true) or H(curl) (false) conforming basis
+   */
+  template<class D, class R, unsigned int dim, unsigned int m, bool normal>
+  class TensorProductVectorCubeLocalBasis
+  {
+    using Structure = TensorProductVectorCubeStructure<dim,m,normal>;
+
+    // Tables of the univariate factors of both families and their derivatives in all directions
+    template<unsigned int rows>
+    struct Tables
+    {
+      std::array<std::array<std::array<R,m+1>,rows>,dim> boundary;
+      std::array<std::array<std::array<R,m+1>,rows>,dim> moment;
+
+      const R& operator() (unsigned int i, unsigned int j, unsigned int r, unsigned int n) const
+      {
+        return Structure::boundaryDirection(i,j) ? boundary[j][r][n] : moment[j][r][n];
+      }
+    };
+
+    template<unsigned int rows>
+    static Tables<rows> evaluate1d (const FieldVector<D,dim>& x, const std::array<unsigned int,dim>& maxDerivative)
+    {
+      Tables<rows> tables{};
+      for (auto j : Dune::range(dim))
+      {
+        evaluateLegendreBoundaryDual1d(m, R(x[j]), maxDerivative[j], tables.boundary[j]);
+        evaluateLegendreMomentDual1d(m-1, R(x[j]), maxDerivative[j], tables.moment[j]);
+      }
+      return tables;
+    }
+
+  public:
+    using Traits = LocalBasisTraits<D,dim,FieldVector<D,dim>,R,dim,FieldVector<R,dim>,FieldMatrix<R,dim,dim> >;
+
+    //! \brief Default constructor using the reference orientation of all subentities
+    TensorProductVectorCubeLocalBasis ()
+    {
+      const auto& functions = Structure::instance().functions();
+      for (auto n : Dune::range(size()))
+        sign_[n] = functions[n].sign;
+    }
+
+    /** \brief Construct the basis with flipped orientations of some subentities
+     *
+     * The orientation of the faces (normal case) or edges (tangential case) with
+     * s[index] set is flipped. This reverses the normal or tangent and the
+     * parametrization of the subentity, hence the shape functions attached to it
+     * dual to moments of even order change their sign.
+     */
+    explicit TensorProductVectorCubeLocalBasis (const std::bitset<Structure::numOrientedSubentities>& s)
+      : TensorProductVectorCubeLocalBasis()
+    {
+      const auto& functions = Structure::instance().functions();
+      for (const auto& subentity : Structure::instance().subentities())
+        if (subentity.codim == Structure::orientedCodim and s[subentity.index])
+          for (auto i : Dune::range(subentity.begin, subentity.end))
+            sign_[i] *= functions[i].flip;
+    }
+
+    //! \brief Number of shape functions
+    static constexpr unsigned int size ()
+    {
+      return Structure::size();
+    }
+
+    //! \brief Evaluate all shape functions
+    void evaluateFunction (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+      std::array<unsigned int,dim> maxDerivative;
+      maxDerivative.fill(0);
+      const auto tables = evaluate1d<1>(x, maxDerivative);
+      const auto& functions = Structure::instance().functions();
+      for (auto n : Dune::range(size()))
+      {
+        const auto& f = functions[n];
+        R y = sign_[n];
+        for (auto j : Dune::range(dim))
+          y *= tables(f.component, j, 0, f.index[j]);
+        out[n] = 0;
+        out[n][f.component] = y;
+      }
+    }
+
+    //! \brief Evaluate Jacobian of all shape functions
+    void evaluateJacobian (const typename Traits::DomainType& x,
+                           std::vector<typename Traits::JacobianType>& out) const
+    {
+      out.resize(size());
+      std::array<unsigned int,dim> maxDerivative;
+      maxDerivative.fill(1);
+      const auto tables = evaluate1d<2>(x, maxDerivative);
+      const auto& functions = Structure::instance().functions();
+      for (auto n : Dune::range(size()))
+      {
+        const auto& f = functions[n];
+        out[n] = 0;
+        for (auto l : Dune::range(dim))
+        {
+          R y = sign_[n];
+          for (auto j : Dune::range(dim))
+            y *= tables(f.component, j, j==l, f.index[j]);
+          out[n][f.component][l] = y;
+        }
+      }
+    }
+
+    /** \brief Evaluate partial derivatives of any order of all shape functions
+     *
+     * \param order Order of the partial derivatives, in the classic multi-index notation
+     * \param in Position where to evaluate the derivatives
+     * \param[out] out The desired partial derivatives
+     */
+    void partial (const std::array<unsigned int,dim>& order,
+                  const typename Traits::DomainType& in,
+                  std::vector<typename Traits::RangeType>& out) const
+    {
+      out.resize(size());
+
+      // Derivatives of order >m in any direction vanish
+      if (std::any_of(order.begin(), order.end(), [](auto o) { return o > m; }))
+      {
+        std::fill(out.begin(), out.end(), 0);
+        return;
+      }
+
+      const auto tables = evaluate1d<m+1>(in, order);
+      const auto& functions = Structure::instance().functions();
+      for (auto n : Dune::range(size()))
+      {
+        const auto& f = functions[n];
+        R y = sign_[n];
+        for (auto j : Dune::range(dim))
+          y *= tables(f.component, j, order[j], f.index[j]);
+        out[n] = 0;
+        out[n][f.component] = y;
+      }
+    }
+
+    //! \brief Polynomial order of the shape functions
+    static constexpr unsigned int order ()
+    {
+      return Structure::order();
+    }
+
+    //! \brief Sign of the i-th shape function
+    R sign (std::size_t i) const
+    {
+      return sign_[i];
+    }
+
+  private:
+    std::array<R,size()> sign_;
+  };
+
+
+
+  /** \brief Associations of the degrees of freedom of a vector-valued tensor-product basis to subentities
+   *
+   * \tparam dim Dimension of the reference cube
+   * \tparam m Degree of the end point dual factors
+   * \tparam normal Construct an H(div) (true) or H(curl) (false) conforming basis
+   */
+  template<unsigned int dim, unsigned int m, bool normal>
+  class TensorProductVectorCubeLocalCoefficients
+  {
+    using Structure = TensorProductVectorCubeStructure<dim,m,normal>;
+
+  public:
+    //! \brief Number of coefficients
+    static constexpr std::size_t size ()
+    {
+      return Structure::size();
+    }
+
+    //! \brief Get i-th local key
+    const LocalKey& localKey (std::size_t i) const
+    {
+      return Structure::instance().localKeys()[i];
+    }
+  };
+
+
+
+  /** \brief Interpolation into a vector-valued tensor-product basis by moments on subentities
+   *
+   * For every subentity the function is evaluated once at the tensor-product Gauss points
+   * and all moments attached to the subentity are accumulated.
+   *
+   * \tparam LB The local basis
+   */
+  template<class LB>
+  class TensorProductVectorCubeLocalInterpolation;
+
+  template<class D, class R, unsigned int dim, unsigned int m, bool normal>
+  class TensorProductVectorCubeLocalInterpolation<TensorProductVectorCubeLocalBasis<D,R,dim,m,normal> >
+  {
+    using Structure = TensorProductVectorCubeStructure<dim,m,normal>;
+    using LocalBasis = TensorProductVectorCubeLocalBasis<D,R,dim,m,normal>;
+
+  public:
+
+    //! \brief Constructor using the reference orientation of all subentities
+    TensorProductVectorCubeLocalInterpolation ()
+      : TensorProductVectorCubeLocalInterpolation(LocalBasis())
+    {}
+
+    //! \brief Constructor with flipped orientations of some subentities, see TensorProductVectorCubeLocalBasis
+    explicit TensorProductVectorCubeLocalInterpolation (const std::bitset<Structure::numOrientedSubentities>& s)
+      : TensorProductVectorCubeLocalInterpolation(LocalBasis(s))
+    {}
+
+    //! \brief Constructor using the signs of a given basis
+    explicit TensorProductVectorCubeLocalInterpolation (const LocalBasis& basis)
+    {
+      for (auto i : Dune::range(LocalBasis::size()))
+        sign_[i] = basis.sign(i);
+
+      // The moments of all functions in the space are integrated exactly
+      const auto& rule = QuadratureRules<D,1>::rule(GeometryTypes::cube(1), 2*m-1);
+      points_.resize(rule.size());
+      weights_.resize(rule.size());
+      legendre_.resize(rule.size());
+      for (auto q : Dune::range(rule.size()))
+      {
+        points_[q] = rule[q].position()[0];
+        weights_[q] = rule[q].weight();
+        std::array<std::array<R,m+1>,1> table;
+        evaluateLegendre1d(m, R(points_[q]), 0, table);
+        legendre_[q] = table[0];
+      }
+    }
+
+    /** \brief Compute the moments of a given function
+     *
+     * \param f The function to interpolate, must return a vector of size dim
+     * \param[out] out The interpolation coefficients
+     */
+    template<class F, class C>
+    void interpolate (const F& f, std::vector<C>& out) const
+    {
+      const auto& functions = Structure::instance().functions();
+      out.resize(LocalBasis::size());
+      std::fill(out.begin(), out.end(), 0);
+
+      const auto nq = points_.size();
+      FieldVector<D,dim> x;
+      for (const auto& subentity : Structure::instance().subentities())
+      {
+        const auto nFree = subentity.free.size();
+        for (auto j : Dune::range(dim))
+          x[j] = subentity.position[j];
+
+        // Iterate over the tensor-product quadrature points of the subentity
+        std::vector<std::size_t> q(nFree, 0);
+        for (std::size_t point=0; point<power(nq, nFree); ++point)
+        {
+          D weight = 1;
+          for (auto l : Dune::range(nFree))
+          {
+            x[subentity.free[l]] = points_[q[l]];
+            weight *= weights_[q[l]];
+          }
+
+          const auto y = f(x);
+          for (auto i : Dune::range(subentity.begin, subentity.end))
+          {
+            const auto& function = functions[i];
+            auto value = y[function.component]*weight;
+            for (auto l : Dune::range(nFree))
+              value *= legendre_[q[l]][function.moment[subentity.free[l]]];
+            out[i] += value;
+          }
+
+          for (auto l : Dune::range(nFree))
+          {
+            if (++q[l] < nq)
+              break;
+            q[l] = 0;
+          }
+        }
+      }
+
+      for (auto i : Dune::range(out.size()))
+        out[i] *= sign_[i];
+    }
+
+  private:
+    std::array<R,LocalBasis::size()> sign_;
+    std::vector<D> points_;
+    std::vector<D> weights_;
+    std::vector<std::array<R,m+1> > legendre_;
+  };
+
+} }    // namespace Dune::Impl
+
+#endif   // DUNE_LOCALFUNCTIONS_UTILITY_TENSORPRODUCTVECTORCUBE_HH
@@ -0,0 +1,126 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+#ifndef DUNE_LOCALFUNCTIONS_UTILITY_TRANSFERMATRIX_HH
+#define DUNE_LOCALFUNCTIONS_UTILITY_TRANSFERMATRIX_HH
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/dynmatrix.hh>
+
+#include <dune/localfunctions/utility/lazycache.hh>
+
+namespace Dune
+{
+
+  /** \brief Compute the matrix transferring coefficients between two local finite elements
+   *
+   * The entry (i,j) of the returned matrix is the coefficient i of the
+   * interpolation of the shape function j of the first element by the
+   * second element. Hence the matrix maps the coefficients of a function
+   * of the first element to the coefficients of its interpolation by the
+   * second element, e.g. it is the prolongation from order k to order k'>k
+   * of two Lagrange elements. The matrix of the opposite direction is
+   * obtained by exchanging the arguments.
+   *
+   * The shape functions are evaluated only once at each point requested by
+   * the interpolation, provided that the interpolation requests the same
+   * points in the same order for all functions.
+   *
+   * \param from The local finite element of the given coefficients
+   * \param to The local finite element of the interpolated coefficients
+   */
+  template<class FromFiniteElement, class ToFiniteElement>
+  auto transferMatrix (const FromFiniteElement& from, const ToFiniteElement& to)
+  {
+    using FromBasisTraits = typename FromFiniteElement::Traits::LocalBasisType::Traits;
+    using Field = typename ToFiniteElement::Traits::LocalBasisType::Traits::RangeFieldType;
+    using Domain = typename FromBasisTraits::DomainType;
+    using Range = typename FromBasisTraits::RangeType;
+
+    DynamicMatrix<Field> matrix(to.size(), from.size(), 0);
+    std::vector<std::pair<Domain, std::vector<Range> > > evaluations;
+    std::vector<Field> coefficients;
+    for (std::size_t j = 0; j < from.size(); ++j)
+    {
+      std::size_t count = 0;
+      auto shapeFunction = [&](const Domain& x) -> Range {
+        if (count == evaluations.size())
+          evaluations.emplace_back(x, std::vector<Range>());
+        auto& evaluation = evaluations[count++];
+        if (evaluation.second.empty() || evaluation.first != x)
+        {
+          evaluation.first = x;
+          from.localBasis().evaluateFunction(x, evaluation.second);
+        }
+        return evaluation.second[j];
+      };
+      to.localInterpolation().interpolate(shapeFunction, coefficients);
+      for (std::size_t i = 0; i < to.size(); ++i)
+        matrix[i][j] = coefficients[i];
+    }
+    return matrix;
+  }
+
+
+  /** \brief A cache storing the transfer matrices between the elements of two local finite element caches
+   *
+   * For given key data the matrix transferring the coefficients of the
+   * element of the first cache to the element of the second cache is computed
+   * on first request by transferMatrix(), e.g. the prolongation between
+   * two LagrangeLocalFiniteElementCache objects of different orders for a
+   * GeometryType. get() is thread safe if the get() of both caches is, see
+   * Impl::PointerKeyedLazyCache.
+   *
+   * \tparam FromCache Type of the cache of the elements of the given coefficients
+   * \tparam ToCache Type of the cache of the elements of the interpolated coefficients
+   */
+  template<class FromCache, class ToCache>
+  class TransferMatrixCache
+  {
+    using FromFiniteElement = typename FromCache::FiniteElementType;
+    using ToFiniteElement = typename ToCache::FiniteElementType;
+    using FiniteElementPair = std::pair<const FromFiniteElement*, const ToFiniteElement*>;
+
+    struct Factory
+    {
+      auto operator() (const FiniteElementPair& pair) const
+      {
+        return transferMatrix(*pair.first, *pair.second);
+      }
+    };
+
+  public:
+    //! Type of the stored transfer matrices
+    using MatrixType = decltype(transferMatrix(std::declval<FromFiniteElement>(), std::declval<ToFiniteElement>()));
+
+    /** \brief Construct an empty cache
+     *
+     * \note This class stores the references to the caches passed here, which
+     *       must outlive this object. The caches must return references to
+     *       local finite elements that stay valid.
+     */
+    TransferMatrixCache (const FromCache& fromCache, const ToCache& toCache)
+      : fromCache_(fromCache)
+      , toCache_(toCache)
+    {}
+
+    //! Get the transfer matrix for the given key data
+    template<class... Key>
+    const MatrixType& get (const Key&... key) const
+    {
+      return data_.get(FiniteElementPair(&fromCache_.get(key...), &toCache_.get(key...)));
+    }
+
+  private:
+    const FromCache& fromCache_;
+    const ToCache& toCache_;
+    Impl::PointerKeyedLazyCache<FiniteElementPair, MatrixType, Factory> data_;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_LOCALFUNCTIONS_UTILITY_TRANSFERMATRIX_HH